@@ -0,0 +1,613 @@
+/**
+ * @file Benchmarks_main.c
+ * @brief Main source code for the Benchmarks program.
+ *
+ * This program measures the drivers of the Timers_and_Interrupts project on the target, with the same source files
+ * (they are linked from ../Timers_and_Interrupts, so the results follow the changes made to the drivers).
+ * For each clock profile (48, 24, 12, and 3 MHz), it runs the following scenarios:
+ *
+ *  - SysTick handler cost and entry latency while the CPU is busy (ISR_Profiler, BENCHMARKS_SYSTICK_TICKS interrupts)
+ *  - PORT4 and PORT6 edge-to-handler latency and handler cost, with edges generated by a GPIO loopback:
+ *      - P5.0 (output) must be wired to P4.0 (BUMP_0), which interrupts on a falling edge
+ *      - P5.1 (output) must be wired to P6.0 (PMOD BTN0), which interrupts on a rising edge
+ *    The time of each edge is marked with ISR_Profiler_Mark_Request right before the output pin is written.
+ *  - printf versus EUSCI_A0_UART_Write: throughput in bytes per second until the last character has left EUSCI_A0
+ *    (EUSCI_A0_UART_TX_MODE_RING_BLOCK), cost of EUSCIA0_IRQHandler while it sends them, and number of cycles
+ *    of one call that fits in the transmit ring buffer (EUSCI_A0_UART_TX_MODE_RING_DROP)
+ *  - Critical section overhead: Critical_Section_Enter/Exit (PRIMASK), Critical_Section_Enter_Priority/Exit_Priority
+ *    (BASEPRI), and StartCritical/EndCritical (CortexM.c)
+ *  - WFI wake latency: number of cycles from the SysTick request to the entry of SysTick_Handler when the CPU sleeps (LPM0),
+ *    and to the first instruction after WFI
+ *
+ * The results are printed via UART (115200 baud) as CSV lines, one line per measurement:
+ *
+ *      bench,<revision>,<mclk_mhz>,<name>,<samples>,<min>,<mean>,<max>,<units>
+ *
+ * The first line is the header "bench,revision,mclk_mhz,name,samples,min,mean,max,units", and the run ends with
+ * the line "bench,<revision>,done". The other lines start with '#' (comments and the payload of the UART scenario),
+ * so they can be skipped by the parser. The revision is BENCHMARKS_REVISION, which defaults to the build date and time
+ * and can be set with --define=BENCHMARKS_REVISION=\"<name>\" to compare firmware revisions.
+ * The measurements that cannot be made (e.g. the loopback is not wired) are printed with 0 samples.
+ *
+ * @note The project is built with ISR_PROFILER_ENABLE=1, since the interrupt handlers are measured with the ISR_Profiler driver.
+ *
+ * @note The cycle counts include the flash wait states of each profile (2 at 48 MHz, 1 at 24 MHz), except for the handlers
+ *       that run from SRAM in the Release configurations (see RAM_Function.h and the isr_in_sram line).
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "msp.h"
+#include "../inc/Clock.h"
+#include "../inc/CortexM.h"
+#include "../inc/CortexM_Inline.h"
+#include "../inc/Critical_Section.h"
+#include "../inc/Delay.h"
+#include "../inc/GPIO.h"
+#include "../inc/SysTick_Interrupt.h"
+#include "../inc/Time.h"
+#include "../inc/Bumper_Sensors.h"
+#include "../inc/PMOD_BTN_Interrupt.h"
+#include "../inc/Debounce.h"
+#include "../inc/EUSCI_A0_UART.h"
+#include "../inc/Event_Queue.h"
+#include "../inc/ISR_Profiler.h"
+#include "../inc/RAM_Function.h"
+
+#if !ISR_PROFILER_ENABLE
+#error "The Benchmarks project must be built with ISR_PROFILER_ENABLE=1"
+#endif
+
+#ifndef BENCHMARKS_REVISION
+#define BENCHMARKS_REVISION __DATE__ " " __TIME__
+#endif
+
+// Number of SysTick interrupts measured in each SysTick scenario (1 ms each)
+#define BENCHMARKS_SYSTICK_TICKS 1000
+
+// Number of edges generated on each loopback pin
+#define BENCHMARKS_EDGES 1000
+
+// Time between two loopback edges, which is longer than the handler and leaves time to dispatch the event
+#define BENCHMARKS_EDGE_INTERVAL_US 100
+
+// Number of measurements of each critical section
+#define BENCHMARKS_CRITICAL_SECTIONS 1000
+
+// Number of lines and repetitions of the UART throughput scenario
+#define BENCHMARKS_UART_LINES 16
+#define BENCHMARKS_UART_RUNS 4
+
+// Number of calls measured in the UART call scenario
+#define BENCHMARKS_UART_CALLS 16
+
+// Priority used for the BASEPRI critical section (masks EUSCI_A0 and lower)
+#define BENCHMARKS_BASEPRI_PRIORITY EUSCI_A0_UART_INT_PRIORITY
+
+/**
+ * @brief Line sent by the UART scenarios. It starts with '#' so the parser skips it.
+ *
+ * 63 characters and LF, so each line is 65 bytes on the wire (EUSCI_A0_UART_Write sends CR before LF).
+ */
+static const char Benchmarks_UART_Line[] = "# 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxy\n";
+
+#define BENCHMARKS_UART_LINE_LENGTH (sizeof(Benchmarks_UART_Line) - 1)
+#define BENCHMARKS_UART_LINE_BYTES (BENCHMARKS_UART_LINE_LENGTH + 1)
+
+/**
+ * @brief Minimum, maximum, and total of a set of measurements.
+ */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} Benchmarks_Result;
+
+// Clock profiles that are measured, in this order
+static const Clock_Profile Benchmarks_Profiles[] =
+{
+    CLOCK_PROFILE_48MHZ,
+    CLOCK_PROFILE_24MHZ,
+    CLOCK_PROFILE_12MHZ,
+    CLOCK_PROFILE_3MHZ
+};
+
+// Number of events dispatched from the loopback edges
+static volatile uint32_t Benchmarks_Bumper_Events = 0;
+static volatile uint32_t Benchmarks_PMOD_BTN_Events = 0;
+
+// Number of cycles taken by two consecutive reads of CYCCNT, subtracted from the critical section measurements
+static uint32_t Benchmarks_CYCCNT_Overhead = 0;
+
+/**
+ * @brief SysTick interrupt handler function.
+ *
+ * Same handler as in Timers_and_Interrupts_main.c, so the SysTick scenario measures the handler of the application.
+ *
+ * @return None
+ */
+RAM_FUNCTION void SysTick_Handler(void)
+{
+    ISR_PROFILER_ENTER_SYSTICK();
+
+    SysTick_Interrupt_Add_Ticks(1);
+
+    ISR_PROFILER_EXIT(ISR_PROFILER_SYSTICK);
+}
+
+/**
+ * @brief Counts the events of the bumper sensors, which are generated by the P5.0 to P4.0 loopback.
+ *
+ * @return None
+ */
+static void Benchmarks_Bumper_Task(uint8_t bumper_sensor_state)
+{
+    Benchmarks_Bumper_Events++;
+}
+
+/**
+ * @brief Counts the events of the PMOD BTN module, which are generated by the P5.1 to P6.0 loopback.
+ *
+ * @return None
+ */
+static void Benchmarks_PMOD_BTN_Task(uint8_t pmod_btn_state)
+{
+    Benchmarks_PMOD_BTN_Events++;
+}
+
+static void Benchmarks_Result_Reset(Benchmarks_Result *result)
+{
+    result->count = 0;
+    result->min = 0xFFFFFFFF;
+    result->max = 0;
+    result->total = 0;
+}
+
+static void Benchmarks_Result_Add(Benchmarks_Result *result, uint32_t value)
+{
+    result->count++;
+    result->total += value;
+    if (value < result->min) result->min = value;
+    if (value > result->max) result->max = value;
+}
+
+/**
+ * @brief Adds a measurement made between two reads of CYCCNT, without the cycles of the reads.
+ *
+ * @return None
+ */
+static void Benchmarks_Result_Add_Cycles(Benchmarks_Result *result, uint32_t cycles)
+{
+    cycles = (cycles > Benchmarks_CYCCNT_Overhead) ? (cycles - Benchmarks_CYCCNT_Overhead) : 0;
+    Benchmarks_Result_Add(result, cycles);
+}
+
+/**
+ * @brief Prints one measurement as a CSV line.
+ *
+ * The values are printed as 0 when there is no sample.
+ *
+ * @return None
+ */
+static void Benchmarks_Print(const char *name, uint32_t count, uint32_t min, uint32_t mean, uint32_t max, const char *units)
+{
+    if (count == 0)
+    {
+        min = 0;
+        mean = 0;
+        max = 0;
+    }
+
+    printf("bench,%s,%lu,%s,%lu,%lu,%lu,%lu,%s\n", BENCHMARKS_REVISION, (unsigned long)(Clock_GetFreq() / 1000000), name,
+           (unsigned long)count, (unsigned long)min, (unsigned long)mean, (unsigned long)max, units);
+}
+
+static void Benchmarks_Print_Result(const char *name, const Benchmarks_Result *result, const char *units)
+{
+    uint32_t mean = (result->count) ? (uint32_t)(result->total / result->count) : 0;
+
+    Benchmarks_Print(name, result->count, result->min, mean, result->max, units);
+}
+
+static void Benchmarks_Print_Cycles(const char *name, const ISR_Profiler_Stats *stats)
+{
+    uint32_t mean = (stats->count) ? (uint32_t)(stats->total_cycles / stats->count) : 0;
+
+    Benchmarks_Print(name, stats->count, stats->min_cycles, mean, stats->max_cycles, "cycles");
+}
+
+static void Benchmarks_Print_Latency(const char *name, const ISR_Profiler_Stats *stats)
+{
+    uint32_t mean = (stats->latency_count) ? (uint32_t)(stats->total_latency / stats->latency_count) : 0;
+
+    Benchmarks_Print(name, stats->latency_count, stats->min_latency, mean, stats->max_latency, "cycles");
+}
+
+/**
+ * @brief Waits until the results printed so far have been sent, so that EUSCIA0_IRQHandler does not run during a measurement.
+ *
+ * @return None
+ */
+static void Benchmarks_Wait_TX_Idle(void)
+{
+    EUSCI_A0_UART_TX_Flush();
+    while (EUSCI_A0_UART_TX_Busy());
+}
+
+/**
+ * @brief Measures the number of cycles of two consecutive reads of CYCCNT.
+ *
+ * @return None
+ */
+static void Benchmarks_Calibrate(void)
+{
+    uint32_t min = 0xFFFFFFFF;
+
+    for (uint32_t i = 0; i < BENCHMARKS_CRITICAL_SECTIONS; i++)
+    {
+        uint32_t start = DWT->CYCCNT;
+        uint32_t cycles = DWT->CYCCNT - start;
+
+        if (cycles < min) min = cycles;
+    }
+
+    Benchmarks_CYCCNT_Overhead = min;
+}
+
+/**
+ * @brief Measures SysTick_Handler and its entry latency while the CPU busy-waits.
+ *
+ * @return None
+ */
+static void Benchmarks_SysTick(void)
+{
+    ISR_Profiler_Stats stats;
+    uint32_t start_ticks;
+
+    ISR_Profiler_Reset();
+
+    start_ticks = SysTick_Interrupt_Get_Ticks();
+    while ((SysTick_Interrupt_Get_Ticks() - start_ticks) < BENCHMARKS_SYSTICK_TICKS);
+
+    ISR_Profiler_Get_Stats(ISR_PROFILER_SYSTICK, &stats);
+    Benchmarks_Print_Cycles("systick_handler", &stats);
+    Benchmarks_Print_Latency("systick_entry_latency_busy", &stats);
+}
+
+/**
+ * @brief Generates BENCHMARKS_EDGES edges on one loopback pin and prints the latency and the cost of the port handler.
+ *
+ * @param port   Output port wired to the input pin (P5)
+ * @param pin    Output pin
+ * @param active Level that generates the interrupt (0 for a falling edge, 1 for a rising edge)
+ * @param irq    Port handler measured by ISR_Profiler
+ *
+ * @return None
+ */
+static void Benchmarks_Edges(DIO_PORT_Odd_Interruptable_Type *port, uint8_t pin, uint8_t active, ISR_Profiler_IRQ irq,
+                             const char *latency_name, const char *handler_name)
+{
+    ISR_Profiler_Stats stats;
+
+    ISR_Profiler_Reset();
+
+    for (uint32_t i = 0; i < BENCHMARKS_EDGES; i++)
+    {
+        // Mark the time of the request, then generate the edge
+        ISR_Profiler_Mark_Request(irq);
+        GPIO_Pin_Write(port, pin, active);
+        Delay_Us(BENCHMARKS_EDGE_INTERVAL_US);
+
+        // Return to the idle level, which does not generate an interrupt
+        GPIO_Pin_Write(port, pin, !active);
+        Delay_Us(BENCHMARKS_EDGE_INTERVAL_US);
+
+        // Call the event tasks, so that the Event_Queue does not overflow
+        Event_Queue_Dispatch();
+    }
+
+    ISR_Profiler_Get_Stats(irq, &stats);
+    Benchmarks_Print_Latency(latency_name, &stats);
+    Benchmarks_Print_Cycles(handler_name, &stats);
+}
+
+/**
+ * @brief Measures the PORT4 and PORT6 handlers with the GPIO loopback.
+ *
+ * @return None
+ */
+static void Benchmarks_Loopback(void)
+{
+    uint32_t bumper_events = Benchmarks_Bumper_Events;
+    uint32_t pmod_btn_events = Benchmarks_PMOD_BTN_Events;
+
+    Benchmarks_Edges(P5, 0, 0, ISR_PROFILER_PORT4, "port4_edge_latency", "port4_handler");
+    Benchmarks_Edges(P5, 1, 1, ISR_PROFILER_PORT6, "port6_edge_latency", "port6_handler");
+
+    if (Benchmarks_Bumper_Events == bumper_events)
+    {
+        printf("# No event from P4.0, check that P5.0 is wired to P4.0\n");
+    }
+
+    if (Benchmarks_PMOD_BTN_Events == pmod_btn_events)
+    {
+        printf("# No event from P6.0, check that P5.1 is wired to P6.0\n");
+    }
+}
+
+/**
+ * @brief Sends BENCHMARKS_UART_LINES lines with printf or EUSCI_A0_UART_Write.
+ *
+ * @return None
+ */
+static void Benchmarks_UART_Send(uint8_t use_printf)
+{
+    for (uint32_t line = 0; line < BENCHMARKS_UART_LINES; line++)
+    {
+        if (use_printf)
+        {
+            printf("%s", Benchmarks_UART_Line);
+        }
+        else
+        {
+            EUSCI_A0_UART_Write(0, Benchmarks_UART_Line, BENCHMARKS_UART_LINE_LENGTH);
+        }
+    }
+}
+
+/**
+ * @brief Measures the throughput of printf or EUSCI_A0_UART_Write, until the last character has been sent.
+ *
+ * @return None
+ */
+static void Benchmarks_UART_Throughput(uint8_t use_printf, const char *name)
+{
+    Benchmarks_Result result;
+    uint32_t bytes = BENCHMARKS_UART_LINES * BENCHMARKS_UART_LINE_BYTES;
+
+    Benchmarks_Result_Reset(&result);
+
+    for (uint32_t run = 0; run < BENCHMARKS_UART_RUNS; run++)
+    {
+        Benchmarks_Wait_TX_Idle();
+
+        uint64_t start = Time_NowCycles();
+
+        Benchmarks_UART_Send(use_printf);
+        Benchmarks_Wait_TX_Idle();
+
+        uint64_t cycles = Time_NowCycles() - start;
+
+        Benchmarks_Result_Add(&result, (uint32_t)(((uint64_t)bytes * Clock_GetFreq()) / cycles));
+    }
+
+    Benchmarks_Wait_TX_Idle();
+    Benchmarks_Print_Result(name, &result, "bytes_per_s");
+}
+
+/**
+ * @brief Measures the number of cycles of one call of printf or EUSCI_A0_UART_Write that fits in the transmit ring buffer.
+ *
+ * @return None
+ */
+static void Benchmarks_UART_Call(uint8_t use_printf, const char *name)
+{
+    Benchmarks_Result result;
+
+    Benchmarks_Result_Reset(&result);
+
+    for (uint32_t call = 0; call < BENCHMARKS_UART_CALLS; call++)
+    {
+        Benchmarks_Wait_TX_Idle();
+
+        uint32_t start = DWT->CYCCNT;
+
+        if (use_printf)
+        {
+            printf("%s", Benchmarks_UART_Line);
+        }
+        else
+        {
+            EUSCI_A0_UART_Write(0, Benchmarks_UART_Line, BENCHMARKS_UART_LINE_LENGTH);
+        }
+
+        Benchmarks_Result_Add(&result, DWT->CYCCNT - start);
+    }
+
+    Benchmarks_Wait_TX_Idle();
+    Benchmarks_Print_Result(name, &result, "cycles");
+}
+
+/**
+ * @brief Compares printf with EUSCI_A0_UART_Write.
+ *
+ * @return None
+ */
+static void Benchmarks_UART(void)
+{
+    EUSCI_A0_UART_TX_Mode mode = EUSCI_A0_UART_Get_TX_Mode();
+    ISR_Profiler_Stats stats;
+
+    // Nothing is dropped while the throughput is measured
+    // The characters are sent by EUSCIA0_IRQHandler, which is measured at the same time
+    EUSCI_A0_UART_Set_TX_Mode(EUSCI_A0_UART_TX_MODE_RING_BLOCK);
+    Benchmarks_Wait_TX_Idle();
+    ISR_Profiler_Reset();
+    Benchmarks_UART_Throughput(1, "uart_printf_throughput");
+    Benchmarks_UART_Throughput(0, "uart_write_throughput");
+    ISR_Profiler_Get_Stats(ISR_PROFILER_EUSCIA0, &stats);
+    Benchmarks_Print_Cycles("uart_tx_handler", &stats);
+
+    // One line fits in the ring buffer, so the call does not wait for the characters to be sent
+    EUSCI_A0_UART_Set_TX_Mode(EUSCI_A0_UART_TX_MODE_RING_DROP);
+    Benchmarks_UART_Call(1, "uart_printf_call");
+    Benchmarks_UART_Call(0, "uart_write_call");
+
+    EUSCI_A0_UART_Set_TX_Mode(mode);
+}
+
+/**
+ * @brief Measures the critical sections. The cycles of the two reads of CYCCNT are subtracted.
+ *
+ * @return None
+ */
+static void Benchmarks_Critical_Sections(void)
+{
+    Benchmarks_Result primask;
+    Benchmarks_Result basepri;
+    Benchmarks_Result cortexm;
+
+    Benchmarks_Result_Reset(&primask);
+    Benchmarks_Result_Reset(&basepri);
+    Benchmarks_Result_Reset(&cortexm);
+
+    for (uint32_t i = 0; i < BENCHMARKS_CRITICAL_SECTIONS; i++)
+    {
+        uint32_t start = DWT->CYCCNT;
+        uint32_t sr = Critical_Section_Enter();
+        Critical_Section_Exit(sr);
+        uint32_t cycles = DWT->CYCCNT - start;
+
+        Benchmarks_Result_Add_Cycles(&primask, cycles);
+
+        start = DWT->CYCCNT;
+        uint32_t state = Critical_Section_Enter_Priority(BENCHMARKS_BASEPRI_PRIORITY);
+        Critical_Section_Exit_Priority(state);
+        cycles = DWT->CYCCNT - start;
+
+        Benchmarks_Result_Add_Cycles(&basepri, cycles);
+
+        start = DWT->CYCCNT;
+        long critical_sr = StartCritical();
+        EndCritical(critical_sr);
+        cycles = DWT->CYCCNT - start;
+
+        Benchmarks_Result_Add_Cycles(&cortexm, cycles);
+    }
+
+    Benchmarks_Print_Result("critical_section_primask", &primask, "cycles");
+    Benchmarks_Print_Result("critical_section_basepri", &basepri, "cycles");
+    Benchmarks_Print_Result("critical_section_cortexm", &cortexm, "cycles");
+}
+
+/**
+ * @brief Measures the wake latency of WFI with the SysTick interrupt.
+ *
+ * The latency to the handler is measured by ISR_PROFILER_ENTER_SYSTICK. The latency to the first instruction after WFI
+ * is the number of cycles since the reload of SysTick (LOAD - VAL), which includes SysTick_Handler.
+ *
+ * @return None
+ */
+static void Benchmarks_WFI(void)
+{
+    ISR_Profiler_Stats stats;
+    Benchmarks_Result wake_to_main;
+
+    Benchmarks_Result_Reset(&wake_to_main);
+    ISR_Profiler_Reset();
+
+    for (uint32_t i = 0; i < BENCHMARKS_SYSTICK_TICKS; i++)
+    {
+        CortexM_Sleep();
+        Benchmarks_Result_Add(&wake_to_main, SysTick->LOAD - SysTick->VAL);
+    }
+
+    ISR_Profiler_Get_Stats(ISR_PROFILER_SYSTICK, &stats);
+    Benchmarks_Print_Latency("wfi_wake_to_handler", &stats);
+    Benchmarks_Print_Result("wfi_wake_to_main", &wake_to_main, "cycles");
+}
+
+/**
+ * @brief Configures P5.0 and P5.1 as the outputs of the GPIO loopback, at their idle levels.
+ *
+ * P5.0 is high (P4.0 interrupts on a falling edge) and P5.1 is low (P6.0 interrupts on a rising edge).
+ *
+ * @return None
+ */
+static void Benchmarks_Loopback_Init(void)
+{
+    P5->SEL0 &= ~0x03;
+    P5->SEL1 &= ~0x03;
+    P5->OUT = (P5->OUT & ~0x03) | 0x01;
+    P5->DIR |= 0x03;
+}
+
+int main(void)
+{
+    CortexM_Disable_Interrupts();
+
+    // Initialize the 48 MHz Clock
+    Clock_Init48MHz();
+
+    // Enable the DWT cycle counter used by the Delay functions and to measure the interrupt handlers
+    Delay_Init();
+    ISR_Profiler_Init();
+
+    // The results are printed with printf
+    EUSCI_A0_UART_Init_Printf();
+
+    // Initialize the SysTick timer (1 ms) and the microsecond time base
+    SysTick_Interrupt_Init(SYSTICK_INT_NUM_CLK_CYCLES, SYSTICK_INT_PRIORITY);
+    Time_Init();
+
+    // Initialize the GPIO loopback before the interrupts of P4 and P6 are enabled, so that no edge is generated
+    Benchmarks_Loopback_Init();
+    Bumper_Sensors_Init(&Benchmarks_Bumper_Task);
+    PMOD_BTN_Interrupt_Init(&Benchmarks_PMOD_BTN_Task);
+
+    // Each loopback edge reaches the port handler, without a debounce window
+    Debounce_Set_Window(DEBOUNCE_PORT_P4, 0, 0);
+    Debounce_Set_Window(DEBOUNCE_PORT_P6, 0, 0);
+
+    CortexM_Enable_Interrupts();
+
+    printf("bench,revision,mclk_mhz,name,samples,min,mean,max,units\n");
+
+    for (uint8_t i = 0; i < (sizeof(Benchmarks_Profiles) / sizeof(Benchmarks_Profiles[0])); i++)
+    {
+        // A character that is being sent when the baud rate changes is lost
+        Benchmarks_Wait_TX_Idle();
+
+        if (Clock_SetProfile(Benchmarks_Profiles[i]) != 0)
+        {
+            printf("# Clock profile %u could not be selected\n", (unsigned int)Benchmarks_Profiles[i]);
+            continue;
+        }
+
+        Benchmarks_Calibrate();
+        // Placement of the handlers marked with RAM_FUNCTION (1 = SRAM, 0 = flash), to compare the Debug and Release builds
+        Benchmarks_Print("isr_in_sram", 1, RAM_FUNCTION_ENABLE, RAM_FUNCTION_ENABLE, RAM_FUNCTION_ENABLE, "flag");
+        Benchmarks_Print("cyccnt_overhead", 1, Benchmarks_CYCCNT_Overhead, Benchmarks_CYCCNT_Overhead, Benchmarks_CYCCNT_Overhead, "cycles");
+        Benchmarks_Wait_TX_Idle();
+
+        Benchmarks_SysTick();
+        Benchmarks_Wait_TX_Idle();
+
+        Benchmarks_Loopback();
+        Benchmarks_Wait_TX_Idle();
+
+        Benchmarks_UART();
+
+        Benchmarks_Critical_Sections();
+        Benchmarks_Wait_TX_Idle();
+
+        Benchmarks_WFI();
+    }
+
+    // Return to the profile of the application
+    Benchmarks_Wait_TX_Idle();
+    Clock_SetProfile(CLOCK_PROFILE_48MHZ);
+
+    printf("bench,%s,done\n", BENCHMARKS_REVISION);
+    Benchmarks_Wait_TX_Idle();
+
+    while(1)
+    {
+        CortexM_Sleep();
+    }
+}
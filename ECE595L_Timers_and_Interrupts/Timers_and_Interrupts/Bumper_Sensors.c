@@ -29,11 +29,53 @@
  */
 
 #include "../inc/Bumper_Sensors.h"
+#include "../inc/Time.h"
+#include "../inc/Critical_Section.h"
+#include "../inc/IRQ.h"
+#include "../inc/RAM_Function.h"
+#include "../inc/Config.h"
+
+// Lookup table that maps the value of P4->IN to the positive logic state of the bumper switches
+// Index bits 7, 6, and 5 map to bits 5, 4, and 3, index bits 3 and 2 map to bits 2 and 1, and index bit 0 maps to bit 0
+// The bits are inverted to account for the negative logic behavior of the bumper switches
+static const uint8_t Bumper_Table[256] =
+{
+    0x3F, 0x3E, 0x3F, 0x3E, 0x3D, 0x3C, 0x3D, 0x3C, 0x3B, 0x3A, 0x3B, 0x3A, 0x39, 0x38, 0x39, 0x38,  // 0x00 - 0x0F
+    0x3F, 0x3E, 0x3F, 0x3E, 0x3D, 0x3C, 0x3D, 0x3C, 0x3B, 0x3A, 0x3B, 0x3A, 0x39, 0x38, 0x39, 0x38,  // 0x10 - 0x1F
+    0x37, 0x36, 0x37, 0x36, 0x35, 0x34, 0x35, 0x34, 0x33, 0x32, 0x33, 0x32, 0x31, 0x30, 0x31, 0x30,  // 0x20 - 0x2F
+    0x37, 0x36, 0x37, 0x36, 0x35, 0x34, 0x35, 0x34, 0x33, 0x32, 0x33, 0x32, 0x31, 0x30, 0x31, 0x30,  // 0x30 - 0x3F
+    0x2F, 0x2E, 0x2F, 0x2E, 0x2D, 0x2C, 0x2D, 0x2C, 0x2B, 0x2A, 0x2B, 0x2A, 0x29, 0x28, 0x29, 0x28,  // 0x40 - 0x4F
+    0x2F, 0x2E, 0x2F, 0x2E, 0x2D, 0x2C, 0x2D, 0x2C, 0x2B, 0x2A, 0x2B, 0x2A, 0x29, 0x28, 0x29, 0x28,  // 0x50 - 0x5F
+    0x27, 0x26, 0x27, 0x26, 0x25, 0x24, 0x25, 0x24, 0x23, 0x22, 0x23, 0x22, 0x21, 0x20, 0x21, 0x20,  // 0x60 - 0x6F
+    0x27, 0x26, 0x27, 0x26, 0x25, 0x24, 0x25, 0x24, 0x23, 0x22, 0x23, 0x22, 0x21, 0x20, 0x21, 0x20,  // 0x70 - 0x7F
+    0x1F, 0x1E, 0x1F, 0x1E, 0x1D, 0x1C, 0x1D, 0x1C, 0x1B, 0x1A, 0x1B, 0x1A, 0x19, 0x18, 0x19, 0x18,  // 0x80 - 0x8F
+    0x1F, 0x1E, 0x1F, 0x1E, 0x1D, 0x1C, 0x1D, 0x1C, 0x1B, 0x1A, 0x1B, 0x1A, 0x19, 0x18, 0x19, 0x18,  // 0x90 - 0x9F
+    0x17, 0x16, 0x17, 0x16, 0x15, 0x14, 0x15, 0x14, 0x13, 0x12, 0x13, 0x12, 0x11, 0x10, 0x11, 0x10,  // 0xA0 - 0xAF
+    0x17, 0x16, 0x17, 0x16, 0x15, 0x14, 0x15, 0x14, 0x13, 0x12, 0x13, 0x12, 0x11, 0x10, 0x11, 0x10,  // 0xB0 - 0xBF
+    0x0F, 0x0E, 0x0F, 0x0E, 0x0D, 0x0C, 0x0D, 0x0C, 0x0B, 0x0A, 0x0B, 0x0A, 0x09, 0x08, 0x09, 0x08,  // 0xC0 - 0xCF
+    0x0F, 0x0E, 0x0F, 0x0E, 0x0D, 0x0C, 0x0D, 0x0C, 0x0B, 0x0A, 0x0B, 0x0A, 0x09, 0x08, 0x09, 0x08,  // 0xD0 - 0xDF
+    0x07, 0x06, 0x07, 0x06, 0x05, 0x04, 0x05, 0x04, 0x03, 0x02, 0x03, 0x02, 0x01, 0x00, 0x01, 0x00,  // 0xE0 - 0xEF
+    0x07, 0x06, 0x07, 0x06, 0x05, 0x04, 0x05, 0x04, 0x03, 0x02, 0x03, 0x02, 0x01, 0x00, 0x01, 0x00   // 0xF0 - 0xFF
+};
+
+/**
+ * @brief Pushes an event for a switch whose level changed during its debounce window.
+ *
+ * This function is called by the Debounce driver from TA2_N_IRQHandler, which has the same priority as PORT4_IRQHandler.
+ */
+static void Bumper_Sensors_Level_Changed(uint8_t pins, uint8_t level)
+{
+    Event_Queue_Push(EVENT_SOURCE_BUMPER_SENSORS, pins, level, Bumper_Table[Debounce_Get_Stable_State(DEBOUNCE_PORT_P4)]);
+}
 
 void Bumper_Sensors_Init(void(*task)(uint8_t))
 {
-    // Store the user-defined task function for use during interrupt handling
-    Bumper_Task = task;
+    // Subscribe the user-defined task function to the events of all bumper switches
+    // Other handlers can subscribe to specific switches with Event_Queue_Subscribe
+    if (task)
+    {
+        Event_Queue_Subscribe(EVENT_SOURCE_BUMPER_SENSORS, EVENT_ALL_PINS, task);
+    }
 
     // Configure the following pins as GPIO pins: P4.7 - P4.5, P4.3, P4.2, and P4.0
     P4->SEL0 &= ~0xED;
@@ -52,53 +94,103 @@ void Bumper_Sensors_Init(void(*task)(uint8_t))
     // Configure the pins to use falling edge event triggers: P4.7 - P4.5, P4.3, P4.2, and P4.0
     P4->IES |= 0xED;
 
+    // Debounce each of the following pins separately: P4.7 - P4.5, P4.3, P4.2, and P4.0
+    Debounce_Configure_Port(DEBOUNCE_PORT_P4, 0xED, Config_Values.bumper_sensors_debounce_ms);
+
     // Clear any existing interrupt flags
     P4->IFG &= ~0xED;
 
     // Enable interrupts on the following pins: P4.7 - P4.5, P4.3, P4.2, and P4.0
     P4->IE |= 0xED;
 
-    // Set the priority of the interrupts (IRQ 38) to 0 (section 2.4.3.20)
-    NVIC->IP[9] = (NVIC->IP[9] & 0xFF0FFFFF);
+    // Set the priority of the interrupts (IRQ 38) to the I/O tier (see IRQ_Priority.h)
+    IRQ_Set_Priority(PORT4_IRQn, IRQ_PRIORITY_BUMPER_SENSORS);
 
     // Enable Interrupt 38 in NVIC (section 2.4.3.2)
     // Bit 6 corresponds to IRQ 38
     NVIC->ISER[1] = 0x00000040;
 }
 
+void Bumper_Sensors_Set_Both_Edges(uint8_t enable)
+{
+    if (enable)
+    {
+        // Toggle the edge select of P4.7 - P4.5, P4.3, P4.2, and P4.0 after each edge
+        Debounce_Set_Both_Edges(DEBOUNCE_PORT_P4, 0xED, &Bumper_Sensors_Level_Changed);
+    }
+    else
+    {
+        Debounce_Set_Both_Edges(DEBOUNCE_PORT_P4, 0, 0);
+
+        // Go back to falling edge event triggers and drop the flags set by the change of IES
+        uint32_t sr = Critical_Section_Enter();
+        P4->IES |= 0xED;
+        P4->IFG &= ~0xED;
+        Critical_Section_Exit(sr);
+    }
+}
+
 uint8_t Bumper_Read(void)
 {
-    // Declare a local variable to store the input register value
-    // Then, read the input register P4->IN and invert its value using the bitwise NOT operator (~).
-    // This is done to account for the negative logic behavior of the bumper switches
-    uint32_t bumper_state = ~P4->IN;
-
-    // Use bitwise operations to extract the relevant bits representing the switch states.
-    // - ((bumper_state & 0xE0) >> 2): Extract bits 7, 6, and 5, and right-shift them by 2 to align them to bits 5, 4, and 3.
-    // - ((bumper_state & 0x0C) >> 1): Extract bits 3 and 2, and right-shift them by 1 to align them to bits 2 and 1.
-    // - (bumper_state & 0x01): Extract bit 0.
-    // Then, combine the extracted bits using the bitwise OR operator and return the bumper state
-    return (((bumper_state & 0xE0) >> 2) | ((bumper_state & 0x0C) >> 1) | (bumper_state & 0x01));
+    // Use the value of the input register P4->IN as the index of the lookup table,
+    // which returns the 6-bit positive logic state of the switches
+    return Bumper_Table[P4->IN];
+}
+
+void Bumper_Read_Burst(Bumper_Sample *samples, uint16_t count, uint32_t interval_cycles)
+{
+    uint32_t next_sample_time = (uint32_t)Time_NowCycles();
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint32_t now = (uint32_t)Time_NowCycles();
+
+        // Wait until the time of the next sample (signed difference for rollover)
+        while ((int32_t)(now - next_sample_time) < 0)
+        {
+            now = (uint32_t)Time_NowCycles();
+        }
+
+        samples[i].state = Bumper_Table[P4->IN];
+        samples[i].timestamp = now;
+
+        next_sample_time += interval_cycles;
+    }
 }
 
 /**
  * @brief Interrupt handler for PORT4 (P4) events.
  *
  * This function is an interrupt service routine (ISR) for PORT4 (P4) of the TI MSP432 LaunchPad.
- * It is triggered on a falling edge event on any of the switches connected to P4 (BUMP_0 to BUMP_5).
- * The function clears all interrupt flags for PORT4 and then executes the user-defined task function (Bump_Task)
- * by passing the current state of the switches, which is obtained by calling Bump_Read().
- *
- * @note This function does not handle critical section/race conditions.
+ * It is triggered on a falling edge event (or on both edges, see Bumper_Sensors_Set_Both_Edges) on any of the switches
+ * connected to P4 (BUMP_0 to BUMP_5). The function reads P4->IV until no flag is left, so each switch is handled separately.
+ * For each switch, it samples the new level, starts the debounce window (which disables its interrupt until the window expires),
+ * and then pushes the pin, its level and the state of the switches into the Event_Queue.
+ * The subscribed handlers are called later from the main loop by Event_Queue_Dispatch.
  *
  * @return None
  */
-void PORT4_IRQHandler(void)
+RAM_FUNCTION void PORT4_IRQHandler(void)
 {
-    // Clear the interrupt flags for P4.7 - P4.5, P4.3, P4.2, and P4.0
-    P4->IFG &= ~0xED;
+    ISR_PROFILER_ENTER();
+
+    uint16_t vector;
+
+    // Reading P4->IV returns the highest priority pending interrupt (0x02 for P4.0 up to 0x10 for P4.7) and clears its flag
+    // An edge that occurs while the handler is running is found by the next read, so each edge is reported once
+    while ((vector = P4->IV) != 0)
+    {
+        uint8_t pin = (1 << ((vector >> 1) - 1));
+
+        if ((pin & 0xED) == 0) continue;
+
+        // Sample the new level of the switch, and ignore its bounces until its debounce window expires
+        uint8_t level = Debounce_Edge(DEBOUNCE_PORT_P4, pin);
+
+        // Defer the user-defined task to the main loop
+        // The state is built from the sampled levels, so it matches the level of the pin that triggered the event
+        Event_Queue_Push(EVENT_SOURCE_BUMPER_SENSORS, pin, level, Bumper_Table[Debounce_Get_Stable_State(DEBOUNCE_PORT_P4)]);
+    }
 
-    uint8_t bumper_sensor_val = Bumper_Read();
-    // Execute the user-defined task
-    (*Bumper_Task)(bumper_sensor_val);
+    ISR_PROFILER_EXIT(ISR_PROFILER_PORT4);
 }
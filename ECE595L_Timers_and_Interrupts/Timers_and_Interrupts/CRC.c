@@ -0,0 +1,154 @@
+/**
+ * @file CRC.c
+ * @brief Source code for the CRC driver.
+ *
+ * This file contains the function definitions for the CRC driver.
+ * It uses the CRC32 module to compute CRC-32 and CRC-16/CCITT-FALSE checksums.
+ *
+ * The engines shift the data in the order of the standard CRC polynomials (most significant bit of the signature first):
+ *  - A byte written to CRC32DI32 is processed from bit 0 to bit 7, which is the bit order of the reflected CRC-32.
+ *    The reflected signature is read from CRC32RESR32, and it is inverted for the final XOR.
+ *  - A byte written to CRC32DIRB16 is processed from bit 7 to bit 0, which is the bit order of CRC-16/CCITT-FALSE.
+ *    The signature is read from CRC32INIRES16.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/CRC.h"
+#include "../inc/DMA.h"
+
+// Data input registers used for each mode, written one byte at a time
+#define CRC_DATA_INPUT_32   (*((volatile uint8_t *)&CRC32->DI32))
+#define CRC_DATA_INPUT_16   (*((volatile uint8_t *)&CRC32->DIRB16))
+
+static uint8_t crc_dma_initialized = 0;
+
+/**
+ * @brief Reverses the order of the bits of a 32-bit value.
+ */
+static uint32_t CRC_Reverse_Bits(uint32_t value)
+{
+    value = ((value >> 1) & 0x55555555) | ((value & 0x55555555) << 1);
+    value = ((value >> 2) & 0x33333333) | ((value & 0x33333333) << 2);
+    value = ((value >> 4) & 0x0F0F0F0F) | ((value & 0x0F0F0F0F) << 4);
+    value = ((value >> 8) & 0x00FF00FF) | ((value & 0x00FF00FF) << 8);
+
+    return (value >> 16) | (value << 16);
+}
+
+/**
+ * @brief Waits until the DMA transfer of CRC_Feed_DMA, if any, is complete.
+ */
+static void CRC_Wait_DMA(void)
+{
+    if (crc_dma_initialized == 0) return;
+
+    while (DMA_Channel_Busy(CRC_DMA_CHANNEL));
+}
+
+void CRC_Init(void)
+{
+    if (crc_dma_initialized) return;
+
+    DMA_Init();
+
+    // Source 0 is reserved on every channel, so the channel is only triggered by software
+    DMA_Set_Channel_Source(CRC_DMA_CHANNEL, 0);
+
+    crc_dma_initialized = 1;
+}
+
+void CRC_Start(CRC_Mode mode, uint32_t crc)
+{
+    CRC_Wait_DMA();
+
+    if (mode == CRC_MODE_CRC32)
+    {
+        // The engine holds the signature before the final XOR and in the order of the polynomial
+        // CRC_CRC32_INITIAL (0) results in the standard initial value 0xFFFFFFFF
+        uint32_t signature = CRC_Reverse_Bits(~crc);
+        CRC32->INIRES32_LO = (uint16_t)signature;
+        CRC32->INIRES32_HI = (uint16_t)(signature >> 16);
+    }
+    else
+    {
+        CRC32->INIRES16 = (uint16_t)crc;
+    }
+}
+
+void CRC_Feed(CRC_Mode mode, const uint8_t *data, uint32_t length)
+{
+    CRC_Wait_DMA();
+
+    if (mode == CRC_MODE_CRC32)
+    {
+        while (length--)
+        {
+            CRC_DATA_INPUT_32 = *data++;
+        }
+    }
+    else
+    {
+        while (length--)
+        {
+            CRC_DATA_INPUT_16 = *data++;
+        }
+    }
+}
+
+void CRC_Feed_DMA(CRC_Mode mode, const uint8_t *data, uint32_t length)
+{
+#if defined(HOST_BUILD)
+    CRC_Feed(mode, data, length);
+#else
+    volatile uint8_t *data_input = (mode == CRC_MODE_CRC32) ? &CRC_DATA_INPUT_32 : &CRC_DATA_INPUT_16;
+
+    CRC_Init();
+
+    while (length > 0)
+    {
+        uint32_t count = (length > DMA_MAX_TRANSFER_SIZE) ? DMA_MAX_TRANSFER_SIZE : length;
+
+        // Wait for the previous block, and clear its completion flag (DMA_INT0 is not enabled)
+        CRC_Wait_DMA();
+        DMA_Clear_Interrupt_Flag(CRC_DMA_CHANNEL);
+
+        // Write each byte to the same data input register
+        DMA_Start_Software(CRC_DMA_CHANNEL, &data[count - 1], data_input,
+                           DMA_CTRL_DST_INC_NONE | DMA_CTRL_SRC_INC_BYTE | DMA_CTRL_SIZE_8, count);
+
+        data += count;
+        length -= count;
+    }
+#endif
+}
+
+uint8_t CRC_Busy(void)
+{
+    if (crc_dma_initialized == 0) return 0;
+
+    return DMA_Channel_Busy(CRC_DMA_CHANNEL);
+}
+
+uint32_t CRC_Finalize(CRC_Mode mode)
+{
+    CRC_Wait_DMA();
+
+    if (mode == CRC_MODE_CRC32)
+    {
+        // Read the reflected signature and apply the final XOR
+        uint32_t signature = ((uint32_t)CRC32->RESR32_HI << 16) | CRC32->RESR32_LO;
+        return ~signature;
+    }
+
+    return CRC32->INIRES16;
+}
+
+uint32_t CRC_Compute(CRC_Mode mode, uint32_t crc, const uint8_t *data, uint32_t length)
+{
+    CRC_Start(mode, crc);
+    CRC_Feed(mode, data, length);
+
+    return CRC_Finalize(mode);
+}
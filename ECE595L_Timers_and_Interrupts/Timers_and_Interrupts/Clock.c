@@ -44,9 +44,40 @@ policies, either expressed or implied, of the FreeBSD Project.
 #include <stdint.h>
 #include "msp.h"
 #include "../inc/Clock.h"
+#include "../inc/Critical_Section.h"
 
 uint32_t ClockFrequency = 3000000; // cycles/second
-//static uint32_t SubsystemFrequency = 3000000; // cycles/second
+static uint32_t SubsystemFrequency = 3000000; // SMCLK cycles/second
+static Clock_Profile Profile = CLOCK_PROFILE_3MHZ;
+
+// loops of Clock_Delay1us per 100 us (382 tuned at 48 MHz, scaled by Clock_SetProfile)
+static uint32_t Delay1usLoops = 23;
+
+static Clock_Change_Handler ChangeHandlers[CLOCK_MAX_CHANGE_HANDLERS];
+static uint8_t NumChangeHandlers = 0;
+
+typedef struct{
+  uint32_t mclk;                        // MCLK frequency (Hz)
+  uint32_t smclk;                       // SMCLK frequency (Hz)
+  uint32_t activeMode;                  // PCM AMR: 0 for AM_LDO_VCORE0, 1 for AM_LDO_VCORE1
+  uint32_t waitStates;                  // flash read wait states (FLCTL_BANKx_RDCTL WAIT field)
+  uint32_t useHFXT;                     // 1 if MCLK and SMCLK are sourced from HFXTCLK
+  uint32_t ctl0;                        // CS->CTL0 (DCO frequency range)
+  uint32_t ctl1;                        // CS->CTL1 (sources and dividers)
+} Clock_Config;
+
+// VCORE0 supports MCLK up to 24 MHz and SMCLK up to 12 MHz
+// 0 wait states support up to 12 MHz at VCORE0, 1 wait state up to 24 MHz, and 2 wait states 48 MHz at VCORE1
+static const Clock_Config Configs[CLOCK_NUM_PROFILES] = {
+  // 48 MHz: HFXT, SMCLK /4 = 12 MHz, HSMCLK /2 = 24 MHz, ACLK from REFOCLK (DCO range 1 unused)
+  {48000000, 12000000, 1, 2, 1, 0x00010000, 0x20000000|0x00100000|0x00000200|0x00000050|0x00000005},
+  // 24 MHz: DCO range 4 (DCORSEL = 4), SMCLK /2 = 12 MHz, ACLK from REFOCLK
+  {24000000, 12000000, 0, 1, 0, 0x00040000, 0x10000000|0x00000200|0x00000030|0x00000003},
+  // 12 MHz: DCO range 3 (DCORSEL = 3), SMCLK /1, ACLK from REFOCLK
+  {12000000, 12000000, 0, 0, 0, 0x00030000, 0x00000200|0x00000030|0x00000003},
+  // 3 MHz: DCO range 1 (DCORSEL = 1), SMCLK /1, ACLK from REFOCLK
+  { 3000000,  3000000, 0, 0, 0, 0x00010000, 0x00000200|0x00000030|0x00000003}
+};
 
 // ------------Clock_InitFastest------------
 // Configure the system clock to run at the fastest
@@ -62,46 +93,64 @@ uint32_t Postwait = 0;                  // loops between Current Power Mode matc
 uint32_t IFlags = 0;                    // non-zero if transition is invalid
 uint32_t Crystalstable = 0;             // loops before the crystal stabilizes (expect small)
 void Clock_Init48MHz(void){
+  Clock_SetProfile(CLOCK_PROFILE_48MHZ);
+}
+
+// request power active mode LDO VCORE0 (activeMode = 0) or LDO VCORE1 (activeMode = 1)
+// returns 0 on success, -1 on time out or invalid transition
+static int8_t Clock_SetActiveMode(uint32_t activeMode){
+  if((PCM->CTL0&0x00003F00) == (activeMode<<8)){
+    return 0;                           // already in the requested mode
+  }
   // wait for the PCMCTL0 and Clock System to be write-able by waiting for Power Control Manager to be idle
+  Prewait = 0;
   while(PCM->CTL1&0x00000100){
-//  while(PCMCTL1&0x00000100){
     Prewait = Prewait + 1;
     if(Prewait >= 100000){
-      return;                           // time out error
+      return -1;                        // time out error
     }
   }
-  // request power active mode LDO VCORE1 to support the 48 MHz frequency
   PCM->CTL0 = (PCM->CTL0&~0xFFFF000F) |     // clear PCMKEY bit field and AMR bit field
-//  PCMCTL0 = (PCMCTL0&~0xFFFF000F) |     // clear PCMKEY bit field and AMR bit field
             0x695A0000 |                // write the proper PCM key to unlock write access
-            0x00000001;                 // request power active mode LDO VCORE1
+            activeMode;                 // request power active mode LDO VCORE0 or LDO VCORE1
   // check if the transition is invalid (see Figure 7-3 on p344 of datasheet)
   if(PCM->IFG&0x00000004){
     IFlags = PCM->IFG;                    // bit 2 set on active mode transition invalid; bits 1-0 are for LPM-related errors; bit 6 is for DC-DC-related error
     PCM->CLRIFG = 0x00000004;             // clear the transition invalid flag
-    // to do: look at CPM bit field in PCMCTL0, figure out what mode you're in, and step through the chart to transition to the mode you want
-    // or be lazy and do nothing; this should work out of reset at least, but it WILL NOT work if Clock_Int32kHz() or Clock_InitLowPower() has been called
-    return;
+    // AM_LDO_VCORE0 <-> AM_LDO_VCORE1 is always valid, so this only happens if the DC-DC regulator is in use
+    return -1;
   }
-  // wait for the CPM (Current Power Mode) bit field to reflect a change to active mode LDO VCORE1
-  while((PCM->CTL0&0x00003F00) != 0x00000100){
+  // wait for the CPM (Current Power Mode) bit field to reflect a change to the requested mode
+  CPMwait = 0;
+  while((PCM->CTL0&0x00003F00) != (activeMode<<8)){
     CPMwait = CPMwait + 1;
     if(CPMwait >= 500000){
-      return;                           // time out error
+      return -1;                        // time out error
     }
   }
   // wait for the PCMCTL0 and Clock System to be write-able by waiting for Power Control Manager to be idle
+  Postwait = 0;
   while(PCM->CTL1&0x00000100){
     Postwait = Postwait + 1;
     if(Postwait >= 100000){
-      return;                           // time out error
+      return -1;                        // time out error
     }
   }
+  return 0;
+}
+
+// configure the number of wait states of flash Bank 0 and Bank 1
+static void Clock_SetWaitStates(uint32_t waitStates){
+  FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL&~0x0000F000)|(waitStates<<12);
+  FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL&~0x0000F000)|(waitStates<<12);
+}
+
+// start the 48 MHz crystal and wait for it to stabilize
+// returns 0 on success, -1 on time out
+static int8_t Clock_StartHFXT(void){
   // initialize PJ.3 and PJ.2 and make them HFXT (PJ.3 built-in 48 MHz crystal out; PJ.2 built-in 48 MHz crystal in)
   PJ->SEL0 |= 0x0C;
   PJ->SEL1 &= ~0x0C;                    // configure built-in 48 MHz crystal for HFXT operation
-//  PJDIR |= 0x08;                      // make PJ.3 HFXTOUT (unnecessary)
-//  PJDIR &= ~0x04;                     // make PJ.2 HFXTIN (unnecessary)
   CS->KEY = 0x695A;                     // unlock CS module for register access
   CS->CTL2 = (CS->CTL2&~0x00700000) |   // clear HFXTFREQ bit field
            0x00600000 |                 // configure for 48 MHz external crystal
@@ -109,25 +158,114 @@ void Clock_Init48MHz(void){
            0x01000000;                  // enable HFXT
   CS->CTL2 &= ~0x02000000;              // disable high-frequency crystal bypass
   // wait for the HFXT clock to stabilize
+  Crystalstable = 0;
   while(CS->IFG&0x00000002){
     CS->CLRIFG = 0x00000002;              // clear the HFXT oscillator interrupt flag
     Crystalstable = Crystalstable + 1;
     if(Crystalstable > 100000){
-      return;                           // time out error
+      CS->KEY = 0;                      // lock CS module from unintended access
+      return -1;                        // time out error
+    }
+  }
+  CS->KEY = 0;                          // lock CS module from unintended access
+  return 0;
+}
+
+// ------------Clock_SetProfile------------
+// Switch MCLK and SMCLK to one of the profiles and
+// call the change handlers.
+// Input: profile to use
+// Output: 0 on success, -1 on error (the previous profile is kept)
+int8_t Clock_SetProfile(Clock_Profile profile){
+  if(profile >= CLOCK_NUM_PROFILES){
+    return -1;
+  }
+  if(profile == Profile){
+    return 0;
+  }
+  const Clock_Config *config = &Configs[profile];
+  const Clock_Config *previous = &Configs[Profile];
+  // raise the wait states and VCORE before the frequency increases
+  if(config->waitStates > previous->waitStates){
+    Clock_SetWaitStates(config->waitStates);
+  }
+  if(config->activeMode > previous->activeMode){
+    if(Clock_SetActiveMode(config->activeMode)){
+      Clock_SetWaitStates(previous->waitStates);
+      return -1;
     }
   }
-  // configure for 2 wait states (minimum for 48 MHz operation) for flash Bank 0
-  FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL&~0x0000F000)|FLCTL_BANK0_RDCTL_WAIT_2;
-  // configure for 2 wait states (minimum for 48 MHz operation) for flash Bank 1
-  FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL&~0x0000F000)|FLCTL_BANK1_RDCTL_WAIT_2;
-  CS->CTL1 = 0x20000000 |               // configure for SMCLK divider /4
-           0x00100000 |                 // configure for HSMCLK divider /2
-           0x00000200 |                 // configure for ACLK sourced from REFOCLK
-           0x00000050 |                 // configure for SMCLK and HSMCLK sourced from HFXTCLK
-           0x00000005;                  // configure for MCLK sourced from HFXTCLK
+  // the crystal can take a few ms to start, so it is started before interrupts are disabled
+  if(config->useHFXT && Clock_StartHFXT()){
+    Clock_SetActiveMode(previous->activeMode);
+    Clock_SetWaitStates(previous->waitStates);
+    return -1;
+  }
+  uint32_t previousMCLK = ClockFrequency;
+  uint32_t previousSMCLK = SubsystemFrequency;
+  uint32_t sr = Critical_Section_Enter();
+  CS->KEY = 0x695A;                     // unlock CS module for register access
+  // the dividers are changed first when the frequency increases, and last when it decreases,
+  // so SMCLK never goes above the limit of the current VCORE level between the two writes
+  if(config->mclk > previous->mclk){
+    CS->CTL1 = config->ctl1;            // select the sources and dividers of MCLK, SMCLK, HSMCLK, and ACLK
+    CS->CTL0 = config->ctl0;            // select the DCO frequency range (DCOTUNE = 0)
+  } else{
+    CS->CTL0 = config->ctl0;
+    CS->CTL1 = config->ctl1;
+  }
+  if(config->useHFXT == 0){
+    CS->CTL2 &= ~0x01000000;            // disable HFXT, which is not used anymore
+  }
   CS->KEY = 0;                          // lock CS module from unintended access
-  ClockFrequency = 48000000;
-//  SubsystemFrequency = 12000000;
+  ClockFrequency = config->mclk;
+  SubsystemFrequency = config->smclk;
+  Profile = profile;
+  // 382 loops per 100 us at 48 MHz
+  Delay1usLoops = (382*(ClockFrequency/1000000))/48;
+  for(uint8_t i = 0; i < NumChangeHandlers; i++){
+    ChangeHandlers[i](previousMCLK, previousSMCLK);
+  }
+  Critical_Section_Exit(sr);
+  // lower VCORE and the wait states after the frequency decreases
+  // a failure here is not an error, since the higher level also supports the new frequency
+  if(config->activeMode < previous->activeMode){
+    Clock_SetActiveMode(config->activeMode);
+  }
+  if(config->waitStates < previous->waitStates){
+    Clock_SetWaitStates(config->waitStates);
+  }
+  return 0;
+}
+
+// ------------Clock_GetProfile------------
+// Return the current clock profile.
+// Input: none
+// Output: profile selected by Clock_SetProfile
+Clock_Profile Clock_GetProfile(void){
+  return Profile;
+}
+
+// ------------Clock_AddChangeHandler------------
+// Register a function that is called after each
+// profile switch.
+// Input: handler to call
+// Output: 0 on success, -1 if the table is full
+int8_t Clock_AddChangeHandler(Clock_Change_Handler handler){
+  if(handler == 0){
+    return -1;
+  }
+  for(uint8_t i = 0; i < NumChangeHandlers; i++){
+    if(ChangeHandlers[i] == handler){
+      return 0;                         // already registered
+    }
+  }
+  if(NumChangeHandlers >= CLOCK_MAX_CHANGE_HANDLERS){
+    return -1;
+  }
+  ChangeHandlers[NumChangeHandlers] = handler;
+  NumChangeHandlers++;
+  return 0;
 }
 
 // ------------Clock_GetFreq------------
@@ -139,6 +277,14 @@ uint32_t Clock_GetFreq(void){
   return ClockFrequency;
 }
 
+// ------------Clock_GetSMCLKFreq------------
+// Return the current SMCLK frequency.
+// Input: none
+// Output: SMCLK frequency in cycles/second
+uint32_t Clock_GetSMCLKFreq(void){
+  return SubsystemFrequency;
+}
+
 
 // delay function
 // which delays about 6*ulCount cycles
@@ -154,7 +300,7 @@ void delay(unsigned long ulCount){
 // Inputs: n, number of us to wait
 // Outputs: none
 void Clock_Delay1us(uint32_t n){
-  n = (382*n)/100;; // 1 us, tuned at 48 MHz
+  n = (Delay1usLoops*n)/100; // 1 us, tuned at 48 MHz and scaled by Clock_SetProfile
   while(n){
     n--;
   }
@@ -166,7 +312,7 @@ void Clock_Delay1us(uint32_t n){
 // Outputs: none
 void Clock_Delay1ms(uint32_t n){
   while(n){
-    delay(ClockFrequency/9162);   // 1 msec, tuned at 48 MHz
+    delay(ClockFrequency/9162);   // 1 msec, tuned at 48 MHz (scales with ClockFrequency)
     n--;
   }
 }
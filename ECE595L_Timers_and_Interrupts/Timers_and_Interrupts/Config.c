@@ -0,0 +1,464 @@
+/**
+ * @file Config.c
+ * @brief Source code for the Config driver.
+ *
+ * This file contains the function definitions for the Config driver.
+ * It loads the settings from the flash sectors of CONFIG_FLASH_ADDRESS, and programs them with the flash controller (FLCTL).
+ *
+ * Each sector is divided in slots of one 128-bit flash word (4 words of 32 bits):
+ *  - Slot 0 (header):   CONFIG_MAGIC, sequence number, CONFIG_NUM_KEYS, CRC-32 of the first 3 words
+ *  - Other slots:       key, value, 0, CRC-32 of the first 3 words
+ * The slots are programmed in order, and the first erased slot is the end of the log.
+ *
+ * For more information regarding the flash controller, refer to the Flash Controller section (9)
+ * of the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include <stddef.h>
+#include "../inc/Config.h"
+#include "../inc/CRC.h"
+#include "../inc/Debounce.h"
+#include "../inc/SysTick_Interrupt.h"
+#include "../inc/Bumper_Sensors.h"
+#include "../inc/PMOD_BTN_Interrupt.h"
+
+// Value of the first word of a header ("CFG1")
+#define CONFIG_MAGIC 0x31474643
+
+// Number of 32-bit words in a slot (one flash word)
+#define CONFIG_SLOT_WORDS 4
+
+// Number of slots in a sector, including the header
+#define CONFIG_NUM_SLOTS (CONFIG_SECTOR_SIZE / (CONFIG_SLOT_WORDS * 4))
+
+// Value of an erased flash word
+#define CONFIG_ERASED 0xFFFFFFFF
+
+// Number of the first sector in bank 1 (bank 1 starts at 0x20000)
+#define CONFIG_BANK1_SECTOR ((CONFIG_FLASH_ADDRESS - 0x20000) / CONFIG_SECTOR_SIZE)
+
+// The flash is simulated in the host build
+#if defined(HOST_BUILD)
+#define CONFIG_FLASH_WORDS(address) Host_Sim_Flash(address)
+#else
+#define CONFIG_FLASH_WORDS(address) ((volatile uint32_t *)(address))
+#endif
+
+/**
+ * @brief Description of a setting: its name, its field in Config_Settings, and its valid values.
+ */
+typedef struct
+{
+    const char *name;
+    uint16_t offset;
+    uint32_t default_value;
+    uint32_t min;
+    uint32_t max;
+} Config_Entry;
+
+static const Config_Entry config_entries[CONFIG_NUM_KEYS] =
+{
+    {"systick_toggle_rate_ms",      offsetof(Config_Settings, systick_toggle_rate_ms),      SYSTICK_INT_TOGGLE_RATE_MS,     1,      60000},
+    {"systick_2s_toggle_rate_ms",   offsetof(Config_Settings, systick_2s_toggle_rate_ms),   SYSTICK_INT_2S_TOGGLE_RATE_MS,  1,      60000},
+    // SysTick->LOAD has 24 bits, and a period shorter than 100 us leaves little time for the main loop
+    {"systick_num_clk_cycles",      offsetof(Config_Settings, systick_num_clk_cycles),      SYSTICK_INT_NUM_CLK_CYCLES,     4800,   0x01000000},
+    // SysTick stays in the timing-critical tier of IRQ_Priority.h
+    {"systick_priority",            offsetof(Config_Settings, systick_priority),            SYSTICK_INT_PRIORITY,           IRQ_PRIORITY(IRQ_PRIORITY_TIER_TIMING_CRITICAL, 0),
+                                                                                                                            IRQ_PRIORITY(IRQ_PRIORITY_TIER_TIMING_CRITICAL, 1)},
+    {"bumper_sensors_debounce_ms",  offsetof(Config_Settings, bumper_sensors_debounce_ms),  BUMPER_SENSORS_DEBOUNCE_MS,     1,      DEBOUNCE_MAX_WINDOW_MS},
+    {"pmod_btn_debounce_ms",        offsetof(Config_Settings, pmod_btn_debounce_ms),        PMOD_BTN_DEBOUNCE_MS,           1,      DEBOUNCE_MAX_WINDOW_MS}
+};
+
+Config_Settings Config_Values =
+{
+    SYSTICK_INT_TOGGLE_RATE_MS,
+    SYSTICK_INT_2S_TOGGLE_RATE_MS,
+    SYSTICK_INT_NUM_CLK_CYCLES,
+    SYSTICK_INT_PRIORITY,
+    BUMPER_SENSORS_DEBOUNCE_MS,
+    PMOD_BTN_DEBOUNCE_MS
+};
+
+// Sector that holds the newest valid header, or -1 if no sector is valid
+static int8_t config_active_sector = -1;
+
+// Sequence number of the active sector
+static uint32_t config_sequence = 0;
+
+// First erased slot of the active sector (CONFIG_NUM_SLOTS when the sector is full)
+static uint16_t config_next_slot = CONFIG_NUM_SLOTS;
+
+// Value of each setting that is stored in flash (its default value if it has no record)
+static uint32_t config_stored[CONFIG_NUM_KEYS];
+
+/**
+ * @brief Returns a pointer to the field of a setting in Config_Values.
+ */
+static uint32_t *Config_Field(Config_Key key)
+{
+    return (uint32_t *)((uint8_t *)&Config_Values + config_entries[key].offset);
+}
+
+/**
+ * @brief Returns 1 if the value is in the range of the setting.
+ */
+static uint8_t Config_Value_Valid(Config_Key key, uint32_t value)
+{
+    return (value >= config_entries[key].min) && (value <= config_entries[key].max);
+}
+
+/**
+ * @brief Returns the address of a slot.
+ */
+static uint32_t Config_Slot_Address(uint8_t sector, uint16_t slot)
+{
+    return CONFIG_FLASH_ADDRESS + (sector * CONFIG_SECTOR_SIZE) + (slot * CONFIG_SLOT_WORDS * 4);
+}
+
+/**
+ * @brief Copies a slot from flash.
+ */
+static void Config_Read_Slot(uint8_t sector, uint16_t slot, uint32_t *words)
+{
+    volatile uint32_t *flash = CONFIG_FLASH_WORDS(Config_Slot_Address(sector, slot));
+
+    for (uint8_t i = 0; i < CONFIG_SLOT_WORDS; i++)
+    {
+        words[i] = flash[i];
+    }
+}
+
+/**
+ * @brief Returns the CRC-32 of the first 3 words of a slot.
+ */
+static uint32_t Config_Slot_CRC(const uint32_t *words)
+{
+    return CRC_Compute(CRC_MODE_CRC32, CRC_CRC32_INITIAL, (const uint8_t *)words, (CONFIG_SLOT_WORDS - 1) * 4);
+}
+
+/**
+ * @brief Returns 1 if all the words of a slot are erased.
+ */
+static uint8_t Config_Slot_Erased(const uint32_t *words)
+{
+    for (uint8_t i = 0; i < CONFIG_SLOT_WORDS; i++)
+    {
+        if (words[i] != CONFIG_ERASED) return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Allows the flash controller to program and erase the sectors of the Config driver.
+ */
+static void Config_Unprotect(void)
+{
+    FLCTL->BANK1_MAIN_WEPROT &= ~(0x3 << CONFIG_BANK1_SECTOR);
+}
+
+/**
+ * @brief Protects the sectors of the Config driver against program and erase operations.
+ */
+static void Config_Protect(void)
+{
+    FLCTL->BANK1_MAIN_WEPROT |= (0x3 << CONFIG_BANK1_SECTOR);
+}
+
+/**
+ * @brief Programs one slot in full word mode, and checks its content.
+ *
+ * @return 0 on success, or -1 if the flash controller reported an error or the slot does not hold the words.
+ */
+static int8_t Config_Program_Slot(uint8_t sector, uint16_t slot, const uint32_t *words)
+{
+    volatile uint32_t *flash = CONFIG_FLASH_WORDS(Config_Slot_Address(sector, slot));
+    int8_t result = 0;
+
+    // Clear the program and program error flags
+    FLCTL->CLRIFG = 0x00000208;
+
+    // Enable programming in full word mode (the flash word is programmed when its 4 words are written), with pre- and post-program verify
+    FLCTL->PRG_CTLSTAT = 0x0000000F;
+
+    for (uint8_t i = 0; i < CONFIG_SLOT_WORDS; i++)
+    {
+        flash[i] = words[i];
+    }
+
+    // Wait until the program operation is complete (STATUS is idle)
+    while (FLCTL->PRG_CTLSTAT & 0x00030000);
+
+    // Check the program error flag
+    if (FLCTL->IFG & 0x00000200) result = -1;
+
+    // Disable programming, and keep the verify settings of the reset state
+    FLCTL->PRG_CTLSTAT = 0x0000000C;
+
+    for (uint8_t i = 0; i < CONFIG_SLOT_WORDS; i++)
+    {
+        if (flash[i] != words[i]) result = -1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Erases one sector, and checks that all its words are erased.
+ *
+ * @return 0 on success, or -1 if the flash controller reported an error or the sector is not erased.
+ */
+static int8_t Config_Erase_Sector(uint8_t sector)
+{
+    volatile uint32_t *flash = CONFIG_FLASH_WORDS(Config_Slot_Address(sector, 0));
+    int8_t result = 0;
+
+    // Select a sector erase (MODE = 0) of the main memory (TYPE = 0)
+    FLCTL->ERASE_CTLSTAT &= ~0x0000000E;
+
+    // Set the address of the sector
+    FLCTL->ERASE_SECTADDR = Config_Slot_Address(sector, 0);
+
+    // Start the erase operation, and wait until it is complete (STATUS = 3)
+    FLCTL->ERASE_CTLSTAT |= 0x00000001;
+    while (((FLCTL->ERASE_CTLSTAT >> 16) & 0x3) != 0x3);
+
+    // Check the address error flag, and clear the status
+    if (FLCTL->ERASE_CTLSTAT & 0x00040000) result = -1;
+    FLCTL->ERASE_CTLSTAT |= 0x00080000;
+
+    for (uint16_t i = 0; i < (CONFIG_SECTOR_SIZE / 4); i++)
+    {
+        if (flash[i] != CONFIG_ERASED) result = -1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Programs a record at the end of the active sector.
+ */
+static int8_t Config_Append_Record(uint8_t sector, uint16_t slot, Config_Key key, uint32_t value)
+{
+    uint32_t words[CONFIG_SLOT_WORDS] = {key, value, 0, 0};
+
+    words[3] = Config_Slot_CRC(words);
+
+    return Config_Program_Slot(sector, slot, words);
+}
+
+/**
+ * @brief Writes the settings that differ from their default values to the inactive sector, and makes it the active sector.
+ *
+ * The header is programmed last, so the previous sector stays active until the new sector is complete.
+ */
+static int8_t Config_Compact(void)
+{
+    uint8_t sector = (config_active_sector == 0) ? 1 : 0;
+    uint32_t header[CONFIG_SLOT_WORDS] = {CONFIG_MAGIC, config_sequence + 1, CONFIG_NUM_KEYS, 0};
+    uint16_t slot = 1;
+
+    if (Config_Erase_Sector(sector) != 0) return -1;
+
+    for (uint8_t key = 0; key < CONFIG_NUM_KEYS; key++)
+    {
+        uint32_t value = *Config_Field((Config_Key)key);
+
+        if (value == config_entries[key].default_value) continue;
+
+        if (Config_Append_Record(sector, slot, (Config_Key)key, value) != 0) return -1;
+
+        slot++;
+    }
+
+    header[3] = Config_Slot_CRC(header);
+
+    if (Config_Program_Slot(sector, 0, header) != 0) return -1;
+
+    config_active_sector = sector;
+    config_sequence = header[1];
+    config_next_slot = slot;
+
+    for (uint8_t key = 0; key < CONFIG_NUM_KEYS; key++)
+    {
+        config_stored[key] = *Config_Field((Config_Key)key);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Returns 1 if the sector starts with a valid header, and its sequence number.
+ */
+static uint8_t Config_Header_Valid(uint8_t sector, uint32_t *sequence)
+{
+    uint32_t words[CONFIG_SLOT_WORDS];
+
+    Config_Read_Slot(sector, 0, words);
+
+    if ((words[0] != CONFIG_MAGIC) || (words[3] != Config_Slot_CRC(words))) return 0;
+
+    *sequence = words[1];
+
+    return 1;
+}
+
+void Config_Init(void)
+{
+    uint32_t sequence;
+
+    config_active_sector = -1;
+    config_sequence = 0;
+    config_next_slot = CONFIG_NUM_SLOTS;
+
+    for (uint8_t key = 0; key < CONFIG_NUM_KEYS; key++)
+    {
+        config_stored[key] = config_entries[key].default_value;
+    }
+
+    // Select the valid sector with the newest sequence number (the difference handles a sequence number that wraps around)
+    for (uint8_t sector = 0; sector < CONFIG_NUM_SECTORS; sector++)
+    {
+        if (Config_Header_Valid(sector, &sequence) == 0) continue;
+
+        if ((config_active_sector < 0) || ((int32_t)(sequence - config_sequence) > 0))
+        {
+            config_active_sector = sector;
+            config_sequence = sequence;
+        }
+    }
+
+    if (config_active_sector >= 0)
+    {
+        uint16_t slot;
+
+        // Read the records until the first erased slot, and skip the records that are not valid
+        for (slot = 1; slot < CONFIG_NUM_SLOTS; slot++)
+        {
+            uint32_t words[CONFIG_SLOT_WORDS];
+
+            Config_Read_Slot(config_active_sector, slot, words);
+
+            if (Config_Slot_Erased(words)) break;
+
+            if ((words[3] != Config_Slot_CRC(words)) || (words[0] >= CONFIG_NUM_KEYS)) continue;
+
+            if (Config_Value_Valid((Config_Key)words[0], words[1]))
+            {
+                config_stored[words[0]] = words[1];
+            }
+        }
+
+        config_next_slot = slot;
+    }
+
+    for (uint8_t key = 0; key < CONFIG_NUM_KEYS; key++)
+    {
+        *Config_Field((Config_Key)key) = config_stored[key];
+    }
+}
+
+Config_Key Config_Find_Key(const char *name)
+{
+    for (uint8_t key = 0; key < CONFIG_NUM_KEYS; key++)
+    {
+        const char *entry_name = config_entries[key].name;
+        uint8_t i = 0;
+
+        while ((name[i] != '\0') && (name[i] == entry_name[i])) i++;
+
+        if ((name[i] == '\0') && (entry_name[i] == '\0')) return (Config_Key)key;
+    }
+
+    return CONFIG_NUM_KEYS;
+}
+
+const char *Config_Get_Name(Config_Key key)
+{
+    if (key >= CONFIG_NUM_KEYS) return 0;
+
+    return config_entries[key].name;
+}
+
+uint32_t Config_Get(Config_Key key)
+{
+    if (key >= CONFIG_NUM_KEYS) return 0;
+
+    return *Config_Field(key);
+}
+
+int8_t Config_Get_Range(Config_Key key, uint32_t *default_value, uint32_t *min, uint32_t *max)
+{
+    if (key >= CONFIG_NUM_KEYS) return -1;
+
+    if (default_value) *default_value = config_entries[key].default_value;
+    if (min) *min = config_entries[key].min;
+    if (max) *max = config_entries[key].max;
+
+    return 0;
+}
+
+int8_t Config_Set(Config_Key key, uint32_t value)
+{
+    if ((key >= CONFIG_NUM_KEYS) || (Config_Value_Valid(key, value) == 0)) return -1;
+
+    *Config_Field(key) = value;
+
+    return 0;
+}
+
+void Config_Reset_Defaults(void)
+{
+    for (uint8_t key = 0; key < CONFIG_NUM_KEYS; key++)
+    {
+        *Config_Field((Config_Key)key) = config_entries[key].default_value;
+    }
+}
+
+int8_t Config_Save(void)
+{
+    uint16_t changed = 0;
+    int8_t result = 0;
+
+    for (uint8_t key = 0; key < CONFIG_NUM_KEYS; key++)
+    {
+        if (*Config_Field((Config_Key)key) != config_stored[key]) changed++;
+    }
+
+    if (changed == 0) return 0;
+
+    Config_Unprotect();
+
+    if ((config_active_sector >= 0) && ((config_next_slot + changed) <= CONFIG_NUM_SLOTS))
+    {
+        // Append the changed settings to the active sector
+        for (uint8_t key = 0; (key < CONFIG_NUM_KEYS) && (result == 0); key++)
+        {
+            uint32_t value = *Config_Field((Config_Key)key);
+
+            if (value == config_stored[key]) continue;
+
+            result = Config_Append_Record(config_active_sector, config_next_slot, (Config_Key)key, value);
+
+            // A slot that failed is skipped when the records are loaded, so it is used in both cases
+            config_next_slot++;
+
+            if (result == 0) config_stored[key] = value;
+        }
+
+        // Move the settings to the other sector if a record could not be programmed
+        if (result != 0) result = Config_Compact();
+    }
+    else
+    {
+        // The active sector is full (or no sector is valid)
+        result = Config_Compact();
+    }
+
+    Config_Protect();
+
+    return result;
+}
@@ -36,6 +36,7 @@ those of the authors and should not be interpreted as representing official
 policies, either expressed or implied, of the FreeBSD Project.
  */
 #include <stdint.h>
+#include "../inc/Critical_Section.h"
 
 
 //*********** DisableInterrupts ***************
@@ -59,19 +60,18 @@ void EnableInterrupts(void){
 // make a copy of previous I bit, disable interrupts
 // inputs:  none
 // outputs: previous I bit
-void StartCritical(void){
-  __asm  ("    MRS    R0, PRIMASK   ; save old status \n"
-          "    CPSID  I             ; mask all (except faults)\n"
-          "    BX     LR\n");
+// The definition matches the prototype in CortexM.h, so the compiler knows that the value is returned.
+// New code should use the inline functions of Critical_Section.h.
+long StartCritical(void){
+  return (long)Critical_Section_Enter();
 }
 
 //*********** EndCritical ************************
 // using the copy of previous I bit, restore I bit to previous value
 // inputs:  previous I bit
 // outputs: none
-void EndCritical(void){
-  __asm  ("    MSR    PRIMASK, R0\n"
-          "    BX     LR\n");
+void EndCritical(long sr){
+  Critical_Section_Exit((uint32_t)sr);
 }
 
 //*********** WaitForInterrupt ************************
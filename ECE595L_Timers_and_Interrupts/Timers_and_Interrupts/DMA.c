@@ -0,0 +1,103 @@
+/**
+ * @file DMA.c
+ * @brief Source code for the DMA driver.
+ *
+ * This file contains the function definitions for the DMA driver.
+ * It owns the channel control table of the DMA controller and provides basic-mode
+ * transfers that are used by other drivers (e.g. the EUSCI_A0_UART transmit path).
+ *
+ * For more information regarding the DMA controller, refer to the DMA section (11)
+ * of the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/DMA.h"
+
+// Channel control structure (section 11.2.2.3)
+// The pointers are 32-bit on the target, so the structure has the layout of the device
+typedef struct
+{
+    volatile uintptr_t src_end;
+    volatile uintptr_t dst_end;
+    volatile uint32_t control;
+    volatile uint32_t unused;
+} DMA_Control_Structure;
+
+// Primary and alternate control structures for the 8 channels
+// The table must be aligned to its size (256 bytes)
+static DMA_Control_Structure DMA_Control_Table[2 * DMA_NUM_CHANNELS] __attribute__((aligned(256)));
+
+static uint8_t DMA_initialized = 0;
+
+void DMA_Init()
+{
+    if (DMA_initialized) return;
+
+    // Enable the DMA controller
+    DMA_Control->CFG = 0x01;
+
+    // Set the base address of the channel control table
+    DMA_Control->CTLBASE = (uintptr_t)DMA_Control_Table;
+
+    DMA_initialized = 1;
+}
+
+void DMA_Set_Channel_Source(uint8_t channel, uint8_t source)
+{
+    DMA_Channel->CH_SRCCFG[channel] = source;
+}
+
+void DMA_Start_Basic(uint8_t channel, const volatile void *src_end, volatile void *dst_end, uint32_t control, uint32_t count)
+{
+    DMA_Control_Table[channel].src_end = (uintptr_t)src_end;
+    DMA_Control_Table[channel].dst_end = (uintptr_t)dst_end;
+
+    // The N field holds the number of items minus one and starts at bit 4
+    DMA_Control_Table[channel].control = control | ((count - 1) << 4) | DMA_CTRL_MODE_BASIC;
+
+    // Use the primary control structure and enable the channel
+    DMA_Control->ALTCLR = (1 << channel);
+    DMA_Control->ENASET = (1 << channel);
+}
+
+void DMA_Start_Software(uint8_t channel, const volatile void *src_end, volatile void *dst_end, uint32_t control, uint32_t count)
+{
+    DMA_Control_Table[channel].src_end = (uintptr_t)src_end;
+    DMA_Control_Table[channel].dst_end = (uintptr_t)dst_end;
+
+    // Auto mode transfers all items after a single request, arbitrating after every 1024 items
+    DMA_Control_Table[channel].control = control | DMA_CTRL_ARBITRATE_1024 | ((count - 1) << 4) | DMA_CTRL_MODE_AUTO;
+
+    // Use the primary control structure and enable the channel
+    DMA_Control->ALTCLR = (1 << channel);
+    DMA_Control->ENASET = (1 << channel);
+
+    // Request the transfer by software (section 11.2.4)
+    DMA_Channel->SW_CHTRIG = (1 << channel);
+}
+
+uint8_t DMA_Channel_Busy(uint8_t channel)
+{
+    return ((DMA_Control->ENASET & (1 << channel)) != 0) ? 1 : 0;
+}
+
+void DMA_Set_Interrupt_Channel(uint8_t interrupt_number, uint8_t channel)
+{
+    // Bit 5 enables the interrupt, bits 2-0 select the channel
+    uint32_t config = 0x20 | channel;
+
+    switch(interrupt_number)
+    {
+        case 1: DMA_Channel->INT1_SRCCFG = config; break;
+        case 2: DMA_Channel->INT2_SRCCFG = config; break;
+        case 3: DMA_Channel->INT3_SRCCFG = config; break;
+        default: break;
+    }
+}
+
+void DMA_Clear_Interrupt_Flag(uint8_t channel)
+{
+    DMA_Channel->INT0_CLRFLG = (1 << channel);
+}
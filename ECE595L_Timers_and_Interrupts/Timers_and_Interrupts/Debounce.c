@@ -0,0 +1,277 @@
+/**
+ * @file Debounce.c
+ * @brief Source code for the Debounce driver.
+ *
+ * This file contains the function definitions for the Debounce driver.
+ * It debounces each GPIO interrupt pin of P4 (Bumper Sensors) and P6 (PMOD BTN) separately
+ * using one-shot compares of TIMER_A2.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Debounce.h"
+#include "../inc/Critical_Section.h"
+#include "../inc/IRQ.h"
+
+// Frequency of ACLK (sourced from REFOCLK by Clock_Init48MHz)
+#define DEBOUNCE_ACLK_FREQUENCY 32768
+
+typedef struct
+{
+    uint8_t pin_mask;
+    uint8_t pending;
+    uint8_t stable_state;
+    uint8_t both_edges;
+    Debounce_Change_Handler change_handler;
+    uint16_t window_counts[8];
+    uint16_t deadline[8];
+} Debounce_Port_State;
+
+static Debounce_Port_State debounce_ports[DEBOUNCE_NUM_PORTS];
+
+static uint8_t debounce_initialized = 0;
+
+// P4 and P6 are both even ports
+static DIO_PORT_Even_Interruptable_Type * const debounce_registers[DEBOUNCE_NUM_PORTS] = { P4, P6 };
+
+/**
+ * @brief Converts a window in ms to ACLK cycles.
+ */
+static uint16_t Debounce_Window_Counts(uint16_t window_ms)
+{
+    if (window_ms > DEBOUNCE_MAX_WINDOW_MS) window_ms = DEBOUNCE_MAX_WINDOW_MS;
+
+    return (uint16_t)(((uint32_t)window_ms * DEBOUNCE_ACLK_FREQUENCY) / 1000);
+}
+
+/**
+ * @brief Selects the edge that the pins wait for next, based on their current level.
+ *
+ * A high pin waits for a falling edge (IES = 1), and a low pin waits for a rising edge (IES = 0).
+ */
+static void Debounce_Select_Edge(DIO_PORT_Even_Interruptable_Type *registers, uint8_t pins, uint8_t level)
+{
+    registers->IES = (registers->IES & ~pins) | level;
+
+    // Writing IES can set the interrupt flags, so clear them
+    registers->IFG &= ~pins;
+
+    // If a pin changed before its new edge was selected, set its flag again so that the change is not lost
+    registers->IFG |= (registers->IN & pins) ^ level;
+}
+
+/**
+ * @brief Ends the windows that have expired and sets CCR1 to the earliest remaining deadline.
+ *
+ * This function is only called from handlers of the I/O tier (see IRQ_PRIORITY_DEBOUNCE), which cannot preempt each other.
+ */
+static void Debounce_Update(void)
+{
+    uint8_t waiting;
+
+    do
+    {
+        uint16_t now = TIMER_A2->R;
+        uint16_t earliest_remaining = 0xFFFF;
+        waiting = 0;
+
+        for (uint8_t port = 0; port < DEBOUNCE_NUM_PORTS; port++)
+        {
+            Debounce_Port_State *state = &debounce_ports[port];
+            DIO_PORT_Even_Interruptable_Type *registers = debounce_registers[port];
+
+            for (uint8_t pin = 0; pin < 8; pin++)
+            {
+                uint8_t bit = (1 << pin);
+
+                if ((state->pending & bit) == 0) continue;
+
+                int16_t remaining = (int16_t)(state->deadline[pin] - now);
+
+                if (remaining <= 0)
+                {
+                    // Re-sample the pin, drop the edges caused by bouncing, and enable the interrupt again
+                    uint8_t level = registers->IN & bit;
+                    uint8_t changed = (state->stable_state ^ level) & bit;
+                    state->stable_state = (state->stable_state & ~bit) | level;
+
+                    if (state->both_edges & bit)
+                    {
+                        Debounce_Select_Edge(registers, bit, level);
+                    }
+                    else
+                    {
+                        registers->IFG &= ~bit;
+                    }
+
+                    registers->IE |= bit;
+                    state->pending &= ~bit;
+
+                    // Report the change of level that happened during the window
+                    if (changed && (state->both_edges & bit) && state->change_handler)
+                    {
+                        (*state->change_handler)(bit, level);
+                    }
+                }
+                else
+                {
+                    waiting = 1;
+                    if ((uint16_t)remaining < earliest_remaining) earliest_remaining = (uint16_t)remaining;
+                }
+            }
+        }
+
+        if (waiting == 0)
+        {
+            TIMER_A2->CCTL[1] = 0;
+            return;
+        }
+
+        // Check again if the earliest deadline is too close to be caught by the compare
+        if (earliest_remaining > 2)
+        {
+            TIMER_A2->CCR[1] = now + earliest_remaining;
+            TIMER_A2->CCTL[1] = 0x0010;
+            return;
+        }
+    } while(waiting);
+}
+
+void Debounce_Init()
+{
+    if (debounce_initialized) return;
+
+    // Start TIMER_A2 in continuous mode from ACLK
+    TIMER_A2->CTL = 0x0104;
+    TIMER_A2->CCTL[1] = 0;
+    TIMER_A2->CTL = 0x0124;
+
+    // Set the priority of TA2_N (IRQ 13)
+    // It is in the same tier as PORT4_IRQHandler and PORT6_IRQHandler,
+    // since all three handlers modify the IE registers of P4 and P6
+    IRQ_Set_Priority(TA2_N_IRQn, IRQ_PRIORITY_DEBOUNCE);
+
+    // Enable Interrupt 13 in NVIC (section 2.4.3.1)
+    // Bit 13 corresponds to IRQ 13
+    NVIC->ISER[0] = 0x00002000;
+
+    debounce_initialized = 1;
+}
+
+void Debounce_Configure_Port(Debounce_Port port, uint8_t pin_mask, uint16_t window_ms)
+{
+    if (port >= DEBOUNCE_NUM_PORTS) return;
+
+    Debounce_Init();
+
+    debounce_ports[port].pin_mask = pin_mask;
+    debounce_ports[port].stable_state = debounce_registers[port]->IN & pin_mask;
+
+    for (uint8_t pin = 0; pin < 8; pin++)
+    {
+        if (pin_mask & (1 << pin))
+        {
+            Debounce_Set_Window(port, pin, window_ms);
+        }
+    }
+}
+
+void Debounce_Set_Window(Debounce_Port port, uint8_t pin, uint16_t window_ms)
+{
+    if ((port >= DEBOUNCE_NUM_PORTS) || (pin > 7)) return;
+
+    debounce_ports[port].window_counts[pin] = Debounce_Window_Counts(window_ms);
+}
+
+uint16_t Debounce_Get_Window(Debounce_Port port, uint8_t pin)
+{
+    if ((port >= DEBOUNCE_NUM_PORTS) || (pin > 7)) return 0;
+
+    return (uint16_t)(((uint32_t)debounce_ports[port].window_counts[pin] * 1000) / DEBOUNCE_ACLK_FREQUENCY);
+}
+
+void Debounce_Set_Both_Edges(Debounce_Port port, uint8_t pins, Debounce_Change_Handler handler)
+{
+    if (port >= DEBOUNCE_NUM_PORTS) return;
+
+    Debounce_Port_State *state = &debounce_ports[port];
+    DIO_PORT_Even_Interruptable_Type *registers = debounce_registers[port];
+
+    // The port interrupt handler and TA2_N_IRQHandler also use the IES and IFG registers
+    uint32_t sr = Critical_Section_Enter();
+
+    pins &= state->pin_mask;
+
+    uint8_t added = pins & ~state->both_edges;
+
+    state->both_edges = pins;
+    state->change_handler = handler;
+
+    if (added)
+    {
+        uint8_t level = registers->IN & added;
+        state->stable_state = (state->stable_state & ~added) | level;
+        Debounce_Select_Edge(registers, added, level);
+    }
+
+    Critical_Section_Exit(sr);
+}
+
+uint8_t Debounce_Edge(Debounce_Port port, uint8_t pins)
+{
+    Debounce_Port_State *state = &debounce_ports[port];
+    DIO_PORT_Even_Interruptable_Type *registers = debounce_registers[port];
+    uint16_t now = TIMER_A2->R;
+    uint8_t started = 0;
+
+    pins &= state->pin_mask;
+
+    // Sample the new level of the pins
+    uint8_t level = registers->IN & pins;
+    state->stable_state = (state->stable_state & ~pins) | level;
+
+    // Wait for the opposite edge of the pins that report both edges
+    if (pins & state->both_edges)
+    {
+        Debounce_Select_Edge(registers, pins & state->both_edges, level & state->both_edges);
+    }
+
+    for (uint8_t pin = 0; pin < 8; pin++)
+    {
+        uint8_t bit = (1 << pin);
+
+        if (((pins & bit) == 0) || (state->window_counts[pin] == 0)) continue;
+
+        state->deadline[pin] = now + state->window_counts[pin];
+        state->pending |= bit;
+        started |= bit;
+    }
+
+    if (started)
+    {
+        // Disable the interrupts of the pins until their windows expire
+        registers->IE &= ~started;
+        Debounce_Update();
+    }
+
+    return level;
+}
+
+uint8_t Debounce_Get_Pending(Debounce_Port port)
+{
+    return (port < DEBOUNCE_NUM_PORTS) ? debounce_ports[port].pending : 0;
+}
+
+uint8_t Debounce_Get_Stable_State(Debounce_Port port)
+{
+    return (port < DEBOUNCE_NUM_PORTS) ? debounce_ports[port].stable_state : 0;
+}
+
+void TA2_N_IRQHandler(void)
+{
+    // Reading TA2IV clears the highest pending flag (CCR1)
+    (void)TIMER_A2->IV;
+
+    Debounce_Update();
+}
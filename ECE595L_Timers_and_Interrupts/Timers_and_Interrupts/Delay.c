@@ -0,0 +1,84 @@
+/**
+ * @file Delay.c
+ * @brief Source code for the Delay driver.
+ *
+ * This file contains the function definitions for the Delay driver.
+ * It uses the DWT cycle counter (CYCCNT) of the Cortex-M4 for busy-wait delays,
+ * and the Time driver with WFI for the delays that sleep.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Delay.h"
+#include "../inc/Clock.h"
+#include "../inc/CortexM_Inline.h"
+#include "../inc/SysTick_Interrupt.h"
+#include "../inc/Time.h"
+
+volatile uint32_t Delay_Cycles_Per_Us = 3;
+
+// Function called by Delay_Wait_Us after each wake-up, or 0
+static void (*delay_yield_handler)(void) = 0;
+
+/**
+ * @brief Updates the number of cycles per microsecond after a clock profile switch.
+ */
+static void Delay_Clock_Changed(uint32_t previous_mclk, uint32_t previous_smclk)
+{
+    Delay_Cycles_Per_Us = Clock_GetFreq() / 1000000;
+}
+
+void Delay_Init(void)
+{
+    // Enable the DWT unit (TRCENA in DEMCR)
+    CoreDebug->DEMCR |= 0x01000000;
+
+    // Enable the cycle counter without clearing it
+    DWT->CTRL |= 0x00000001;
+
+    Delay_Cycles_Per_Us = Clock_GetFreq() / 1000000;
+    Clock_AddChangeHandler(&Delay_Clock_Changed);
+}
+
+void Delay_Ms(uint32_t ms)
+{
+    // Wait 1 ms at a time, so that the number of cycles never overflows
+    while (ms)
+    {
+        Delay_Us(1000);
+        ms--;
+    }
+}
+
+void Delay_Set_Yield_Handler(void (*handler)(void))
+{
+    delay_yield_handler = handler;
+}
+
+void Delay_Wait_Us(uint64_t us)
+{
+    uint64_t deadline = Time_NowUs() + us;
+
+    // Sleep while more than one SysTick period is left, since a wake-up can take up to one period
+    uint32_t tick_us = SysTick_Interrupt_Get_Cycles_Per_Tick() / Delay_Cycles_Per_Us;
+    uint64_t now = Time_NowUs();
+
+    while ((now < deadline) && ((deadline - now) > tick_us))
+    {
+        CortexM_Sleep();
+
+        if (delay_yield_handler)
+        {
+            (*delay_yield_handler)();
+        }
+
+        now = Time_NowUs();
+    }
+
+    // Busy-wait for the rest of the delay
+    if (deadline > now)
+    {
+        Delay_Us((uint32_t)(deadline - now));
+    }
+}
@@ -14,6 +14,106 @@
  */
 
 #include "../inc/EUSCI_A0_UART.h"
+#include "../inc/Clock.h"
+#include "../inc/Critical_Section.h"
+#include "../inc/IRQ.h"
+#include "../inc/DMA.h"
+#include "../inc/ISR_Profiler.h"
+#include "../inc/Format.h"
+#include "../inc/RAM_Function.h"
+
+// Mask used to wrap the transmit ring buffer indices
+#define EUSCI_A0_UART_TX_BUFFER_MASK (EUSCI_A0_UART_TX_BUFFER_SIZE - 1)
+
+// Transmit ring buffer used by the interrupt-driven TX modes
+// tx_head is only written by the producer (OutChar), tx_tail is only written by the consumer (TX_Service)
+static char tx_buffer[EUSCI_A0_UART_TX_BUFFER_SIZE];
+static volatile uint32_t tx_head = 0;
+static volatile uint32_t tx_tail = 0;
+
+// Number of characters dropped because the transmit ring buffer was full
+static volatile uint32_t tx_overflow_count = 0;
+
+// Current transmit mode (see EUSCI_A0_UART_Set_TX_Mode)
+static volatile EUSCI_A0_UART_TX_Mode tx_mode = EUSCI_A0_UART_TX_MODE_POLLED;
+
+// Mask used to wrap the receive ring buffer indices
+#define EUSCI_A0_UART_RX_BUFFER_MASK (EUSCI_A0_UART_RX_BUFFER_SIZE - 1)
+
+// Receive ring buffer filled by EUSCIA0_IRQHandler
+// rx_head is only written by the producer (EUSCIA0_IRQHandler), rx_tail is only written by the consumer (InChar and RX_Read)
+static char rx_buffer[EUSCI_A0_UART_RX_BUFFER_SIZE];
+static volatile uint32_t rx_head = 0;
+static volatile uint32_t rx_tail = 0;
+
+// Number of characters dropped because the receive ring buffer was full
+static volatile uint32_t rx_overflow_count = 0;
+
+// DMA channel 0 is triggered by EUSCI_A0 TX when source 1 is selected
+#define EUSCI_A0_UART_DMA_CHANNEL   0
+#define EUSCI_A0_UART_DMA_SOURCE    1
+
+// Transfers queued by EUSCI_A0_UART_WriteAsync
+// dma_write_index is only written by WriteAsync, dma_read_index is only written by DMA_INT1_IRQHandler
+typedef struct
+{
+    const char *buf;
+    unsigned count;
+    void (*callback)(const char *buf);
+} EUSCI_A0_UART_DMA_Transfer;
+
+static EUSCI_A0_UART_DMA_Transfer dma_queue[EUSCI_A0_UART_DMA_QUEUE_SIZE];
+static volatile uint32_t dma_write_index = 0;
+static volatile uint32_t dma_read_index = 0;
+
+// Set while DMA channel 0 owns TXBUF
+static volatile uint8_t dma_active = 0;
+
+/**
+ * @brief Moves one character from the transmit ring buffer to TXBUF if the transmitter is ready.
+ *
+ * The check of TXIFG, the write to TXBUF, and the update of tx_tail are done with the interrupts of priority
+ * EUSCI_A0_UART_INT_PRIORITY and lower masked (BASEPRI), so that EUSCIA0_IRQHandler and a producer waiting in EUSCI_A0_UART_TX_MODE_RING_BLOCK can both
+ * drain the buffer without sending a character twice.
+ *
+ * Nothing is written while DMA channel 0 owns TXBUF, since TXIFG is the trigger of the DMA transfer:
+ * a character written by the CPU would be sent in the middle of the transfer and would clear the edge that the DMA waits for.
+ * The ring buffer is sent by EUSCIA0_IRQHandler once DMA_INT1_IRQHandler has completed the transfer.
+ *
+ * @return None
+ */
+static void EUSCI_A0_UART_TX_Service(void)
+{
+    uint32_t sr = Critical_Section_Enter_Priority(EUSCI_A0_UART_INT_PRIORITY);
+
+    // dma_active is only changed by handlers of the same priority, which are masked here
+    if ((dma_active == 0) && (EUSCI_A0->IFG & 0x02) && (tx_tail != tx_head))
+    {
+        EUSCI_A0->TXBUF = tx_buffer[tx_tail & EUSCI_A0_UART_TX_BUFFER_MASK];
+        tx_tail++;
+    }
+
+    Critical_Section_Exit_Priority(sr);
+}
+
+/**
+ * @brief Recomputes the baud rate divider after a clock profile switch that changed SMCLK.
+ *
+ * The divider can only be written while the module is in reset, which clears the interrupt enable bits,
+ * so they are saved and restored.
+ */
+static void EUSCI_A0_UART_Clock_Changed(uint32_t previous_mclk, uint32_t previous_smclk)
+{
+    if (Clock_GetSMCLKFreq() == previous_smclk) return;
+
+    uint16_t interrupt_enable = EUSCI_A0->IE;
+
+    EUSCI_A0->CTLW0 |= 1;
+    EUSCI_A0->BRW = (uint16_t)(Clock_GetSMCLKFreq() / EUSCI_A0_UART_BAUD_RATE);
+    EUSCI_A0->CTLW0 &= ~1;
+
+    EUSCI_A0->IE = interrupt_enable;
+}
 
 void EUSCI_A0_UART_Init()
 {
@@ -30,7 +130,7 @@ void EUSCI_A0_UART_Init()
     // Set the baud rate
     // N = (Clock Frequency) / (Baud Rate) = (12,000,000 / 115,200) = 104.1667
     // Use only the integer part, so N = 104
-    EUSCI_A0->BRW |= 104;
+    EUSCI_A0->BRW = (uint16_t)(Clock_GetSMCLKFreq() / EUSCI_A0_UART_BAUD_RATE);
 
     // Configure P1.2 and P1.3 as primary module function
     P1->SEL0 |= 0x0C;
@@ -45,20 +145,357 @@ void EUSCI_A0_UART_Init()
     // - Start Bit Interrupt
     // - Transmit Complete Interrupt
     EUSCI_A0->IE &= ~0xF;
+
+    // Empty the receive ring buffer and enable the Receive Interrupt
+    // The received characters are copied to the receive ring buffer by EUSCIA0_IRQHandler
+    rx_tail = rx_head;
+    EUSCI_A0->IE |= 0x01;
+
+    // Set the priority of the EUSCI_A0 interrupt (IRQ 16)
+    IRQ_Set_Priority(EUSCIA0_IRQn, EUSCI_A0_UART_INT_PRIORITY);
+
+    // Enable Interrupt 16 in NVIC (section 2.4.3.1)
+    // Bit 16 corresponds to IRQ 16
+    NVIC->ISER[0] = 0x00010000;
+
+    // Recompute the baud rate when SMCLK changes
+    Clock_AddChangeHandler(&EUSCI_A0_UART_Clock_Changed);
+}
+
+void EUSCI_A0_UART_Set_TX_Mode(EUSCI_A0_UART_TX_Mode mode)
+{
+    // Let the transmit ring buffer drain before switching back to polled mode
+    // so that queued characters are not sent out of order
+    if (mode == EUSCI_A0_UART_TX_MODE_POLLED)
+    {
+        EUSCI_A0_UART_TX_Flush();
+    }
+
+    tx_mode = mode;
+}
+
+EUSCI_A0_UART_TX_Mode EUSCI_A0_UART_Get_TX_Mode()
+{
+    return tx_mode;
+}
+
+void EUSCI_A0_UART_TX_Flush()
+{
+    // Wait for the transfers queued by EUSCI_A0_UART_WriteAsync, so the ring buffer is sent in the order
+    // chosen by EUSCIA0_IRQHandler and TX_Service does not wait for DMA channel 0 to release TXBUF
+    while(dma_read_index != dma_write_index);
+
+    while(tx_tail != tx_head)
+    {
+        EUSCI_A0_UART_TX_Service();
+    }
+}
+
+uint8_t EUSCI_A0_UART_TX_Busy()
+{
+    // Check the ring buffer, the DMA queue, and the UCBUSY bit
+    if ((tx_tail != tx_head) || (dma_read_index != dma_write_index) || (EUSCI_A0->STATW & 0x01))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+uint32_t EUSCI_A0_UART_TX_Overflow_Count()
+{
+    return tx_overflow_count;
+}
+
+/**
+ * @brief Starts the DMA transfer at the front of the queue.
+ *
+ * This function is only called from EUSCIA0_IRQHandler, which has the same priority as DMA_INT1_IRQHandler.
+ *
+ * @return None
+ */
+static void EUSCI_A0_UART_DMA_Start(void)
+{
+    const EUSCI_A0_UART_DMA_Transfer *transfer = &dma_queue[dma_read_index % EUSCI_A0_UART_DMA_QUEUE_SIZE];
+
+    dma_active = 1;
+
+    DMA_Start_Basic(EUSCI_A0_UART_DMA_CHANNEL,
+                    &transfer->buf[transfer->count - 1],
+                    &EUSCI_A0->TXBUF,
+                    DMA_CTRL_DST_INC_NONE | DMA_CTRL_SRC_INC_BYTE | DMA_CTRL_SIZE_8,
+                    transfer->count);
+
+    // The DMA is triggered by a rising edge of TXIFG, which is already set when the transmitter is idle
+    // Clear and set TXIFG again to request the first transfer
+    EUSCI_A0->IFG &= ~0x02;
+    EUSCI_A0->IFG |= 0x02;
+}
+
+/**
+ * @brief Handles the receive interrupt of EUSCI_A0 (see EUSCIA0_IRQHandler).
+ *
+ * @return None
+ */
+static void EUSCI_A0_UART_RX_Interrupt(void)
+{
+    // Reading RXBUF clears RXIFG
+    if (EUSCI_A0->IFG & 0x01)
+    {
+        char character = (char)(EUSCI_A0->RXBUF);
+        uint32_t head = rx_head;
+
+        if ((head - rx_tail) >= EUSCI_A0_UART_RX_BUFFER_SIZE)
+        {
+            rx_overflow_count++;
+            return;
+        }
+
+        rx_buffer[head & EUSCI_A0_UART_RX_BUFFER_MASK] = character;
+        rx_head = head + 1;
+    }
+}
+
+/**
+ * @brief Handles the transmit interrupt of EUSCI_A0 (see EUSCIA0_IRQHandler).
+ *
+ * @return None
+ */
+static void EUSCI_A0_UART_TX_Interrupt(void)
+{
+    // Only service the transmitter when the transmit interrupt is enabled and pending
+    if (EUSCI_A0->IFG & EUSCI_A0->IE & 0x02)
+    {
+        // DMA_INT1_IRQHandler enables the transmit interrupt again when the DMA transfer is complete
+        if (dma_active)
+        {
+            EUSCI_A0->IE &= ~0x02;
+            return;
+        }
+
+        // Characters in the ring buffer are sent before the next DMA transfer is started
+        if (tx_tail != tx_head)
+        {
+            EUSCI_A0_UART_TX_Service();
+            return;
+        }
+
+        // Disable the transmit interrupt once the ring buffer is empty
+        EUSCI_A0->IE &= ~0x02;
+
+        if (dma_read_index != dma_write_index)
+        {
+            EUSCI_A0_UART_DMA_Start();
+        }
+        // A producer may have added a character between the check above and clearing TXIE
+        else if (tx_tail != tx_head)
+        {
+            EUSCI_A0->IE |= 0x02;
+        }
+    }
+}
+
+RAM_FUNCTION void EUSCIA0_IRQHandler(void)
+{
+    ISR_PROFILER_ENTER();
+
+    EUSCI_A0_UART_RX_Interrupt();
+
+    EUSCI_A0_UART_TX_Interrupt();
+
+    ISR_PROFILER_EXIT(ISR_PROFILER_EUSCIA0);
+}
+
+void EUSCI_A0_UART_DMA_Init()
+{
+    DMA_Init();
+
+    // Select EUSCI_A0 TX as the trigger source for channel 0
+    DMA_Set_Channel_Source(EUSCI_A0_UART_DMA_CHANNEL, EUSCI_A0_UART_DMA_SOURCE);
+
+    // Route the completion interrupt of channel 0 to DMA_INT1
+    DMA_Set_Interrupt_Channel(1, EUSCI_A0_UART_DMA_CHANNEL);
+    DMA_Clear_Interrupt_Flag(EUSCI_A0_UART_DMA_CHANNEL);
+
+    // Set the priority of DMA_INT1 (IRQ 33) to the same tier as EUSCIA0_IRQHandler
+    // so that the two handlers cannot preempt each other
+    IRQ_Set_Priority(DMA_INT1_IRQn, IRQ_PRIORITY_UART_DMA);
+
+    // Enable Interrupt 33 in NVIC (section 2.4.3.2)
+    // Bit 1 corresponds to IRQ 33
+    NVIC->ISER[1] = 0x00000002;
+}
+
+int EUSCI_A0_UART_WriteAsync(const char *buf, unsigned count, void (*callback)(const char *buf))
+{
+    uint32_t write_index = dma_write_index;
+
+    if ((count == 0) || (count > DMA_MAX_TRANSFER_SIZE)) return -1;
+
+    // Return if both buffers are still queued or being sent
+    if ((write_index - dma_read_index) >= EUSCI_A0_UART_DMA_QUEUE_SIZE) return -1;
+
+    EUSCI_A0_UART_DMA_Transfer *transfer = &dma_queue[write_index % EUSCI_A0_UART_DMA_QUEUE_SIZE];
+    transfer->buf = buf;
+    transfer->count = count;
+    transfer->callback = callback;
+    dma_write_index = write_index + 1;
+
+    // Let EUSCIA0_IRQHandler start the transfer once the transmitter is free
+    EUSCI_A0->IE |= 0x02;
+
+    return 0;
+}
+
+uint32_t EUSCI_A0_UART_DMA_Pending()
+{
+    return (dma_write_index - dma_read_index);
+}
+
+void DMA_INT1_IRQHandler(void)
+{
+    const EUSCI_A0_UART_DMA_Transfer *transfer = &dma_queue[dma_read_index % EUSCI_A0_UART_DMA_QUEUE_SIZE];
+
+    DMA_Clear_Interrupt_Flag(EUSCI_A0_UART_DMA_CHANNEL);
+
+    dma_active = 0;
+
+    // Notify the application that the buffer can be filled again
+    if (transfer->callback)
+    {
+        (*transfer->callback)(transfer->buf);
+    }
+    dma_read_index++;
+
+    // Let EUSCIA0_IRQHandler send the ring buffer or start the next DMA transfer
+    EUSCI_A0->IE |= 0x02;
 }
 
 char EUSCI_A0_UART_InChar()
 {
-  while((EUSCI_A0->IFG&0x01) == 0);
+    char character;
+
+    while(EUSCI_A0_UART_RX_Read(&character) == 0);
+
+    return character;
+}
+
+uint8_t EUSCI_A0_UART_RX_Read(char *character)
+{
+    uint32_t tail = rx_tail;
+
+    if (tail == rx_head) return 0;
+
+    *character = rx_buffer[tail & EUSCI_A0_UART_RX_BUFFER_MASK];
+    rx_tail = tail + 1;
+
+    return 1;
+}
+
+uint32_t EUSCI_A0_UART_RX_Available()
+{
+    return (rx_head - rx_tail);
+}
+
+uint32_t EUSCI_A0_UART_RX_Overflow_Count()
+{
+    return rx_overflow_count;
+}
+
+void EUSCI_A0_UART_Set_RX_Enable(uint8_t enable)
+{
+    if (enable)
+    {
+        // Discard a character received while the interrupt was disabled, and enable the Receive Interrupt
+        EUSCI_A0->IFG &= ~0x01;
+        EUSCI_A0->IE |= 0x01;
+    }
+    else
+    {
+        EUSCI_A0->IE &= ~0x01;
+    }
+}
+
+uint8_t EUSCI_A0_UART_RX_Enabled()
+{
+    return (EUSCI_A0->IE & 0x01) ? 1 : 0;
+}
+
+void EUSCI_A0_UART_Line_Init(EUSCI_A0_UART_Line *line, char *buffer, uint16_t max)
+{
+    line->buffer = buffer;
+    line->max = max;
+    line->length = 0;
+    line->buffer[0] = 0;
+}
+
+uint8_t EUSCI_A0_UART_Line_Poll(EUSCI_A0_UART_Line *line)
+{
+    char character;
 
-  return((char)(EUSCI_A0->RXBUF));
+    // Process the received characters in the same way as EUSCI_A0_UART_InString, without waiting for more characters
+    while(EUSCI_A0_UART_RX_Read(&character))
+    {
+        if (character == CR)
+        {
+            line->buffer[line->length] = 0;
+            line->length = 0;
+            return 1;
+        }
+        else if ((character == BS) || (character == DEL))
+        {
+            if (line->length)
+            {
+                line->length--;
+                EUSCI_A0_UART_OutChar(BS);
+            }
+        }
+        else if ((character != LF) && (line->length < line->max))
+        {
+            line->buffer[line->length] = character;
+            line->length++;
+            EUSCI_A0_UART_OutChar(character);
+        }
+    }
+
+    return 0;
 }
 
 void EUSCI_A0_UART_OutChar(char letter)
 {
-  while((EUSCI_A0->IFG&0x02) == 0);
+    if (tx_mode == EUSCI_A0_UART_TX_MODE_POLLED)
+    {
+        // Wait for the transfers queued by EUSCI_A0_UART_WriteAsync to complete
+        // This requires DMA_INT1_IRQHandler and EUSCIA0_IRQHandler to run (see EUSCI_A0_UART.h)
+        while(dma_read_index != dma_write_index);
+
+        while((EUSCI_A0->IFG&0x02) == 0);
+
+        EUSCI_A0->TXBUF = letter;
+        return;
+    }
+
+    uint32_t head = tx_head;
+
+    // Wait for space or drop the character when the ring buffer is full
+    while((head - tx_tail) >= EUSCI_A0_UART_TX_BUFFER_SIZE)
+    {
+        if (tx_mode == EUSCI_A0_UART_TX_MODE_RING_DROP)
+        {
+            tx_overflow_count++;
+            return;
+        }
+
+        // Drain the ring buffer directly in case the caller has a higher priority than EUSCIA0_IRQHandler
+        // TX_Service does not write TXBUF while a DMA transfer is in progress
+        EUSCI_A0_UART_TX_Service();
+    }
 
-  EUSCI_A0->TXBUF = letter;
+    tx_buffer[head & EUSCI_A0_UART_TX_BUFFER_MASK] = letter;
+    tx_head = head + 1;
+
+    // Enable the transmit interrupt. TXIFG is already set when the transmitter is idle,
+    // so this starts the transfer immediately
+    EUSCI_A0->IE |= 0x02;
 }
 
 void EUSCI_A0_UART_InString(char *bufPt, uint16_t max)
@@ -131,32 +568,27 @@ uint32_t EUSCI_A0_UART_InUDec()
 
 void EUSCI_A0_UART_OutUDec(uint32_t n)
 {
-    if (n >= 10)
-    {
-        EUSCI_A0_UART_OutUDec(n/10);
-        n = n%10;
-    }
-    EUSCI_A0_UART_OutChar(n + '0'); /* n is between 0 and 9 */
+    char text[FORMAT_UDEC_SIZE];
+
+    FORMAT_UDEC(text, n);
+    EUSCI_A0_UART_OutString(text);
 }
 
 void EUSCI_A0_UART_OutSDec(int32_t n)
 {
-    if (n < 0)
-    {
-        EUSCI_A0_UART_OutChar('-');
-        EUSCI_A0_UART_OutUDec(-n);
-    }
-    else
-    {
-        EUSCI_A0_UART_OutUDec(n);
-    }
+    char text[FORMAT_SDEC_SIZE];
+
+    FORMAT_SDEC(text, n);
+    EUSCI_A0_UART_OutString(text);
 }
 
 void EUSCI_A0_UART_OutUFix(uint32_t n)
 {
-    EUSCI_A0_UART_OutUDec(n/10);
-    EUSCI_A0_UART_OutChar('.');
-    EUSCI_A0_UART_OutUDec(n%10);
+    char text[FORMAT_UFIX_SIZE];
+
+    // One decimal place, e.g. 123 is sent as "12.3"
+    FORMAT_UFIX(text, n, 1);
+    EUSCI_A0_UART_OutString(text);
 }
 
 uint32_t UART0_InUHex()
@@ -204,24 +636,18 @@ uint32_t UART0_InUHex()
 
 void EUSCI_A0_UART_OutUHex(uint32_t number)
 {
-    // Use recursion to convert the number of
-    // unspecified length as an ASCII string
-    if (number >= 0x10)
-    {
-        EUSCI_A0_UART_OutUHex(number/0x10);
-        EUSCI_A0_UART_OutUHex(number%0x10);
-    }
-    else
-    {
-        if (number < 0xA)
-        {
-            EUSCI_A0_UART_OutChar(number+'0');
-        }
-        else
-        {
-            EUSCI_A0_UART_OutChar((number-0x0A)+'A');
-        }
-    }
+    char text[FORMAT_UHEX_SIZE];
+
+    FORMAT_UHEX(text, number);
+    EUSCI_A0_UART_OutString(text);
+}
+
+void EUSCI_A0_UART_OutUHex_Width(uint32_t number, uint8_t width)
+{
+    char text[FORMAT_UHEX_SIZE];
+
+    Format_UHex(text, number, (width > 8) ? 8 : width);
+    EUSCI_A0_UART_OutString(text);
 }
 
 int EUSCI_A0_UART_Open(const char *path, unsigned flags, int llv_fd)
@@ -240,7 +666,7 @@ int EUSCI_A0_UART_Read(int dev_fd, char *buf, unsigned count)
     // Receive char from the serial terminal
     ch = EUSCI_A0_UART_InChar();
     // Return by reference
-    ch = *buf;
+    *buf = ch;
     // Output the received char from the serial terminal
     EUSCI_A0_UART_OutChar(ch);
     return 1;
@@ -306,4 +732,7 @@ void EUSCI_A0_UART_Init_Printf()
 
     // Turn off buffering for stdout
     setvbuf(stdout, NULL, _IONBF, 0);
+
+    // Select the transmit mode used by printf
+    EUSCI_A0_UART_Set_TX_Mode(EUSCI_A0_UART_TX_MODE_DEFAULT);
 }
@@ -0,0 +1,192 @@
+/**
+ * @file Event_Queue.c
+ * @brief Source code for the Event_Queue driver.
+ *
+ * This file contains the function definitions for the Event_Queue driver.
+ * Interrupt handlers push a small record for each event into a lock-free queue, and the
+ * main loop drains the queue and calls the handlers subscribed to the event source.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Event_Queue.h"
+#include "../inc/SysTick_Interrupt.h"
+
+// Only keep the warnings of this module
+#define TRACE_MODULE_LEVEL TRACE_LEVEL_WARN
+#include "../inc/Trace.h"
+
+// Mask used to wrap the queue indices
+#define EVENT_QUEUE_MASK (EVENT_QUEUE_SIZE - 1)
+
+// event_head is only written by Event_Queue_Push, event_tail is only written by Event_Queue_Pop
+static Event event_queue[EVENT_QUEUE_SIZE];
+static volatile uint32_t event_head = 0;
+static volatile uint32_t event_tail = 0;
+
+static volatile uint32_t event_overflow_count = 0;
+
+// Run-time subscribers of each event source
+typedef struct
+{
+    uint8_t pin_mask;
+    Event_Handler handler;
+} Event_Subscription;
+
+static Event_Subscription event_subscribers[EVENT_NUM_SOURCES][EVENT_MAX_SUBSCRIBERS];
+static uint8_t event_subscriber_count[EVENT_NUM_SOURCES];
+
+// Constant table of subscribers registered with Event_Queue_Register_Static_Table
+static const Event_Subscriber *event_static_table = 0;
+static uint8_t event_static_count = 0;
+
+// Timestamp, pins and levels of the event that is being dispatched
+static uint32_t event_current_timestamp = 0;
+static uint8_t event_current_pins = 0;
+static uint8_t event_current_levels = 0;
+
+int8_t Event_Queue_Subscribe(Event_Source source, uint8_t pin_mask, Event_Handler handler)
+{
+    if ((source >= EVENT_NUM_SOURCES) || (handler == 0)) return -1;
+
+    uint8_t count = event_subscriber_count[source];
+
+    if (count >= EVENT_MAX_SUBSCRIBERS) return -1;
+
+    event_subscribers[source][count].pin_mask = pin_mask;
+    event_subscribers[source][count].handler = handler;
+    event_subscriber_count[source] = count + 1;
+
+    return 0;
+}
+
+void Event_Queue_Unsubscribe(Event_Source source, Event_Handler handler)
+{
+    if (source >= EVENT_NUM_SOURCES) return;
+
+    uint8_t count = event_subscriber_count[source];
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (event_subscribers[source][i].handler == handler)
+        {
+            // Keep the order of the remaining subscribers
+            for (; i < (count - 1); i++)
+            {
+                event_subscribers[source][i] = event_subscribers[source][i + 1];
+            }
+            event_subscriber_count[source] = count - 1;
+            return;
+        }
+    }
+}
+
+void Event_Queue_Register_Static_Table(const Event_Subscriber *table, uint8_t count)
+{
+    event_static_table = table;
+    event_static_count = (table) ? count : 0;
+}
+
+uint8_t Event_Queue_Push(Event_Source source, uint8_t pins, uint8_t levels, uint8_t state)
+{
+    uint32_t head = event_head;
+
+    if ((head - event_tail) >= EVENT_QUEUE_SIZE)
+    {
+        event_overflow_count++;
+        TRACE_WARN(TRACE_FMT_EVENT_QUEUE_OVERFLOW, source, event_overflow_count);
+        return 0;
+    }
+
+    Event *event = &event_queue[head & EVENT_QUEUE_MASK];
+    event->source = source;
+    event->pins = pins;
+    event->levels = levels;
+    event->state = state;
+    event->timestamp = SysTick_Interrupt_Get_Ticks();
+
+    // Publish the event only after the record has been written
+    event_head = head + 1;
+
+    return 1;
+}
+
+uint8_t Event_Queue_Pop(Event *event)
+{
+    uint32_t tail = event_tail;
+
+    if (tail == event_head) return 0;
+
+    *event = event_queue[tail & EVENT_QUEUE_MASK];
+    event_tail = tail + 1;
+
+    return 1;
+}
+
+uint8_t Event_Queue_Is_Empty()
+{
+    return (event_tail == event_head) ? 1 : 0;
+}
+
+uint32_t Event_Queue_Dispatch()
+{
+    Event event;
+    uint32_t count = 0;
+
+    while(Event_Queue_Pop(&event))
+    {
+        count++;
+
+        if (event.source >= EVENT_NUM_SOURCES) continue;
+
+        event_current_timestamp = event.timestamp;
+        event_current_pins = event.pins;
+        event_current_levels = event.levels;
+
+        // Call the subscribers of the static table whose pin mask matches the event
+        for (uint8_t i = 0; i < event_static_count; i++)
+        {
+            const Event_Subscriber *subscriber = &event_static_table[i];
+
+            if ((subscriber->source == event.source) && (subscriber->pin_mask & event.pins) && subscriber->handler)
+            {
+                (*subscriber->handler)(event.state);
+            }
+        }
+
+        // Then call the run-time subscribers
+        // A handler may unsubscribe itself, so the count is read on each iteration
+        for (uint8_t i = 0; i < event_subscriber_count[event.source]; i++)
+        {
+            const Event_Subscription *subscription = &event_subscribers[event.source][i];
+
+            if (subscription->pin_mask & event.pins)
+            {
+                (*subscription->handler)(event.state);
+            }
+        }
+    }
+
+    return count;
+}
+
+uint32_t Event_Queue_Get_Timestamp()
+{
+    return event_current_timestamp;
+}
+
+uint8_t Event_Queue_Get_Pins()
+{
+    return event_current_pins;
+}
+
+uint8_t Event_Queue_Get_Levels()
+{
+    return event_current_levels;
+}
+
+uint32_t Event_Queue_Overflow_Count()
+{
+    return event_overflow_count;
+}
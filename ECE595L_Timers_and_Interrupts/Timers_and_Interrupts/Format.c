@@ -0,0 +1,117 @@
+/**
+ * @file Format.c
+ * @brief Source code for the Format driver.
+ *
+ * This file contains the function definitions for the Format driver.
+ * It converts integers to text in a buffer provided by the caller.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Format.h"
+
+static const char format_hex_digits[16] = "0123456789ABCDEF";
+
+/**
+ * @brief Returns n / 10 for any 32-bit value.
+ *
+ * 0xCCCCCCCD / 2^35 is slightly larger than 1/10, and the error is too small to change the result for 32-bit values.
+ * The 32 x 32 -> 64-bit multiplication is a single UMULL instruction on the Cortex-M4.
+ */
+static inline uint32_t Format_Div10(uint32_t n)
+{
+    return (uint32_t)(((uint64_t)n * 0xCCCCCCCDu) >> 35);
+}
+
+/**
+ * @brief Writes the decimal digits of n in reverse order and returns the number of digits.
+ *
+ * At least 'min_digits' digits are written, using leading zeros.
+ */
+static uint8_t Format_Reverse_Digits(char *digits, uint32_t n, uint8_t min_digits)
+{
+    uint8_t count = 0;
+
+    do
+    {
+        uint32_t quotient = Format_Div10(n);
+        digits[count++] = (char)('0' + (n - (quotient * 10)));
+        n = quotient;
+    } while (n || (count < min_digits));
+
+    return count;
+}
+
+uint8_t Format_UDec(char *buffer, uint32_t n)
+{
+    char digits[10];
+    uint8_t count = Format_Reverse_Digits(digits, n, 1);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        buffer[i] = digits[count - 1 - i];
+    }
+    buffer[count] = 0;
+
+    return count;
+}
+
+uint8_t Format_SDec(char *buffer, int32_t n)
+{
+    if (n < 0)
+    {
+        buffer[0] = '-';
+
+        // Negate as unsigned so that -2147483648 is converted correctly
+        return 1 + Format_UDec(&buffer[1], (uint32_t)0 - (uint32_t)n);
+    }
+
+    return Format_UDec(buffer, (uint32_t)n);
+}
+
+uint8_t Format_UHex(char *buffer, uint32_t n, uint8_t width)
+{
+    if (width > 8) width = 8;
+
+    // Count the significant digits when no width is specified
+    if (width == 0)
+    {
+        width = 1;
+        while ((width < 8) && (n >> (width * 4)))
+        {
+            width++;
+        }
+    }
+
+    for (uint8_t i = 0; i < width; i++)
+    {
+        buffer[width - 1 - i] = format_hex_digits[(n >> (i * 4)) & 0xF];
+    }
+    buffer[width] = 0;
+
+    return width;
+}
+
+uint8_t Format_UFix(char *buffer, uint32_t n, uint8_t decimals)
+{
+    char digits[10];
+    uint8_t length = 0;
+
+    if (decimals > 9) decimals = 9;
+
+    // Write at least one digit before the period
+    uint8_t count = Format_Reverse_Digits(digits, n, decimals + 1);
+
+    for (uint8_t i = count; i > 0; i--)
+    {
+        if (i == decimals)
+        {
+            buffer[length++] = '.';
+        }
+        buffer[length++] = digits[i - 1];
+    }
+    buffer[length] = 0;
+
+    return length;
+}
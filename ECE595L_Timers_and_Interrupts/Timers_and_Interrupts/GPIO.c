@@ -55,7 +55,7 @@ void LED1_Init()
 
 uint8_t LED1_Output(uint8_t led_value)
 {
-    P1->OUT = (P1->OUT & 0xFE) | led_value;
+    GPIO_Pin_Write(P1, 0, led_value);
     return ((led_value != 0) ? 1 : 0);
 }
 
@@ -70,13 +70,17 @@ void LED2_Init()
 
 uint8_t LED2_Output(uint8_t led_value)
 {
-    P2->OUT = (P2->OUT & 0xF8) | led_value;
+    GPIO_Pin_Write(P2, 0, led_value & 0x01);
+    GPIO_Pin_Write(P2, 1, led_value & 0x02);
+    GPIO_Pin_Write(P2, 2, led_value & 0x04);
     return ((led_value != 0) ? 1 : 0);
 }
 
 void LED2_Toggle(uint8_t led_value)
 {
-    P2->OUT ^= led_value;
+    if (led_value & 0x01) GPIO_Pin_Toggle(P2, 0);
+    if (led_value & 0x02) GPIO_Pin_Toggle(P2, 1);
+    if (led_value & 0x04) GPIO_Pin_Toggle(P2, 2);
 }
 
 void Buttons_Init()
@@ -172,9 +176,10 @@ void LED_Pattern_2()
     LED1_Output(RED_LED_ON);
     LED2_Output(RGB_LED_RED);
 
-    for (uint8_t led_count = 0; led_count <= 0xFF; led_count++)
+    // The counter is wider than 8 bits so that the loop ends after 0xFF (an 8-bit counter would wrap around to 0)
+    for (uint16_t led_count = 0; led_count <= 0xFF; led_count++)
     {
-        PMOD_8LD_Output(led_count);
+        PMOD_8LD_Output((uint8_t)led_count);
         Clock_Delay1ms(100);
         uint8_t switch_status = PMOD_SWT_Status();
         if (switch_status != 0x01)
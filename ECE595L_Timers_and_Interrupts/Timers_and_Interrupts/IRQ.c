@@ -0,0 +1,171 @@
+/**
+ * @file IRQ.c
+ * @brief Source code for the IRQ driver.
+ *
+ * This file contains the function definitions for the IRQ driver.
+ * It copies the interrupt vector table to SRAM and installs the handlers of IRQ_Register in the copy.
+ *
+ * For more information regarding the vector table, refer to the Vector Table section (2.4.2)
+ * of the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/IRQ.h"
+#include "../inc/Critical_Section.h"
+#include "../inc/CortexM_Inline.h"
+
+// Vector table of startup_msp432p401r_ccs.c, placed in flash at address 0
+extern void (* const interruptVectors[IRQ_NUM_VECTORS])(void);
+
+// Copy of the vector table in SRAM, used by the NVIC once SCB->VTOR points to it
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_SECTION(irq_ram_vectors, ".vtable")
+#pragma DATA_ALIGN(irq_ram_vectors, IRQ_VECTOR_TABLE_ALIGNMENT)
+static IRQ_Handler irq_ram_vectors[IRQ_NUM_VECTORS];
+#else
+static IRQ_Handler irq_ram_vectors[IRQ_NUM_VECTORS] __attribute__((aligned(IRQ_VECTOR_TABLE_ALIGNMENT)));
+#endif
+
+static uint8_t irq_ram_vectors_used = 0;
+
+/**
+ * @brief Returns the index of an interrupt in the vector table, or -1 if the interrupt cannot be registered.
+ *
+ * The index is the exception number: 16 for the first device interrupt, and 4 to 15 for the system exceptions.
+ * The reset vector, NMI, and HardFault cannot be registered.
+ */
+static int16_t IRQ_Vector_Index(IRQn_Type irqn)
+{
+    int16_t index = (int16_t)irqn + 16;
+
+    if ((index < 4) || (index >= IRQ_NUM_VECTORS)) return -1;
+
+    return index;
+}
+
+void IRQ_Init(void)
+{
+    uint32_t sr = Critical_Section_Enter();
+
+    if (irq_ram_vectors_used == 0)
+    {
+        // Copy the flash vector table, including the handlers that are linked by the drivers
+        for (uint16_t i = 0; i < IRQ_NUM_VECTORS; i++)
+        {
+            irq_ram_vectors[i] = interruptVectors[i];
+        }
+
+        // Complete the copy before the NVIC reads the vectors from SRAM
+        CortexM_DSB();
+
+        // Point the Vector Table Offset Register to the copy
+        SCB->VTOR = (uintptr_t)irq_ram_vectors;
+
+        // Use the new vector table for the next exception
+        CortexM_DSB();
+        CortexM_ISB();
+
+        irq_ram_vectors_used = 1;
+    }
+
+    Critical_Section_Exit(sr);
+}
+
+void IRQ_Priority_Init(void)
+{
+    // Keep the other fields of AIRCR, and write the key that is required to modify the register
+    uint32_t aircr = SCB->AIRCR & ~(0xFFFF0000 | 0x00000700);
+
+    // Set PRIGROUP (bits 10-8) to split the priority fields into a group priority and a sub-priority
+    SCB->AIRCR = aircr | (0x05FA << 16) | (IRQ_PRIORITY_GROUPING << 8);
+}
+
+int8_t IRQ_Set_Priority(IRQn_Type irqn, uint8_t priority)
+{
+    int16_t index = IRQ_Vector_Index(irqn);
+
+    if ((index < 0) || (priority > 7)) return -1;
+
+    if (((SCB->AIRCR >> 8) & 0x7) != IRQ_PRIORITY_GROUPING)
+    {
+        IRQ_Priority_Init();
+    }
+
+    if (irqn < 0)
+    {
+        // Set the priority of the system exception in the System Handler Priority Registers
+        // SHP[0] is the priority of MemoryManagement (exception number 4)
+        SCB->SHP[index - 4] = (priority << 5);
+    }
+    else
+    {
+        // Set the priority of the device interrupt in the NVIC Interrupt Priority Registers
+        // The IP array is byte-addressed, and only the upper 3 bits of each field are implemented
+        NVIC->IP[irqn] = (priority << 5);
+    }
+
+    return 0;
+}
+
+int8_t IRQ_Register(IRQn_Type irqn, IRQ_Handler handler, uint8_t priority)
+{
+    int16_t index = IRQ_Vector_Index(irqn);
+
+    if ((index < 0) || (handler == 0) || (priority > 7)) return -1;
+
+    IRQ_Init();
+
+    // Install the handler (a single word write, so the interrupt can be enabled)
+    irq_ram_vectors[index] = handler;
+    CortexM_DSB();
+
+    IRQ_Set_Priority(irqn, priority);
+
+    if (irqn >= 0)
+    {
+        // Clear a request that was pending before the handler was installed, and enable the interrupt
+        NVIC->ICPR[irqn >> 5] = (1UL << (irqn & 0x1F));
+        NVIC->ISER[irqn >> 5] = (1UL << (irqn & 0x1F));
+    }
+
+    return 0;
+}
+
+int8_t IRQ_Unregister(IRQn_Type irqn)
+{
+    int16_t index = IRQ_Vector_Index(irqn);
+
+    if (index < 0) return -1;
+
+    if (irqn >= 0)
+    {
+        // Disable the interrupt and wait until the NVIC cannot take it anymore
+        NVIC->ICER[irqn >> 5] = (1UL << (irqn & 0x1F));
+        CortexM_DSB();
+        CortexM_ISB();
+    }
+
+    // Restore the handler of the flash vector table
+    if (irq_ram_vectors_used)
+    {
+        irq_ram_vectors[index] = interruptVectors[index];
+    }
+
+    return 0;
+}
+
+IRQ_Handler IRQ_Get_Handler(IRQn_Type irqn)
+{
+    int16_t index = IRQ_Vector_Index(irqn);
+
+    if (index < 0) return 0;
+
+    if (irq_ram_vectors_used)
+    {
+        return irq_ram_vectors[index];
+    }
+
+    return interruptVectors[index];
+}
@@ -0,0 +1,147 @@
+/**
+ * @file ISR_Profiler.c
+ * @brief Source code for the ISR_Profiler driver.
+ *
+ * This file contains the function definitions for the ISR_Profiler driver.
+ * It uses the DWT cycle counter (CYCCNT) of the Cortex-M4 to measure the execution time of interrupt handlers.
+ *
+ * For more information regarding the DWT unit, refer to the Cortex-M4 Technical Reference Manual.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include <stdio.h>
+#include "../inc/ISR_Profiler.h"
+#include "../inc/Critical_Section.h"
+
+static ISR_Profiler_Stats isr_profiler_stats[ISR_PROFILER_NUM_IRQS];
+
+// Time of the request marked by ISR_Profiler_Mark_Request, used by the next ISR_Profiler_Record of the interrupt
+// Each flag is a separate byte, so the main loop and the handler do not need a critical section to set and clear it
+static volatile uint32_t isr_profiler_request_cycles[ISR_PROFILER_NUM_IRQS];
+static volatile uint8_t isr_profiler_request_marked[ISR_PROFILER_NUM_IRQS];
+
+static const char * const isr_profiler_names[ISR_PROFILER_NUM_IRQS] =
+{
+    "SysTick",
+    "PORT4",
+    "PORT6",
+    "EUSCIA0"
+};
+
+void ISR_Profiler_Init()
+{
+    // Enable the DWT unit (TRCENA in DEMCR)
+    CoreDebug->DEMCR |= 0x01000000;
+
+    // Clear and enable the cycle counter
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= 0x00000001;
+
+    ISR_Profiler_Reset();
+}
+
+void ISR_Profiler_Record(ISR_Profiler_IRQ irq, uint32_t entry_cycles, uint32_t latency)
+{
+    uint32_t cycles = DWT->CYCCNT - entry_cycles;
+    ISR_Profiler_Stats *stats = &isr_profiler_stats[irq];
+    uint8_t bin = 0;
+
+    stats->count++;
+    stats->total_cycles += cycles;
+    if (cycles < stats->min_cycles) stats->min_cycles = cycles;
+    if (cycles > stats->max_cycles) stats->max_cycles = cycles;
+
+    while ((bin < (ISR_PROFILER_HISTOGRAM_BINS - 1)) && (cycles >= (32u << bin)))
+    {
+        bin++;
+    }
+    stats->histogram[bin]++;
+
+    if (isr_profiler_request_marked[irq])
+    {
+        if (latency == ISR_PROFILER_LATENCY_UNKNOWN) latency = entry_cycles - isr_profiler_request_cycles[irq];
+        isr_profiler_request_marked[irq] = 0;
+    }
+
+    if (latency != ISR_PROFILER_LATENCY_UNKNOWN)
+    {
+        stats->latency_count++;
+        stats->total_latency += latency;
+        if (latency < stats->min_latency) stats->min_latency = latency;
+        if (latency > stats->max_latency) stats->max_latency = latency;
+    }
+}
+
+void ISR_Profiler_Mark_Request(ISR_Profiler_IRQ irq)
+{
+    isr_profiler_request_cycles[irq] = DWT->CYCCNT;
+    isr_profiler_request_marked[irq] = 1;
+}
+
+void ISR_Profiler_Get_Stats(ISR_Profiler_IRQ irq, ISR_Profiler_Stats *stats)
+{
+    uint32_t sr = Critical_Section_Enter();
+    *stats = isr_profiler_stats[irq];
+    Critical_Section_Exit(sr);
+}
+
+void ISR_Profiler_Reset()
+{
+    uint32_t sr = Critical_Section_Enter();
+
+    for (uint8_t irq = 0; irq < ISR_PROFILER_NUM_IRQS; irq++)
+    {
+        ISR_Profiler_Stats *stats = &isr_profiler_stats[irq];
+
+        stats->count = 0;
+        stats->min_cycles = 0xFFFFFFFF;
+        stats->max_cycles = 0;
+        stats->total_cycles = 0;
+        stats->latency_count = 0;
+        stats->min_latency = 0xFFFFFFFF;
+        stats->max_latency = 0;
+        stats->total_latency = 0;
+
+        for (uint8_t bin = 0; bin < ISR_PROFILER_HISTOGRAM_BINS; bin++)
+        {
+            stats->histogram[bin] = 0;
+        }
+    }
+
+    Critical_Section_Exit(sr);
+}
+
+void ISR_Profiler_Print()
+{
+    ISR_Profiler_Stats stats;
+
+    for (uint8_t irq = 0; irq < ISR_PROFILER_NUM_IRQS; irq++)
+    {
+        ISR_Profiler_Get_Stats((ISR_Profiler_IRQ)irq, &stats);
+
+        unsigned long mean = (stats.count) ? (unsigned long)(stats.total_cycles / stats.count) : 0;
+        unsigned long min = (stats.count) ? (unsigned long)stats.min_cycles : 0;
+
+        printf("ISR %s count=%lu min=%lu max=%lu mean=%lu", isr_profiler_names[irq],
+               (unsigned long)stats.count, min, (unsigned long)stats.max_cycles, mean);
+
+        if (stats.latency_count)
+        {
+            printf(" lat_min=%lu lat_max=%lu lat_mean=%lu", (unsigned long)stats.min_latency,
+                   (unsigned long)stats.max_latency, (unsigned long)(stats.total_latency / stats.latency_count));
+        }
+        else
+        {
+            printf(" lat_min=- lat_max=- lat_mean=-");
+        }
+
+        printf(" hist=");
+        for (uint8_t bin = 0; bin < ISR_PROFILER_HISTOGRAM_BINS; bin++)
+        {
+            printf((bin == 0) ? "%lu" : ",%lu", (unsigned long)stats.histogram[bin]);
+        }
+        printf("\n");
+    }
+}
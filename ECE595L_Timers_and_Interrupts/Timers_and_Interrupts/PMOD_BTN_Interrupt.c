@@ -23,11 +23,29 @@
  */
 
 #include "../inc/PMOD_BTN_Interrupt.h"
+#include "../inc/Critical_Section.h"
+#include "../inc/IRQ.h"
+#include "../inc/RAM_Function.h"
+#include "../inc/Config.h"
+
+/**
+ * @brief Pushes an event for a push button whose level changed during its debounce window.
+ *
+ * This function is called by the Debounce driver from TA2_N_IRQHandler, which has the same priority as PORT6_IRQHandler.
+ */
+static void PMOD_BTN_Level_Changed(uint8_t pins, uint8_t level)
+{
+    Event_Queue_Push(EVENT_SOURCE_PMOD_BTN, pins, level, Debounce_Get_Stable_State(DEBOUNCE_PORT_P6));
+}
 
 void PMOD_BTN_Interrupt_Init(void(*task)(uint8_t))
 {
-    // Store the user-defined task function for use during interrupt handling
-    PMOD_BTN_Task = task;
+    // Subscribe the user-defined task function to the events of all PMOD buttons
+    // Other handlers can subscribe to specific buttons with Event_Queue_Subscribe
+    if (task)
+    {
+        Event_Queue_Subscribe(EVENT_SOURCE_PMOD_BTN, EVENT_ALL_PINS, task);
+    }
 
     // Configure the following pins as GPIO pins: P6.0, P6.1, P6.2, and P6.3
     P6->SEL0 &= ~0x0F;
@@ -46,20 +64,42 @@ void PMOD_BTN_Interrupt_Init(void(*task)(uint8_t))
     // Configure the pins to use rising edge event triggers: P6.0, P6.1, P6.2, and P6.3
     P6->IES &= ~0x0F;
 
+    // Debounce each of the following pins separately: P6.0, P6.1, P6.2, and P6.3
+    Debounce_Configure_Port(DEBOUNCE_PORT_P6, 0x0F, Config_Values.pmod_btn_debounce_ms);
+
     // Clear any existing interrupt flags
     P6->IFG &= ~0x0F;
 
     // Enable interrupts on the following pins: P6.0, P6.1, P6.2, and P6.3
     P6->IE |= 0x0F;
 
-    // Set the priority of the interrupts (IRQ 40) to 0 (section 2.4.3.21)
-    NVIC->IP[10] = (NVIC->IP[10] & 0xFFFFFF0F);
+    // Set the priority of the interrupts (IRQ 40) to the I/O tier (see IRQ_Priority.h)
+    IRQ_Set_Priority(PORT6_IRQn, IRQ_PRIORITY_PMOD_BTN);
 
     // Enable Interrupt 40 in NVIC (section 2.4.3.2)
     // Bit 8 corresponds to IRQ 40
     NVIC->ISER[1] = 0x00000100;
 }
 
+void PMOD_BTN_Set_Both_Edges(uint8_t enable)
+{
+    if (enable)
+    {
+        // Toggle the edge select of P6.0 - P6.3 after each edge
+        Debounce_Set_Both_Edges(DEBOUNCE_PORT_P6, 0x0F, &PMOD_BTN_Level_Changed);
+    }
+    else
+    {
+        Debounce_Set_Both_Edges(DEBOUNCE_PORT_P6, 0, 0);
+
+        // Go back to rising edge event triggers and drop the flags set by the change of IES
+        uint32_t sr = Critical_Section_Enter();
+        P6->IES &= ~0x0F;
+        P6->IFG &= ~0x0F;
+        Critical_Section_Exit(sr);
+    }
+}
+
 uint8_t PMOD_BTN_Read(void)
 {
     // Declare a local variable to store the input register value
@@ -72,11 +112,26 @@ uint8_t PMOD_BTN_Read(void)
     return pmod_btn_state;
 }
 
-void PORT6_IRQHandler(void)
+RAM_FUNCTION void PORT6_IRQHandler(void)
 {
-    // Clear the interrupt flags for P6.0 - P6.3
-    P6->IFG &= ~0x0F;
+    ISR_PROFILER_ENTER();
+
+    uint16_t vector;
+
+    // Reading P6->IV returns the highest priority pending interrupt (0x02 for P6.0 up to 0x10 for P6.7) and clears its flag
+    // An edge that occurs while the handler is running is found by the next read, so each edge is reported once
+    while ((vector = P6->IV) != 0)
+    {
+        uint8_t pin = (1 << ((vector >> 1) - 1));
+
+        if ((pin & 0x0F) == 0) continue;
+
+        // Sample the new level of the push button, and ignore its bounces until its debounce window expires
+        uint8_t level = Debounce_Edge(DEBOUNCE_PORT_P6, pin);
+
+        // Defer the user-defined task to the main loop
+        Event_Queue_Push(EVENT_SOURCE_PMOD_BTN, pin, level, Debounce_Get_Stable_State(DEBOUNCE_PORT_P6));
+    }
 
-    // Execute the user-defined task
-    (*PMOD_BTN_Task)(PMOD_BTN_Read());
+    ISR_PROFILER_EXIT(ISR_PROFILER_PORT6);
 }
@@ -0,0 +1,296 @@
+/**
+ * @file Sampler.c
+ * @brief Source code for the Sampler driver.
+ *
+ * This file contains the function definitions for the Sampler driver.
+ * It samples digital inputs from a Scheduler task, and computes the features of their windows of samples on demand.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Sampler.h"
+#include "../inc/Scheduler.h"
+#include "../inc/SysTick_Interrupt.h"
+
+typedef struct
+{
+    uint8_t (*read)(void);
+    uint8_t pin_mask;
+    uint32_t period;
+    uint32_t deadline;
+
+    // Ring buffer of samples: 'head' is the index of the next sample, and 'count' is the number of samples it holds
+    uint8_t samples[SAMPLER_WINDOW_SIZE];
+    uint16_t head;
+    uint16_t count;
+    uint32_t timestamp;
+
+    // Number of consecutive samples without an active pin (SAMPLER_WINDOW_SIZE at most)
+    uint16_t idle_count;
+
+    // Number of samples taken, and the value it had when the features were computed
+    uint32_t sequence;
+    uint32_t features_sequence;
+    Sampler_Features features;
+} Sampler_Input;
+
+static Sampler_Input sampler_inputs[SAMPLER_MAX_INPUTS];
+static uint8_t sampler_count = 0;
+
+// ID of the Sampler task while the inputs are sampled (see Sampler_Start), otherwise -1
+static int8_t sampler_task_id = -1;
+
+// Period of the Sampler task: the greatest common divisor of the periods of the inputs
+static uint32_t sampler_task_period = 0;
+
+/**
+ * @brief Returns the greatest common divisor of two periods.
+ */
+static uint32_t Sampler_GCD(uint32_t a, uint32_t b)
+{
+    while (b != 0)
+    {
+        uint32_t remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+
+    return a;
+}
+
+/**
+ * @brief Returns the index of a sample in the ring buffer, where 0 is the oldest sample of the window.
+ */
+static uint16_t Sampler_Index(const Sampler_Input *input, uint16_t position)
+{
+    return (uint16_t)(input->head - input->count + position) & (SAMPLER_WINDOW_SIZE - 1);
+}
+
+/**
+ * @brief Computes the features of the window of an input in one pass over the samples.
+ */
+static void Sampler_Compute_Features(const Sampler_Input *input, Sampler_Features *features)
+{
+    uint16_t active_runs[SAMPLER_NUM_PINS] = {0};
+    uint32_t changes = 0;
+    uint8_t previous = input->samples[Sampler_Index(input, 0)];
+
+    features->changed_pins = 0;
+    features->sample_count = input->count;
+    features->timestamp = input->timestamp;
+    features->window_ticks = input->count * input->period;
+
+    for (uint8_t pin = 0; pin < SAMPLER_NUM_PINS; pin++)
+    {
+        features->hit_counts[pin] = 0;
+        active_runs[pin] = (previous >> pin) & 0x01;
+    }
+
+    for (uint16_t position = 1; position < input->count; position++)
+    {
+        uint8_t sample = input->samples[Sampler_Index(input, position)];
+        uint8_t changed = sample ^ previous;
+
+        features->changed_pins |= changed;
+
+        for (uint8_t pin = 0; pin < SAMPLER_NUM_PINS; pin++)
+        {
+            if (sample & (1 << pin))
+            {
+                // A pin that was inactive in the previous sample is a new hit
+                if (changed & (1 << pin)) features->hit_counts[pin]++;
+                active_runs[pin]++;
+            }
+            else
+            {
+                active_runs[pin] = 0;
+            }
+
+            if (changed & (1 << pin)) changes++;
+        }
+
+        previous = sample;
+    }
+
+    features->state = previous;
+
+    for (uint8_t pin = 0; pin < SAMPLER_NUM_PINS; pin++)
+    {
+        features->hold_ticks[pin] = active_runs[pin] * input->period;
+    }
+
+    features->changes_per_1000_ticks = (features->window_ticks > 0) ? ((changes * 1000) / features->window_ticks) : 0;
+}
+
+/**
+ * @brief Aligns the deadlines of all inputs with the next run of the Sampler task.
+ */
+static void Sampler_Align_Deadlines(void)
+{
+    uint32_t now = SysTick_Interrupt_Get_Ticks();
+
+    for (uint8_t i = 0; i < sampler_count; i++)
+    {
+        sampler_inputs[i].deadline = now + sampler_inputs[i].period;
+    }
+}
+
+void Sampler_Init(void)
+{
+    sampler_count = 0;
+    sampler_task_id = -1;
+    sampler_task_period = 0;
+}
+
+int8_t Sampler_Add_Input(uint8_t (*read)(void), uint8_t pin_mask, uint32_t period_ticks)
+{
+    uint32_t task_period = period_ticks;
+
+    if ((sampler_count >= SAMPLER_MAX_INPUTS) || (read == 0) || (period_ticks == 0)) return -1;
+
+    // The task runs at the greatest common divisor of the periods, so each period is a multiple of the task period
+    for (uint8_t i = 0; i < sampler_count; i++)
+    {
+        task_period = Sampler_GCD(task_period, sampler_inputs[i].period);
+    }
+
+    // The task is only registered while the inputs are sampled
+    sampler_task_period = task_period;
+    if (sampler_task_id >= 0) Scheduler_Set_Period(sampler_task_id, task_period);
+
+    Sampler_Input *input = &sampler_inputs[sampler_count];
+
+    input->read = read;
+    input->pin_mask = pin_mask;
+    input->period = period_ticks;
+    input->head = 0;
+    input->count = 0;
+    input->idle_count = 0;
+    input->sequence = 0;
+    input->features_sequence = 0;
+    sampler_count++;
+
+    // If the task is running, it was restarted, so the deadlines of all inputs are aligned with its next run
+    Sampler_Align_Deadlines();
+
+    return (int8_t)(sampler_count - 1);
+}
+
+int8_t Sampler_Start(void)
+{
+    if (sampler_count == 0) return -1;
+
+    // Each input is sampled for at least one more window
+    for (uint8_t i = 0; i < sampler_count; i++)
+    {
+        sampler_inputs[i].idle_count = 0;
+    }
+
+    if (sampler_task_id >= 0) return 0;
+
+    sampler_task_id = Scheduler_Add_Task(&Sampler_Task, sampler_task_period, sampler_task_period);
+    if (sampler_task_id < 0) return -1;
+
+    Sampler_Align_Deadlines();
+
+    return 0;
+}
+
+uint8_t Sampler_Is_Running(void)
+{
+    return (sampler_task_id >= 0) ? 1 : 0;
+}
+
+void Sampler_Task(void)
+{
+    uint32_t now = SysTick_Interrupt_Get_Ticks();
+
+    for (uint8_t i = 0; i < sampler_count; i++)
+    {
+        Sampler_Input *input = &sampler_inputs[i];
+
+        if ((int32_t)(now - input->deadline) < 0) continue;
+
+        uint8_t sample = input->read() & input->pin_mask;
+
+        input->samples[input->head] = sample;
+        input->head = (input->head + 1) & (SAMPLER_WINDOW_SIZE - 1);
+        if (input->count < SAMPLER_WINDOW_SIZE) input->count++;
+        input->timestamp = now;
+        input->sequence++;
+
+        if (sample != 0)
+        {
+            input->idle_count = 0;
+        }
+        else if (input->idle_count < SAMPLER_WINDOW_SIZE)
+        {
+            input->idle_count++;
+        }
+
+        // Skip the missed samples if the task is late by more than one period
+        input->deadline += input->period;
+        if ((int32_t)(now - input->deadline) >= 0) input->deadline = now + input->period;
+    }
+
+    // Stop once no pin of any input has been active for a full window, so the main loop can use LPM3 again
+    for (uint8_t i = 0; i < sampler_count; i++)
+    {
+        if (sampler_inputs[i].idle_count < SAMPLER_WINDOW_SIZE) return;
+    }
+
+    Scheduler_Remove_Task(sampler_task_id);
+    sampler_task_id = -1;
+}
+
+int8_t Sampler_Get_Features(int8_t input, Sampler_Features *features)
+{
+    if ((input < 0) || (input >= sampler_count) || (sampler_inputs[input].count == 0)) return -1;
+
+    Sampler_Input *sampler_input = &sampler_inputs[input];
+
+    if (sampler_input->features_sequence != sampler_input->sequence)
+    {
+        Sampler_Compute_Features(sampler_input, &sampler_input->features);
+        sampler_input->features_sequence = sampler_input->sequence;
+    }
+
+    *features = sampler_input->features;
+
+    return 0;
+}
+
+uint16_t Sampler_Get_Window(int8_t input, uint8_t *samples, uint16_t count, uint16_t decimation)
+{
+    if ((input < 0) || (input >= sampler_count) || (decimation == 0)) return 0;
+
+    const Sampler_Input *sampler_input = &sampler_inputs[input];
+    uint16_t available = sampler_input->count / decimation;
+
+    if (count > available) count = available;
+
+    // The last copied sample ends with the latest sample of the window
+    uint16_t position = sampler_input->count - (count * decimation);
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint8_t sample = 0;
+
+        for (uint16_t j = 0; j < decimation; j++)
+        {
+            sample |= sampler_input->samples[Sampler_Index(sampler_input, position++)];
+        }
+
+        samples[i] = sample;
+    }
+
+    return count;
+}
+
+uint32_t Sampler_Get_Period(int8_t input)
+{
+    if ((input < 0) || (input >= sampler_count)) return 0;
+
+    return sampler_inputs[input].period;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file Scheduler.c
+ * @brief Source code for the Scheduler driver.
+ *
+ * This file contains the function definitions for the Scheduler driver.
+ * It runs periodic and one-shot tasks from the main loop using the tick count of the SysTick timer.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Scheduler.h"
+#include "../inc/SysTick_Interrupt.h"
+
+typedef struct
+{
+    void (*task)(void);
+    uint32_t period;
+    uint32_t deadline;
+    uint8_t active;
+} Scheduler_Task;
+
+static Scheduler_Task scheduler_tasks[SCHEDULER_MAX_TASKS];
+
+// IDs of the active tasks, sorted by deadline (earliest first)
+static uint8_t scheduler_order[SCHEDULER_MAX_TASKS];
+static uint8_t scheduler_count = 0;
+
+/**
+ * @brief Returns 1 if tick count 'a' is before tick count 'b'.
+ *
+ * The difference is interpreted as a signed number so that the comparison is correct across a rollover,
+ * as long as the two tick counts are less than 2^31 ticks apart.
+ */
+static uint8_t Scheduler_Is_Before(uint32_t a, uint32_t b)
+{
+    return ((int32_t)(a - b) < 0) ? 1 : 0;
+}
+
+/**
+ * @brief Inserts a task in scheduler_order according to its deadline.
+ *
+ * Tasks with the same deadline run in the order in which they were inserted.
+ */
+static void Scheduler_Insert(uint8_t task_id)
+{
+    uint8_t position = scheduler_count;
+    uint32_t deadline = scheduler_tasks[task_id].deadline;
+
+    while ((position > 0) && Scheduler_Is_Before(deadline, scheduler_tasks[scheduler_order[position - 1]].deadline))
+    {
+        scheduler_order[position] = scheduler_order[position - 1];
+        position--;
+    }
+
+    scheduler_order[position] = task_id;
+    scheduler_count++;
+}
+
+/**
+ * @brief Removes a task from scheduler_order.
+ */
+static void Scheduler_Unlink(uint8_t task_id)
+{
+    uint8_t position = 0;
+
+    while ((position < scheduler_count) && (scheduler_order[position] != task_id))
+    {
+        position++;
+    }
+
+    if (position == scheduler_count) return;
+
+    scheduler_count--;
+    for (; position < scheduler_count; position++)
+    {
+        scheduler_order[position] = scheduler_order[position + 1];
+    }
+}
+
+void Scheduler_Init()
+{
+    for (uint8_t task_id = 0; task_id < SCHEDULER_MAX_TASKS; task_id++)
+    {
+        scheduler_tasks[task_id].active = 0;
+    }
+    scheduler_count = 0;
+}
+
+int8_t Scheduler_Add_Task(void(*task)(void), uint32_t period_ticks, uint32_t phase_ticks)
+{
+    if (task == 0) return -1;
+
+    for (uint8_t task_id = 0; task_id < SCHEDULER_MAX_TASKS; task_id++)
+    {
+        if (scheduler_tasks[task_id].active == 0)
+        {
+            scheduler_tasks[task_id].task = task;
+            scheduler_tasks[task_id].period = period_ticks;
+            scheduler_tasks[task_id].deadline = SysTick_Interrupt_Get_Ticks() + phase_ticks;
+            scheduler_tasks[task_id].active = 1;
+            Scheduler_Insert(task_id);
+            return (int8_t)task_id;
+        }
+    }
+
+    return -1;
+}
+
+void Scheduler_Remove_Task(int8_t task_id)
+{
+    if ((task_id < 0) || (task_id >= SCHEDULER_MAX_TASKS) || (scheduler_tasks[task_id].active == 0)) return;
+
+    Scheduler_Unlink(task_id);
+    scheduler_tasks[task_id].active = 0;
+}
+
+void Scheduler_Restart_Task(int8_t task_id)
+{
+    if ((task_id < 0) || (task_id >= SCHEDULER_MAX_TASKS) || (scheduler_tasks[task_id].active == 0)) return;
+
+    Scheduler_Unlink(task_id);
+    scheduler_tasks[task_id].deadline = SysTick_Interrupt_Get_Ticks() + scheduler_tasks[task_id].period;
+    Scheduler_Insert(task_id);
+}
+
+void Scheduler_Set_Period(int8_t task_id, uint32_t period_ticks)
+{
+    if ((task_id < 0) || (task_id >= SCHEDULER_MAX_TASKS) || (scheduler_tasks[task_id].active == 0)) return;
+
+    scheduler_tasks[task_id].period = period_ticks;
+    Scheduler_Unlink(task_id);
+    scheduler_tasks[task_id].deadline = SysTick_Interrupt_Get_Ticks() + period_ticks;
+    Scheduler_Insert(task_id);
+}
+
+uint32_t Scheduler_Get_Period(int8_t task_id)
+{
+    if ((task_id < 0) || (task_id >= SCHEDULER_MAX_TASKS) || (scheduler_tasks[task_id].active == 0)) return 0;
+
+    return scheduler_tasks[task_id].period;
+}
+
+uint32_t Scheduler_Run()
+{
+    uint32_t now = SysTick_Interrupt_Get_Ticks();
+    uint32_t count = 0;
+
+    while ((scheduler_count > 0) && !Scheduler_Is_Before(now, scheduler_tasks[scheduler_order[0]].deadline))
+    {
+        uint8_t task_id = scheduler_order[0];
+        Scheduler_Task *task = &scheduler_tasks[task_id];
+
+        Scheduler_Unlink(task_id);
+
+        // Schedule the next run before calling the task so that the task can remove or restart itself
+        if (task->period)
+        {
+            task->deadline += task->period;
+
+            // Skip the missed runs if the task is late by more than one period
+            if (!Scheduler_Is_Before(now, task->deadline))
+            {
+                task->deadline = now + task->period;
+            }
+            Scheduler_Insert(task_id);
+        }
+        else
+        {
+            task->active = 0;
+        }
+
+        (*task->task)();
+        count++;
+    }
+
+    return count;
+}
+
+uint8_t Scheduler_Is_Task_Due()
+{
+    if (scheduler_count == 0) return 0;
+
+    return Scheduler_Is_Before(SysTick_Interrupt_Get_Ticks(), scheduler_tasks[scheduler_order[0]].deadline) ? 0 : 1;
+}
+
+uint8_t Scheduler_Get_Next_Deadline(uint32_t *deadline)
+{
+    if (scheduler_count == 0) return 0;
+
+    *deadline = scheduler_tasks[scheduler_order[0]].deadline;
+    return 1;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file Shell.c
+ * @brief Source code for the Shell driver.
+ *
+ * This file contains the function definitions for the Shell driver.
+ * It runs the commands received by EUSCI_A0 from the main loop.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include <string.h>
+#include "../inc/Shell.h"
+#include "../inc/EUSCI_A0_UART.h"
+
+typedef struct
+{
+    const char *name;
+    const char *help;
+    Shell_Handler handler;
+} Shell_Command;
+
+static Shell_Command shell_commands[SHELL_MAX_COMMANDS];
+static uint8_t shell_command_count = 0;
+
+static char shell_line_buffer[SHELL_LINE_SIZE + 1];
+static EUSCI_A0_UART_Line shell_line;
+
+/**
+ * @brief Prints the registered commands.
+ */
+static void Shell_Help(int argc, char *argv[])
+{
+    printf("help - list the commands\n");
+
+    for (uint8_t i = 0; i < shell_command_count; i++)
+    {
+        printf("%s - %s\n", shell_commands[i].name, shell_commands[i].help);
+    }
+}
+
+/**
+ * @brief Splits a line into words separated by spaces. The spaces are replaced by null characters.
+ */
+static int Shell_Split(char *line, char *argv[])
+{
+    int argc = 0;
+
+    while (*line && (argc < SHELL_MAX_ARGS))
+    {
+        while (*line == SP) *line++ = 0;
+
+        if (*line == 0) break;
+
+        argv[argc++] = line;
+
+        while (*line && (*line != SP)) line++;
+    }
+
+    return argc;
+}
+
+void Shell_Init()
+{
+    EUSCI_A0_UART_Line_Init(&shell_line, shell_line_buffer, SHELL_LINE_SIZE);
+
+    printf("\n> ");
+}
+
+int8_t Shell_Register_Command(const char *name, const char *help, Shell_Handler handler)
+{
+    if ((shell_command_count >= SHELL_MAX_COMMANDS) || (handler == 0)) return -1;
+
+    shell_commands[shell_command_count].name = name;
+    shell_commands[shell_command_count].help = help;
+    shell_commands[shell_command_count].handler = handler;
+    shell_command_count++;
+
+    return 0;
+}
+
+uint8_t Shell_Run()
+{
+    char *argv[SHELL_MAX_ARGS];
+
+    if (EUSCI_A0_UART_Line_Poll(&shell_line) == 0) return 0;
+
+    printf("\n");
+
+    int argc = Shell_Split(shell_line_buffer, argv);
+
+    if (argc > 0)
+    {
+        if (strcmp(argv[0], "help") == 0)
+        {
+            Shell_Help(argc, argv);
+        }
+        else
+        {
+            uint8_t i;
+
+            for (i = 0; i < shell_command_count; i++)
+            {
+                if (strcmp(argv[0], shell_commands[i].name) == 0)
+                {
+                    (*shell_commands[i].handler)(argc, argv);
+                    break;
+                }
+            }
+
+            if (i == shell_command_count)
+            {
+                printf("Unknown command: %s\n", argv[0]);
+            }
+        }
+    }
+
+    printf("> ");
+
+    return 1;
+}
+
+uint8_t Shell_Parse_UInt(const char *text, uint32_t *value)
+{
+    uint32_t number = 0;
+    uint32_t base = 10;
+
+    if ((text[0] == '0') && ((text[1] == 'x') || (text[1] == 'X')))
+    {
+        base = 0x10;
+        text += 2;
+    }
+
+    if (*text == 0) return 0;
+
+    while (*text)
+    {
+        uint32_t digit = 0x10; // assume bad
+        char character = *text++;
+
+        if ((character >= '0') && (character <= '9'))
+        {
+            digit = character - '0';
+        }
+        else if ((character >= 'A') && (character <= 'F'))
+        {
+            digit = (character - 'A') + 0xA;
+        }
+        else if ((character >= 'a') && (character <= 'f'))
+        {
+            digit = (character - 'a') + 0xA;
+        }
+
+        if (digit >= base) return 0;
+
+        number = (number * base) + digit;
+    }
+
+    *value = number;
+    return 1;
+}
@@ -11,6 +11,35 @@
  */
 
 #include "../inc/SysTick_Interrupt.h"
+#include "../inc/Clock.h"
+#include "../inc/Critical_Section.h"
+#include "../inc/IRQ.h"
+
+volatile uint32_t SysTick_Interrupt_Ticks = 0;
+volatile uint32_t SysTick_Interrupt_Ticks_High = 0;
+
+// Number of clock cycles per tick, as configured by SysTick_Interrupt_Init
+static uint32_t SysTick_cycles_per_tick = 0;
+
+/**
+ * @brief Scales the SysTick period after a clock profile switch, so each tick keeps the same duration.
+ *
+ * The counter is restarted, and the tick in progress is counted as a whole tick so that the time never goes backwards.
+ */
+static void SysTick_Interrupt_Clock_Changed(uint32_t previous_mclk, uint32_t previous_smclk)
+{
+    uint32_t clock_cycles = (uint32_t)(((uint64_t)SysTick_cycles_per_tick * Clock_GetFreq()) / previous_mclk);
+
+    if (clock_cycles < 2) clock_cycles = 2;
+    if (clock_cycles > 0x01000000) clock_cycles = 0x01000000;
+
+    SysTick->CTRL = 0;
+    SysTick->LOAD = (clock_cycles - 1);
+    SysTick->VAL = 0;
+    SysTick_cycles_per_tick = clock_cycles;
+    SysTick_Interrupt_Add_Ticks(1);
+    SysTick->CTRL = 0x00000007;
+}
 
 void SysTick_Interrupt_Init(uint32_t clock_cycles, uint32_t priority)
 {
@@ -23,12 +52,60 @@ void SysTick_Interrupt_Init(uint32_t clock_cycles, uint32_t priority)
     // Any write to the current value clears it
     SysTick->VAL = 0;
 
-    // The SHP (System Handler Priority Register) represents an array of registers within the
-    // SCB (System Control Block) that control interrupt priorities.
-    // Set the priority into the upper 3 bits of the 8-bit field for SysTick interrupt
-    // System Handler 15 (tied to SysTick_Handler) can be accessed at index 11 of the SHP array
-    SCB->SHP[11] = priority << 5;
+    // Set the priority of the SysTick exception (System Handler 15, index 11 of the SHP array)
+    IRQ_Set_Priority(SysTick_IRQn, priority);
+
+    // Reset the tick count
+    SysTick_Interrupt_Ticks = 0;
+    SysTick_Interrupt_Ticks_High = 0;
+    SysTick_cycles_per_tick = clock_cycles;
 
     // Enable SysTick with interrupts and the core clock
     SysTick->CTRL = 0x00000007;
+
+    // Keep the period when the clock frequency changes
+    Clock_AddChangeHandler(&SysTick_Interrupt_Clock_Changed);
+}
+
+void SysTick_Interrupt_Add_Ticks(uint32_t ticks)
+{
+    uint32_t new_ticks = SysTick_Interrupt_Ticks + ticks;
+
+    if (new_ticks >= ticks)
+    {
+        SysTick_Interrupt_Ticks = new_ticks;
+    }
+    else
+    {
+        // The low word rolls over, so update both words in a critical section
+        // All interrupts are masked because the 64-bit time can be read from a handler of any priority
+        uint32_t sr = Critical_Section_Enter();
+        SysTick_Interrupt_Ticks_High++;
+        SysTick_Interrupt_Ticks = new_ticks;
+        Critical_Section_Exit(sr);
+    }
+}
+
+uint32_t SysTick_Interrupt_Get_Ticks(void)
+{
+    return SysTick_Interrupt_Ticks;
+}
+
+uint32_t SysTick_Interrupt_Get_Cycles_Per_Tick(void)
+{
+    return SysTick_cycles_per_tick;
+}
+
+uint32_t SysTick_Interrupt_Ms_To_Ticks(uint32_t ms)
+{
+    uint64_t ticks = ((uint64_t)ms * Clock_GetFreq()) / (1000ULL * SysTick_cycles_per_tick);
+
+    if ((ticks == 0) && (ms != 0)) ticks = 1;
+
+    return (uint32_t)ticks;
+}
+
+uint32_t SysTick_Interrupt_Ticks_To_Ms(uint32_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * SysTick_cycles_per_tick * 1000) / Clock_GetFreq());
 }
@@ -0,0 +1,138 @@
+/**
+ * @file Telemetry.c
+ * @brief Source code for the Telemetry driver.
+ *
+ * This file contains the function definitions for the Telemetry driver.
+ * It builds binary records, frames them with COBS, and sends them with EUSCI_A0_UART_OutChar.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Telemetry.h"
+#include "../inc/EUSCI_A0_UART.h"
+#include "../inc/CRC.h"
+
+// Size of the type and timestamp fields
+#define TELEMETRY_HEADER_SIZE 5
+
+// Size of the CRC field
+#define TELEMETRY_CRC_SIZE 2
+
+// Largest record before framing
+#define TELEMETRY_MAX_RECORD_SIZE (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_PAYLOAD_SIZE + TELEMETRY_CRC_SIZE)
+
+/**
+ * @brief Stores a 32-bit value in little-endian order.
+ */
+static void Telemetry_Put_U32(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)(value);
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * @brief Sends one COBS block: the code byte followed by (code - 1) data bytes.
+ */
+static void Telemetry_Send_Block(const uint8_t *data, uint8_t code)
+{
+    EUSCI_A0_UART_OutChar((char)code);
+
+    for (uint8_t i = 1; i < code; i++)
+    {
+        EUSCI_A0_UART_OutChar((char)data[i - 1]);
+    }
+}
+
+uint16_t Telemetry_CRC16(uint16_t crc, const uint8_t *data, uint32_t length)
+{
+    // The CRC32 module computes CRC-16/CCITT-FALSE, so no bit loop is needed
+    return (uint16_t)CRC_Compute(CRC_MODE_CRC16_CCITT, crc, data, length);
+}
+
+void Telemetry_Send(Telemetry_Type type, uint32_t timestamp, const uint8_t *payload, uint8_t length)
+{
+    uint8_t record[TELEMETRY_MAX_RECORD_SIZE];
+
+    if (length > TELEMETRY_MAX_PAYLOAD_SIZE) return;
+
+    record[0] = (uint8_t)type;
+    Telemetry_Put_U32(&record[1], timestamp);
+    for (uint8_t i = 0; i < length; i++)
+    {
+        record[TELEMETRY_HEADER_SIZE + i] = payload[i];
+    }
+
+    uint8_t size = TELEMETRY_HEADER_SIZE + length;
+    uint16_t crc = Telemetry_CRC16(0xFFFF, record, size);
+    record[size++] = (uint8_t)(crc);
+    record[size++] = (uint8_t)(crc >> 8);
+
+    // Start with a delimiter so that a record that follows text or a broken record can be decoded
+    EUSCI_A0_UART_OutChar(0);
+
+    // COBS: each 0x00 byte is replaced by the distance to the next 0x00 byte (or to the end of the record)
+    // Records are shorter than 254 bytes, so a block never reaches the maximum length of 0xFF
+    uint8_t block_start = 0;
+    for (uint8_t i = 0; i < size; i++)
+    {
+        if (record[i] == 0)
+        {
+            Telemetry_Send_Block(&record[block_start], (uint8_t)(i - block_start + 1));
+            block_start = i + 1;
+        }
+    }
+    Telemetry_Send_Block(&record[block_start], (uint8_t)(size - block_start + 1));
+
+    EUSCI_A0_UART_OutChar(0);
+}
+
+void Telemetry_Send_Bumper(uint32_t timestamp, uint8_t state)
+{
+    Telemetry_Send(TELEMETRY_TYPE_BUMPER, timestamp, &state, 1);
+}
+
+void Telemetry_Send_PMOD_BTN(uint32_t timestamp, uint8_t state, uint8_t counter)
+{
+    uint8_t payload[2] = { state, counter };
+
+    Telemetry_Send(TELEMETRY_TYPE_PMOD_BTN, timestamp, payload, 2);
+}
+
+void Telemetry_Send_Counter(uint32_t timestamp, uint8_t counter_id, uint32_t value)
+{
+    uint8_t payload[5];
+
+    payload[0] = counter_id;
+    Telemetry_Put_U32(&payload[1], value);
+
+    Telemetry_Send(TELEMETRY_TYPE_COUNTER, timestamp, payload, 5);
+}
+
+void Telemetry_Send_Profiler(uint32_t timestamp, ISR_Profiler_IRQ irq, const ISR_Profiler_Stats *stats)
+{
+    uint8_t payload[29];
+
+    payload[0] = (uint8_t)irq;
+    Telemetry_Put_U32(&payload[1], stats->count);
+    Telemetry_Put_U32(&payload[5], (stats->count) ? stats->min_cycles : 0);
+    Telemetry_Put_U32(&payload[9], stats->max_cycles);
+    Telemetry_Put_U32(&payload[13], (stats->count) ? (uint32_t)(stats->total_cycles / stats->count) : 0);
+
+    if (stats->latency_count)
+    {
+        Telemetry_Put_U32(&payload[17], stats->min_latency);
+        Telemetry_Put_U32(&payload[21], stats->max_latency);
+        Telemetry_Put_U32(&payload[25], (uint32_t)(stats->total_latency / stats->latency_count));
+    }
+    else
+    {
+        Telemetry_Put_U32(&payload[17], ISR_PROFILER_LATENCY_UNKNOWN);
+        Telemetry_Put_U32(&payload[21], ISR_PROFILER_LATENCY_UNKNOWN);
+        Telemetry_Put_U32(&payload[25], ISR_PROFILER_LATENCY_UNKNOWN);
+    }
+
+    Telemetry_Send(TELEMETRY_TYPE_PROFILER, timestamp, payload, 29);
+}
@@ -0,0 +1,201 @@
+/**
+ * @file Tickless_Idle.c
+ * @brief Source code for the Tickless_Idle driver.
+ *
+ * This file contains the function definitions for the Tickless_Idle driver.
+ * It stops the periodic SysTick interrupt while the CPU sleeps until the next deadline
+ * and corrects the tick count on wake-up.
+ *
+ * For more information regarding the low-power modes, refer to the Power Control Manager (PCM) section (8)
+ * of the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Tickless_Idle.h"
+#include "../inc/SysTick_Interrupt.h"
+#include "../inc/EUSCI_A0_UART.h"
+#include "../inc/Clock.h"
+#include "../inc/Timer_A_Interrupt.h"
+#include "../inc/Timer32_Interrupt.h"
+#include "../inc/Timer_A_PWM.h"
+#include "../inc/CortexM_Inline.h"
+#include "../inc/IRQ.h"
+
+// Frequency of ACLK (sourced from REFOCLK by Clock_Init48MHz)
+#define TICKLESS_IDLE_ACLK_FREQUENCY 32768
+
+static Tickless_Idle_Mode idle_mode = TICKLESS_IDLE_MODE_LPM0;
+
+/**
+ * @brief Adds the complete ticks of 'elapsed_cycles' to the tick count and restarts SysTick.
+ *
+ * 'elapsed_cycles' is counted from the start of the tick that was in progress when the sleep started.
+ * SysTick is restarted so that its next interrupt occurs at the end of the tick that is now in progress.
+ */
+static uint32_t Tickless_Idle_Resume_SysTick(uint32_t cycles_per_tick, uint64_t elapsed_cycles)
+{
+    uint32_t complete_ticks = (uint32_t)(elapsed_cycles / cycles_per_tick);
+    uint32_t remainder = (uint32_t)(elapsed_cycles % cycles_per_tick);
+
+    // Run the rest of the current tick, then return to the normal period after the next reload
+    // A reload value of 0 would not generate an interrupt, so at least 1 is used
+    uint32_t reload = (cycles_per_tick - 1) - remainder;
+    if (reload == 0) reload = 1;
+
+    SysTick->LOAD = reload;
+    SysTick->VAL = 0;
+    SysTick->CTRL = 0x00000007;
+    SysTick->LOAD = cycles_per_tick - 1;
+
+    SysTick_Interrupt_Add_Ticks(complete_ticks);
+
+    return complete_ticks;
+}
+
+/**
+ * @brief Sleeps in LPM0 with SysTick reloaded to fire at the deadline.
+ */
+static uint32_t Tickless_Idle_Sleep_LPM0(uint32_t idle_ticks, uint32_t cycles_per_tick)
+{
+    uint32_t max_ticks = 0x00FFFFFF / cycles_per_tick;
+
+    if (idle_ticks > max_ticks) idle_ticks = max_ticks;
+
+    // Stop SysTick and get the number of cycles that are left in the current tick
+    SysTick->CTRL = 0x00000005;
+    uint32_t remaining_cycles = SysTick->VAL;
+
+    // Do not sleep if a SysTick interrupt is already pending
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        return Tickless_Idle_Resume_SysTick(cycles_per_tick, (cycles_per_tick - 1) - remaining_cycles);
+    }
+
+    // Fire once at the end of the tick that contains the deadline
+    uint32_t reload = remaining_cycles + ((idle_ticks - 1) * cycles_per_tick);
+    SysTick->LOAD = reload;
+    SysTick->VAL = 0;
+    SysTick->CTRL = 0x00000007;
+
+    // Enter LPM0 (Sleep)
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+    CortexM_Sleep();
+
+    // Stop SysTick. Reading CTRL also clears COUNTFLAG (bit 16)
+    uint32_t ctrl = SysTick->CTRL;
+    SysTick->CTRL = 0x00000005;
+    uint32_t current = SysTick->VAL;
+
+    if (ctrl & 0x00010000)
+    {
+        // SysTick reached the deadline. The pending SysTick interrupt adds the last tick,
+        // and the cycles counted after the reload belong to the next tick
+        uint32_t elapsed_after_reload = reload - current;
+        if (elapsed_after_reload >= cycles_per_tick) elapsed_after_reload = 0;
+        return Tickless_Idle_Resume_SysTick(cycles_per_tick, ((uint64_t)(idle_ticks - 1) * cycles_per_tick) + elapsed_after_reload);
+    }
+
+    // Another interrupt woke up the CPU before the deadline
+    return Tickless_Idle_Resume_SysTick(cycles_per_tick, ((cycles_per_tick - 1) - remaining_cycles) + (uint64_t)(reload - current));
+}
+
+/**
+ * @brief Sleeps in LPM3 with TIMER_A3 (ACLK) set to fire at the deadline.
+ */
+static uint32_t Tickless_Idle_Sleep_LPM3(uint32_t idle_ticks, uint32_t cycles_per_tick)
+{
+    uint32_t clock_frequency = Clock_GetFreq();
+
+    // Stop SysTick and get the number of cycles that are left in the current tick
+    SysTick->CTRL = 0x00000005;
+    uint32_t remaining_cycles = SysTick->VAL;
+    uint32_t start_cycles = (cycles_per_tick - 1) - remaining_cycles;
+
+    // Do not sleep if a SysTick interrupt is already pending
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        return Tickless_Idle_Resume_SysTick(cycles_per_tick, start_cycles);
+    }
+
+    // Convert the time until the deadline to ACLK cycles (at most 65535)
+    uint64_t sleep_cycles = ((uint64_t)idle_ticks * cycles_per_tick) - start_cycles;
+    uint64_t aclk_counts = (sleep_cycles * TICKLESS_IDLE_ACLK_FREQUENCY) / clock_frequency;
+    if (aclk_counts > 0xFFFF) aclk_counts = 0xFFFF;
+    if (aclk_counts == 0) aclk_counts = 1;
+
+    // Start TIMER_A3 in up mode from ACLK with the CCR0 interrupt enabled
+    TIMER_A3->CTL = 0x0104;
+    TIMER_A3->CCR[0] = (uint16_t)aclk_counts;
+    TIMER_A3->CCTL[0] = 0x0010;
+    TIMER_A3->CTL = 0x0114;
+
+    // Request LPM3 and enter Deep Sleep
+    PCM->CTL0 = (PCM->CTL0 & ~0xFFFF00F0) | 0x695A0000;
+    SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+    CortexM_Sleep();
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+    // Get the number of ACLK cycles that have passed and stop TIMER_A3
+    // The CCR0 interrupt flag is cleared by TA3_0_IRQHandler
+    uint32_t elapsed_counts = (TIMER_A3->CCTL[0] & 0x0001) ? (uint32_t)aclk_counts : TIMER_A3->R;
+    TIMER_A3->CTL &= ~0x0030;
+
+    uint64_t elapsed_cycles = ((uint64_t)elapsed_counts * clock_frequency) / TICKLESS_IDLE_ACLK_FREQUENCY;
+
+    return Tickless_Idle_Resume_SysTick(cycles_per_tick, start_cycles + elapsed_cycles);
+}
+
+void Tickless_Idle_Init(Tickless_Idle_Mode mode)
+{
+    idle_mode = mode;
+
+    // Stop TIMER_A3 and select ACLK as its clock source
+    TIMER_A3->CTL = 0x0104;
+    TIMER_A3->CCTL[0] = 0;
+
+    // Set the priority of TA3_0 (IRQ 14) to the logging tier, since it is only used to wake up the CPU
+    IRQ_Set_Priority(TA3_0_IRQn, IRQ_PRIORITY_TICKLESS_WAKE);
+
+    // Enable Interrupt 14 in NVIC (section 2.4.3.1)
+    // Bit 14 corresponds to IRQ 14
+    NVIC->ISER[0] = 0x00004000;
+}
+
+void Tickless_Idle_Set_Mode(Tickless_Idle_Mode mode)
+{
+    idle_mode = mode;
+}
+
+uint32_t Tickless_Idle_Sleep(uint32_t idle_ticks)
+{
+    uint32_t cycles_per_tick = SysTick_Interrupt_Get_Cycles_Per_Tick();
+
+    if ((cycles_per_tick == 0) || (idle_ticks < TICKLESS_IDLE_MIN_TICKS))
+    {
+        CortexM_Wait_For_Interrupt();
+        return 0;
+    }
+
+    // MCLK and SMCLK are stopped in LPM3, so wait in LPM0 while EUSCI_A0 is transmitting or can receive a character
+    // or while a Timer_A or Timer32 periodic interrupt or a Timer_A PWM output from SMCLK is running
+    if ((idle_mode == TICKLESS_IDLE_MODE_LPM3) && (idle_ticks >= TICKLESS_IDLE_LPM3_MIN_TICKS)
+        && !EUSCI_A0_UART_TX_Busy() && !EUSCI_A0_UART_RX_Enabled()
+        && !Timer_A_Interrupt_Is_Running() && !Timer32_Interrupt_Is_Running() && !Timer_A_PWM_Is_Using_SMCLK())
+    {
+        return Tickless_Idle_Sleep_LPM3(idle_ticks, cycles_per_tick);
+    }
+
+    return Tickless_Idle_Sleep_LPM0(idle_ticks, cycles_per_tick);
+}
+
+void TA3_0_IRQHandler(void)
+{
+    // Clear the CCR0 interrupt flag and stop TIMER_A3
+    TIMER_A3->CCTL[0] &= ~0x0001;
+    TIMER_A3->CTL &= ~0x0030;
+
+    // Complete the writes before the exception return, so the cleared flag does not trigger the handler again
+    CortexM_DSB();
+}
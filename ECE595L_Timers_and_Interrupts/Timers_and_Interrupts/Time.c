@@ -0,0 +1,124 @@
+/**
+ * @file Time.c
+ * @brief Source code for the Time driver.
+ *
+ * This file contains the function definitions for the Time driver.
+ * It combines the 64-bit SysTick tick count with the SysTick down-counter to provide a monotonic time base.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Time.h"
+#include "../inc/SysTick_Interrupt.h"
+#include "../inc/Clock.h"
+
+static uint32_t time_cycles_per_tick = 1;
+static uint32_t time_cycles_per_us = 1;
+
+// Number of microseconds per tick, or 0 if a tick is not a whole number of microseconds
+static uint32_t time_us_per_tick = 0;
+
+// Added to the cycle count so that it continues from the same value after a clock profile switch
+static uint64_t time_cycles_offset = 0;
+
+/**
+ * @brief Reads the 64-bit tick count and the clock cycles that have passed in the current tick.
+ */
+static inline uint64_t Time_Read(uint32_t *elapsed_cycles)
+{
+    uint32_t high;
+    uint32_t low;
+    uint32_t value;
+    uint32_t pending;
+
+    // Read again if SysTick_Handler updated the tick count while it was being read
+    do
+    {
+        high = SysTick_Interrupt_Ticks_High;
+        low = SysTick_Interrupt_Ticks;
+        value = SysTick->VAL;
+        pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+    } while ((low != SysTick_Interrupt_Ticks) || (high != SysTick_Interrupt_Ticks_High));
+
+    uint64_t ticks = ((uint64_t)high << 32) | low;
+
+    // SysTick counts down from (cycles per tick - 1) to 0
+    // After a sleep, Tickless_Idle starts the first tick from a lower value, which still gives the cycles since the start of the tick
+    uint32_t elapsed = (time_cycles_per_tick - 1) - value;
+
+    // If the SysTick interrupt is pending and the counter has already been reloaded, the tick has not been counted yet
+    // If the counter is close to 0, it was read before the reload, so the tick has already been counted in 'elapsed'
+    if (pending && (value > (time_cycles_per_tick >> 1)))
+    {
+        ticks++;
+    }
+
+    *elapsed_cycles = elapsed;
+    return ticks;
+}
+
+/**
+ * @brief Reads the SysTick period and the clock frequency.
+ */
+static void Time_Update_Clock(void)
+{
+    time_cycles_per_tick = SysTick_Interrupt_Get_Cycles_Per_Tick();
+    time_cycles_per_us = Clock_GetFreq() / 1000000;
+
+    if (time_cycles_per_tick == 0) time_cycles_per_tick = 1;
+    if (time_cycles_per_us == 0) time_cycles_per_us = 1;
+
+    time_us_per_tick = ((time_cycles_per_tick % time_cycles_per_us) == 0) ? (time_cycles_per_tick / time_cycles_per_us) : 0;
+}
+
+/**
+ * @brief Updates the time base after a clock profile switch.
+ *
+ * SysTick_Interrupt_Clock_Changed has already scaled the SysTick period and restarted the current tick,
+ * so the cycle count of the previous profile at the start of this tick is kept as an offset.
+ */
+static void Time_Clock_Changed(uint32_t previous_mclk, uint32_t previous_smclk)
+{
+    uint64_t ticks = ((uint64_t)SysTick_Interrupt_Ticks_High << 32) | SysTick_Interrupt_Ticks;
+    uint32_t previous_cycles_per_tick = time_cycles_per_tick;
+
+    Time_Update_Clock();
+
+    time_cycles_offset += ticks * previous_cycles_per_tick - ticks * time_cycles_per_tick;
+}
+
+void Time_Init(void)
+{
+    time_cycles_offset = 0;
+    Time_Update_Clock();
+
+    // Registered after the SysTick handler (SysTick_Interrupt_Init is called first), so it sees the new SysTick period
+    Clock_AddChangeHandler(&Time_Clock_Changed);
+}
+
+uint64_t Time_NowCycles(void)
+{
+    uint32_t elapsed_cycles;
+    uint64_t ticks = Time_Read(&elapsed_cycles);
+
+    return (ticks * time_cycles_per_tick) + elapsed_cycles + time_cycles_offset;
+}
+
+uint64_t Time_NowUs(void)
+{
+    uint32_t elapsed_cycles;
+    uint64_t ticks = Time_Read(&elapsed_cycles);
+
+    if (time_us_per_tick == 0)
+    {
+        return ((ticks * time_cycles_per_tick) + elapsed_cycles) / time_cycles_per_us;
+    }
+
+    return (ticks * time_us_per_tick) + (elapsed_cycles / time_cycles_per_us);
+}
+
+uint32_t Time_Get_Cycles_Per_Us(void)
+{
+    return time_cycles_per_us;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file Timer32_Interrupt.c
+ * @brief Source code for the Timer32_Interrupt driver.
+ *
+ * This file contains the function definitions for the Timer32_Interrupt driver.
+ * It uses TIMER32_1 or TIMER32_2 to perform interrupt requests at the specified period.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Timer32_Interrupt.h"
+#include "../inc/Clock.h"
+#include "../inc/IRQ.h"
+
+typedef struct
+{
+    Timer32_Type *registers;
+    uint8_t irq;
+    uint8_t running;
+    uint32_t clock_cycles;
+    void (*task)(void);
+} Timer32_Interrupt_State;
+
+static Timer32_Interrupt_State timer32_states[TIMER32_INT_NUM_TIMERS] =
+{
+    { TIMER32_1, 25, 0, 0, 0 },
+    { TIMER32_2, 26, 0, 0, 0 }
+};
+
+/**
+ * @brief Scales the period of the running timers after a clock profile switch, so it stays the same in time.
+ *
+ * The new period starts after the current period ends.
+ */
+static void Timer32_Interrupt_Clock_Changed(uint32_t previous_mclk, uint32_t previous_smclk)
+{
+    for (uint8_t timer = 0; timer < TIMER32_INT_NUM_TIMERS; timer++)
+    {
+        Timer32_Interrupt_State *state = &timer32_states[timer];
+
+        if (state->running)
+        {
+            uint64_t clock_cycles = ((uint64_t)state->clock_cycles * Clock_GetFreq()) / previous_mclk;
+
+            if (clock_cycles == 0) clock_cycles = 1;
+            if (clock_cycles > 0xFFFFFFFF) clock_cycles = 0xFFFFFFFF;
+
+            state->clock_cycles = (uint32_t)clock_cycles;
+            state->registers->BGLOAD = (state->clock_cycles - 1);
+        }
+    }
+}
+
+void Timer32_Interrupt_Init(Timer32_Interrupt_Timer timer, uint32_t clock_cycles, uint32_t priority, void(*task)(void))
+{
+    if (timer >= TIMER32_INT_NUM_TIMERS) return;
+
+    Timer32_Interrupt_State *state = &timer32_states[timer];
+
+    if (clock_cycles == 0) clock_cycles = 1;
+
+    // Disable the timer during setup
+    state->registers->CONTROL = 0;
+    state->registers->INTCLR = 0;
+    state->task = task;
+
+    // Set the load value to establish the interrupt period
+    // The interrupt occurs when the counter reaches 0, so the period is LOAD + 1 cycles
+    state->registers->LOAD = (clock_cycles - 1);
+    state->clock_cycles = clock_cycles;
+
+    // Set the priority of the interrupt
+    IRQ_Set_Priority((IRQn_Type)state->irq, priority);
+
+    // Enable the interrupt in NVIC (section 2.4.3.1)
+    NVIC->ISER[0] = (0x00000001 << state->irq);
+
+    // Enable the timer in periodic 32-bit mode with interrupts and a prescaler of 1
+    // Bit 7: ENABLE, Bit 6: MODE (periodic), Bit 5: IE, Bit 1: SIZE (32-bit)
+    state->running = 1;
+    state->registers->CONTROL = 0x000000E2;
+
+    // Keep the period when MCLK changes
+    Clock_AddChangeHandler(&Timer32_Interrupt_Clock_Changed);
+}
+
+void Timer32_Interrupt_Set_Period(Timer32_Interrupt_Timer timer, uint32_t clock_cycles)
+{
+    if ((timer >= TIMER32_INT_NUM_TIMERS) || (clock_cycles == 0)) return;
+
+    // A write to BGLOAD sets the value that is loaded at the end of the current period
+    timer32_states[timer].registers->BGLOAD = (clock_cycles - 1);
+    timer32_states[timer].clock_cycles = clock_cycles;
+}
+
+void Timer32_Interrupt_Stop(Timer32_Interrupt_Timer timer)
+{
+    if (timer >= TIMER32_INT_NUM_TIMERS) return;
+
+    Timer32_Interrupt_State *state = &timer32_states[timer];
+
+    // Disable the timer and its interrupt in NVIC
+    state->registers->CONTROL = 0;
+    state->registers->INTCLR = 0;
+    NVIC->ICER[0] = (0x00000001 << state->irq);
+    state->running = 0;
+}
+
+uint8_t Timer32_Interrupt_Is_Running()
+{
+    for (uint8_t timer = 0; timer < TIMER32_INT_NUM_TIMERS; timer++)
+    {
+        if (timer32_states[timer].running) return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Clears the interrupt of the timer and calls its task.
+ */
+static void Timer32_Interrupt_Handler(Timer32_Interrupt_State *state)
+{
+    // Any write to INTCLR clears the interrupt
+    state->registers->INTCLR = 0;
+
+    if (state->task)
+    {
+        (*state->task)();
+    }
+}
+
+void T32_INT1_IRQHandler(void)
+{
+    Timer32_Interrupt_Handler(&timer32_states[TIMER32_INT_1]);
+}
+
+void T32_INT2_IRQHandler(void)
+{
+    Timer32_Interrupt_Handler(&timer32_states[TIMER32_INT_2]);
+}
@@ -0,0 +1,258 @@
+/**
+ * @file Timer_A_Interrupt.c
+ * @brief Source code for the Timer_A_Interrupt driver.
+ *
+ * This file contains the function definitions for the Timer_A_Interrupt driver.
+ * It uses TIMER_A0 or TIMER_A1 to perform interrupt requests at the specified period.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Timer_A_Interrupt.h"
+#include "../inc/Clock.h"
+#include "../inc/IRQ.h"
+#include "../inc/Timer_A_PWM.h"
+
+typedef struct
+{
+    Timer_A_Type *registers;
+    uint8_t irq_0;
+    uint8_t divider;
+    uint8_t running;
+    uint32_t clock_cycles;
+    void (*period_task)(void);
+    void (*compare_task[TIMER_A_INT_NUM_COMPARE_CHANNELS])(void);
+} Timer_A_Interrupt_State;
+
+// IRQ 8 (TA0_0) and IRQ 9 (TA0_N) for TIMER_A0, IRQ 10 (TA1_0) and IRQ 11 (TA1_N) for TIMER_A1
+static Timer_A_Interrupt_State timer_a_states[TIMER_A_INT_NUM_TIMERS] =
+{
+    { TIMER_A0, 8, 1, 0, 0, 0, { 0 } },
+    { TIMER_A1, 10, 1, 0, 0, 0, { 0 } }
+};
+
+/**
+ * @brief Selects the divider of a stopped timer and sets its period.
+ *
+ * @return The ID field of the divider, which is written to TAxCTL when the timer is started.
+ */
+static uint8_t Timer_A_Interrupt_Set_Period(Timer_A_Interrupt_State *state, uint32_t clock_cycles)
+{
+    if (clock_cycles < 2) clock_cycles = 2;
+    if (clock_cycles > TIMER_A_INT_MAX_CLK_CYCLES) clock_cycles = TIMER_A_INT_MAX_CLK_CYCLES;
+
+    // Select the smallest divider (ID x TAIDEX) for which the period fits in 16 bits
+    // ID can divide by 1, 2, 4, or 8 and TAIDEX can divide by 1 to 8
+    uint8_t id = 0;
+    uint8_t idex = 0;
+    while (clock_cycles > ((uint32_t)(idex + 1) << (16 + id)))
+    {
+        if (id < 3)
+        {
+            id++;
+        }
+        else
+        {
+            idex++;
+        }
+    }
+
+    state->divider = (uint8_t)((1 << id) * (idex + 1));
+    state->clock_cycles = clock_cycles;
+
+    // Set the divider and the period
+    state->registers->EX0 = idex;
+    state->registers->CCR[0] = (uint16_t)((clock_cycles / state->divider) - 1);
+
+    return id;
+}
+
+/**
+ * @brief Scales the period and the compare offsets of the running timers after a clock profile switch that changed SMCLK.
+ *
+ * The timers are restarted from 0, so the current period is cut short.
+ */
+static void Timer_A_Interrupt_Clock_Changed(uint32_t previous_mclk, uint32_t previous_smclk)
+{
+    uint32_t smclk = Clock_GetSMCLKFreq();
+
+    if (smclk == previous_smclk) return;
+
+    for (uint8_t timer = 0; timer < TIMER_A_INT_NUM_TIMERS; timer++)
+    {
+        Timer_A_Interrupt_State *state = &timer_a_states[timer];
+        Timer_A_Type *registers = state->registers;
+        uint32_t offset_cycles[TIMER_A_INT_NUM_COMPARE_CHANNELS];
+
+        if (state->running == 0) continue;
+
+        for (uint8_t channel = 1; channel <= TIMER_A_INT_NUM_COMPARE_CHANNELS; channel++)
+        {
+            offset_cycles[channel - 1] = (uint32_t)(((uint64_t)registers->CCR[channel] * state->divider * smclk) / previous_smclk);
+        }
+
+        // Stop and clear the timer, then start it again with the new period
+        registers->CTL = 0x0004;
+        uint8_t id = Timer_A_Interrupt_Set_Period(state, (uint32_t)(((uint64_t)state->clock_cycles * smclk) / previous_smclk));
+
+        for (uint8_t channel = 1; channel <= TIMER_A_INT_NUM_COMPARE_CHANNELS; channel++)
+        {
+            uint32_t offset_counts = offset_cycles[channel - 1] / state->divider;
+
+            if (offset_counts > registers->CCR[0]) offset_counts = registers->CCR[0];
+            registers->CCR[channel] = (uint16_t)offset_counts;
+        }
+
+        registers->CTL = 0x0200 | (id << 6) | 0x0010 | 0x0004;
+    }
+}
+
+int8_t Timer_A_Interrupt_Init(Timer_A_Interrupt_Timer timer, uint32_t clock_cycles, uint32_t priority, void(*task)(void))
+{
+    if (timer >= TIMER_A_INT_NUM_TIMERS) return -1;
+
+    // The timer is owned by the Timer_A_PWM driver (both drivers number TIMER_A0 and TIMER_A1 as 0 and 1)
+    if (Timer_A_PWM_Is_Running((Timer_A_PWM_Timer)timer)) return -1;
+
+    Timer_A_Interrupt_State *state = &timer_a_states[timer];
+    Timer_A_Type *registers = state->registers;
+
+    // Stop the timer during setup
+    registers->CTL = 0x0004;
+    for (uint8_t channel = 0; channel <= TIMER_A_INT_NUM_COMPARE_CHANNELS; channel++)
+    {
+        registers->CCTL[channel] = 0;
+    }
+
+    state->period_task = task;
+    for (uint8_t channel = 0; channel < TIMER_A_INT_NUM_COMPARE_CHANNELS; channel++)
+    {
+        state->compare_task[channel] = 0;
+    }
+
+    uint8_t id = Timer_A_Interrupt_Set_Period(state, clock_cycles);
+
+    // Enable the CCR0 interrupt
+    registers->CCTL[0] = 0x0010;
+
+    // Set the priority of the TAx_0 and TAx_N interrupts
+    IRQ_Set_Priority((IRQn_Type)state->irq_0, priority);
+    IRQ_Set_Priority((IRQn_Type)(state->irq_0 + 1), priority);
+
+    // Enable the TAx_0 and TAx_N interrupts in NVIC (section 2.4.3.1)
+    NVIC->ISER[0] = (0x00000003 << state->irq_0);
+
+    // Start the timer in up mode from SMCLK
+    state->running = 1;
+    registers->CTL = 0x0200 | (id << 6) | 0x0010 | 0x0004;
+
+    // Keep the period when SMCLK changes
+    Clock_AddChangeHandler(&Timer_A_Interrupt_Clock_Changed);
+
+    return 0;
+}
+
+void Timer_A_Interrupt_Set_Compare(Timer_A_Interrupt_Timer timer, uint8_t channel, uint32_t offset_cycles, void(*task)(void))
+{
+    if ((timer >= TIMER_A_INT_NUM_TIMERS) || (channel < 1) || (channel > TIMER_A_INT_NUM_COMPARE_CHANNELS)) return;
+
+    Timer_A_Interrupt_State *state = &timer_a_states[timer];
+    uint32_t offset_counts = offset_cycles / state->divider;
+
+    if (offset_counts > state->registers->CCR[0]) offset_counts = state->registers->CCR[0];
+
+    state->registers->CCTL[channel] = 0;
+    state->compare_task[channel - 1] = task;
+    state->registers->CCR[channel] = (uint16_t)offset_counts;
+
+    // Enable the compare interrupt of the channel
+    state->registers->CCTL[channel] = 0x0010;
+}
+
+void Timer_A_Interrupt_Clear_Compare(Timer_A_Interrupt_Timer timer, uint8_t channel)
+{
+    if ((timer >= TIMER_A_INT_NUM_TIMERS) || (channel < 1) || (channel > TIMER_A_INT_NUM_COMPARE_CHANNELS)) return;
+
+    timer_a_states[timer].registers->CCTL[channel] = 0;
+    timer_a_states[timer].compare_task[channel - 1] = 0;
+}
+
+void Timer_A_Interrupt_Stop(Timer_A_Interrupt_Timer timer)
+{
+    if (timer >= TIMER_A_INT_NUM_TIMERS) return;
+
+    Timer_A_Interrupt_State *state = &timer_a_states[timer];
+
+    // Stop the timer and disable the TAx_0 and TAx_N interrupts in NVIC
+    state->registers->CTL &= ~0x0030;
+    NVIC->ICER[0] = (0x00000003 << state->irq_0);
+    state->running = 0;
+}
+
+uint8_t Timer_A_Interrupt_Is_Timer_Running(Timer_A_Interrupt_Timer timer)
+{
+    return (timer < TIMER_A_INT_NUM_TIMERS) ? timer_a_states[timer].running : 0;
+}
+
+uint8_t Timer_A_Interrupt_Is_Running()
+{
+    for (uint8_t timer = 0; timer < TIMER_A_INT_NUM_TIMERS; timer++)
+    {
+        if (timer_a_states[timer].running) return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Clears the CCR0 interrupt flag and calls the periodic task.
+ */
+static void Timer_A_Interrupt_Period(Timer_A_Interrupt_State *state)
+{
+    state->registers->CCTL[0] &= ~0x0001;
+
+    if (state->period_task)
+    {
+        (*state->period_task)();
+    }
+}
+
+/**
+ * @brief Calls the tasks of the compare channels whose interrupt flags are set.
+ */
+static void Timer_A_Interrupt_Compare(Timer_A_Interrupt_State *state)
+{
+    uint16_t vector;
+
+    // Each read of TAxIV returns the highest pending CCRn interrupt (2 * n) and clears its flag
+    while ((vector = state->registers->IV) != 0)
+    {
+        uint8_t channel = (uint8_t)(vector >> 1);
+
+        if ((channel >= 1) && (channel <= TIMER_A_INT_NUM_COMPARE_CHANNELS) && state->compare_task[channel - 1])
+        {
+            (*state->compare_task[channel - 1])();
+        }
+    }
+}
+
+void TA0_0_IRQHandler(void)
+{
+    Timer_A_Interrupt_Period(&timer_a_states[TIMER_A_INT_TA0]);
+}
+
+void TA0_N_IRQHandler(void)
+{
+    Timer_A_Interrupt_Compare(&timer_a_states[TIMER_A_INT_TA0]);
+}
+
+void TA1_0_IRQHandler(void)
+{
+    Timer_A_Interrupt_Period(&timer_a_states[TIMER_A_INT_TA1]);
+}
+
+void TA1_N_IRQHandler(void)
+{
+    Timer_A_Interrupt_Compare(&timer_a_states[TIMER_A_INT_TA1]);
+}
@@ -0,0 +1,277 @@
+/**
+ * @file Timer_A_PWM.c
+ * @brief Source code for the Timer_A_PWM driver.
+ *
+ * This file contains the function definitions for the Timer_A_PWM driver.
+ * It generates PWM signals with the compare outputs of TIMER_A0 or TIMER_A1.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/Timer_A_PWM.h"
+#include "../inc/Clock.h"
+#include "../inc/Timer_A_Interrupt.h"
+
+// Port mapping codes of the Timer_A compare outputs (PxMAPy mnemonics)
+#define TIMER_A_PWM_PM_TA0CCR3A 22
+#define TIMER_A_PWM_PM_TA0CCR4A 23
+#define TIMER_A_PWM_PM_TA1CCR1A 24
+#define TIMER_A_PWM_PM_TA1CCR2A 25
+#define TIMER_A_PWM_PM_TA1CCR3A 26
+
+// Key that unlocks the port mapping registers
+#define TIMER_A_PWM_PMAP_KEY 0x2D52
+
+// Longest number of timer clock cycles in a period (65536 timer cycles with a divider of 64)
+#define TIMER_A_PWM_MAX_CLK_CYCLES 4194304
+
+typedef struct
+{
+    Timer_A_Type *registers;
+    uint8_t running;
+    uint8_t use_smclk;
+    uint32_t period_counts;
+    uint32_t period_us;
+    uint32_t requested_period_us;
+} Timer_A_PWM_State;
+
+typedef struct
+{
+    Timer_A_PWM_Timer timer;
+    uint8_t channel;
+    uint8_t pin;
+    uint8_t port_map;
+} Timer_A_PWM_Pin;
+
+static Timer_A_PWM_State timer_a_pwm_states[TIMER_A_PWM_NUM_TIMERS] =
+{
+    { TIMER_A0, 0, 0, 0, 0, 0 },
+    { TIMER_A1, 0, 0, 0, 0, 0 }
+};
+
+// All outputs are on P2, which has a port mapping controller
+static const Timer_A_PWM_Pin timer_a_pwm_pins[TIMER_A_PWM_NUM_OUTPUTS] =
+{
+    { TIMER_A_PWM_TA1, 1, 0, TIMER_A_PWM_PM_TA1CCR1A },     // P2.0: RGB LED (red)
+    { TIMER_A_PWM_TA1, 2, 1, TIMER_A_PWM_PM_TA1CCR2A },     // P2.1: RGB LED (green)
+    { TIMER_A_PWM_TA1, 3, 2, TIMER_A_PWM_PM_TA1CCR3A },     // P2.2: RGB LED (blue)
+    { TIMER_A_PWM_TA0, 3, 6, TIMER_A_PWM_PM_TA0CCR3A },     // P2.6: Right motor PWM
+    { TIMER_A_PWM_TA0, 4, 7, TIMER_A_PWM_PM_TA0CCR4A }      // P2.7: Left motor PWM
+};
+
+static uint16_t timer_a_pwm_duty[TIMER_A_PWM_NUM_OUTPUTS];
+
+/**
+ * @brief Sets the compare channel of an output from its duty cycle.
+ *
+ * A duty cycle of 0 or TIMER_A_PWM_DUTY_MAX uses output mode 0, so the output stays at 0 or 1 without a glitch on each period.
+ */
+static void Timer_A_PWM_Apply_Duty(Timer_A_PWM_Output output)
+{
+    const Timer_A_PWM_Pin *pin = &timer_a_pwm_pins[output];
+    Timer_A_PWM_State *state = &timer_a_pwm_states[pin->timer];
+    uint16_t duty_permille = timer_a_pwm_duty[output];
+
+    if ((state->running == 0) || (duty_permille == 0))
+    {
+        // Output mode 0 with OUT = 0
+        state->registers->CCTL[pin->channel] = 0x0000;
+    }
+    else if (duty_permille >= TIMER_A_PWM_DUTY_MAX)
+    {
+        // Output mode 0 with OUT = 1
+        state->registers->CCTL[pin->channel] = 0x0004;
+    }
+    else
+    {
+        // Output mode 7 (reset/set): set at CCR0, reset at CCRn
+        state->registers->CCR[pin->channel] = (uint16_t)((state->period_counts * duty_permille) / TIMER_A_PWM_DUTY_MAX);
+        state->registers->CCTL[pin->channel] = 0x00E0;
+    }
+}
+
+/**
+ * @brief Starts the running timers again with their requested period after a clock profile switch that changed SMCLK.
+ *
+ * A timer that uses ACLK is also started again, since the period may now fit with SMCLK (or the other way around).
+ */
+static void Timer_A_PWM_Clock_Changed(uint32_t previous_mclk, uint32_t previous_smclk)
+{
+    if (Clock_GetSMCLKFreq() == previous_smclk) return;
+
+    for (uint8_t timer = 0; timer < TIMER_A_PWM_NUM_TIMERS; timer++)
+    {
+        if (timer_a_pwm_states[timer].running)
+        {
+            Timer_A_PWM_Init((Timer_A_PWM_Timer)timer, timer_a_pwm_states[timer].requested_period_us);
+        }
+    }
+}
+
+int8_t Timer_A_PWM_Init(Timer_A_PWM_Timer timer, uint32_t period_us)
+{
+    if (timer >= TIMER_A_PWM_NUM_TIMERS) return -1;
+
+    // The timer is owned by the Timer_A_Interrupt driver (both drivers number TIMER_A0 and TIMER_A1 as 0 and 1)
+    if (Timer_A_Interrupt_Is_Timer_Running((Timer_A_Interrupt_Timer)timer)) return -1;
+
+    Timer_A_PWM_State *state = &timer_a_pwm_states[timer];
+    Timer_A_Type *registers = state->registers;
+    uint32_t clock_frequency = Clock_GetSMCLKFreq();
+
+    if (period_us < 1) period_us = 1;
+    if (period_us > TIMER_A_PWM_MAX_PERIOD_US) period_us = TIMER_A_PWM_MAX_PERIOD_US;
+    state->requested_period_us = period_us;
+
+    // Use SMCLK when the period fits, otherwise use ACLK
+    // At 12 MHz, the longest period that fits is TIMER_A_PWM_MAX_SMCLK_PERIOD_US
+    state->use_smclk = (((uint64_t)period_us * clock_frequency) <= ((uint64_t)TIMER_A_PWM_MAX_CLK_CYCLES * 1000000));
+    if (state->use_smclk == 0) clock_frequency = TIMER_A_PWM_ACLK_FREQUENCY;
+
+    uint32_t clock_cycles = (uint32_t)(((uint64_t)period_us * clock_frequency) / 1000000);
+
+    if (clock_cycles < 2) clock_cycles = 2;
+    if (clock_cycles > TIMER_A_PWM_MAX_CLK_CYCLES) clock_cycles = TIMER_A_PWM_MAX_CLK_CYCLES;
+
+    // Select the smallest divider (ID x TAIDEX) for which the period fits in 16 bits
+    // ID can divide by 1, 2, 4, or 8 and TAIDEX can divide by 1 to 8
+    uint8_t id = 0;
+    uint8_t idex = 0;
+    while (clock_cycles > ((uint32_t)(idex + 1) << (16 + id)))
+    {
+        if (id < 3)
+        {
+            id++;
+        }
+        else
+        {
+            idex++;
+        }
+    }
+
+    uint32_t divider = (uint32_t)((1 << id) * (idex + 1));
+
+    // Stop the timer during setup
+    registers->CTL = 0x0004;
+
+    state->period_counts = clock_cycles / divider;
+    state->period_us = (uint32_t)(((uint64_t)state->period_counts * divider * 1000000) / clock_frequency);
+    state->running = 1;
+
+    // Set the divider and the period
+    registers->EX0 = idex;
+    registers->CCR[0] = (uint16_t)(state->period_counts - 1);
+
+    // Apply the duty cycle of each output of the timer to the new period
+    for (uint8_t output = 0; output < TIMER_A_PWM_NUM_OUTPUTS; output++)
+    {
+        if (timer_a_pwm_pins[output].timer == timer)
+        {
+            Timer_A_PWM_Apply_Duty((Timer_A_PWM_Output)output);
+        }
+    }
+
+    // Start the timer in up mode from SMCLK (TASSEL = 2) or ACLK (TASSEL = 1)
+    registers->CTL = ((state->use_smclk) ? 0x0200 : 0x0100) | (id << 6) | 0x0010 | 0x0004;
+
+    // Keep the period when SMCLK changes
+    Clock_AddChangeHandler(&Timer_A_PWM_Clock_Changed);
+
+    return 0;
+}
+
+uint32_t Timer_A_PWM_Get_Period(Timer_A_PWM_Timer timer)
+{
+    if ((timer >= TIMER_A_PWM_NUM_TIMERS) || (timer_a_pwm_states[timer].running == 0)) return 0;
+
+    return timer_a_pwm_states[timer].period_us;
+}
+
+void Timer_A_PWM_Enable_Output(Timer_A_PWM_Output output, uint16_t duty_permille)
+{
+    if (output >= TIMER_A_PWM_NUM_OUTPUTS) return;
+
+    const Timer_A_PWM_Pin *pin = &timer_a_pwm_pins[output];
+    uint8_t bit = (1 << pin->pin);
+
+    Timer_A_PWM_Set_Duty(output, duty_permille);
+
+    // Map the pin to the compare output of its timer
+    // PMAPRECFG (bit 1) allows the mapping to be changed again later
+    PMAP->KEYID = TIMER_A_PWM_PMAP_KEY;
+    PMAP->CTL |= 0x0002;
+    ((volatile uint8_t *)P2MAP)[pin->pin] = pin->port_map;
+    PMAP->KEYID = 0;
+
+    // Select the primary module function (PxSEL1 = 0, PxSEL0 = 1) of the pin as an output
+    P2->DIR |= bit;
+    P2->SEL1 &= ~bit;
+    P2->SEL0 |= bit;
+}
+
+void Timer_A_PWM_Disable_Output(Timer_A_PWM_Output output)
+{
+    if (output >= TIMER_A_PWM_NUM_OUTPUTS) return;
+
+    const Timer_A_PWM_Pin *pin = &timer_a_pwm_pins[output];
+    uint8_t bit = (1 << pin->pin);
+
+    // Configure the pin as a GPIO output set to 0
+    P2->OUT &= ~bit;
+    P2->DIR |= bit;
+    P2->SEL0 &= ~bit;
+    P2->SEL1 &= ~bit;
+
+    timer_a_pwm_states[pin->timer].registers->CCTL[pin->channel] = 0;
+}
+
+void Timer_A_PWM_Set_Duty(Timer_A_PWM_Output output, uint16_t duty_permille)
+{
+    if (output >= TIMER_A_PWM_NUM_OUTPUTS) return;
+
+    if (duty_permille > TIMER_A_PWM_DUTY_MAX) duty_permille = TIMER_A_PWM_DUTY_MAX;
+
+    timer_a_pwm_duty[output] = duty_permille;
+    Timer_A_PWM_Apply_Duty(output);
+}
+
+uint16_t Timer_A_PWM_Get_Duty(Timer_A_PWM_Output output)
+{
+    return (output < TIMER_A_PWM_NUM_OUTPUTS) ? timer_a_pwm_duty[output] : 0;
+}
+
+void Timer_A_PWM_Stop(Timer_A_PWM_Timer timer)
+{
+    if (timer >= TIMER_A_PWM_NUM_TIMERS) return;
+
+    Timer_A_PWM_State *state = &timer_a_pwm_states[timer];
+
+    // Stop the timer
+    state->registers->CTL &= ~0x0030;
+    state->running = 0;
+
+    // Set the outputs of the timer to 0
+    for (uint8_t output = 0; output < TIMER_A_PWM_NUM_OUTPUTS; output++)
+    {
+        if (timer_a_pwm_pins[output].timer == timer)
+        {
+            Timer_A_PWM_Apply_Duty((Timer_A_PWM_Output)output);
+        }
+    }
+}
+
+uint8_t Timer_A_PWM_Is_Running(Timer_A_PWM_Timer timer)
+{
+    return (timer < TIMER_A_PWM_NUM_TIMERS) ? timer_a_pwm_states[timer].running : 0;
+}
+
+uint8_t Timer_A_PWM_Is_Using_SMCLK()
+{
+    for (uint8_t timer = 0; timer < TIMER_A_PWM_NUM_TIMERS; timer++)
+    {
+        if (timer_a_pwm_states[timer].running && timer_a_pwm_states[timer].use_smclk) return 1;
+    }
+
+    return 0;
+}
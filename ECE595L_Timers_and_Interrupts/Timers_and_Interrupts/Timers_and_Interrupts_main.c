@@ -11,47 +11,72 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 #include "msp.h"
 #include "../inc/Clock.h"
-#include "../inc/CortexM.h"
+#include "../inc/CortexM_Inline.h"
+#include "../inc/Delay.h"
 #include "../inc/GPIO.h"
 #include "../inc/Bumper_Sensors.h"
 #include "../inc/SysTick_Interrupt.h"
+#include "../inc/Time.h"
 #include "../inc/PMOD_BTN_Interrupt.h"
 #include "../inc/EUSCI_A0_UART.h"
+#include "../inc/Event_Queue.h"
+#include "../inc/Scheduler.h"
+#include "../inc/Tickless_Idle.h"
+#include "../inc/ISR_Profiler.h"
+#include "../inc/RAM_Function.h"
+#include "../inc/Shell.h"
+#include "../inc/Telemetry.h"
+#include "../inc/Trace.h"
+#include "../inc/Timer_A_PWM.h"
+#include "../inc/Config.h"
+#include "../inc/Sampler.h"
 
-// Global variable counter used in PMOD_BTN_Handler to determine the state of the PMOD 8LD module
-uint8_t PMOD_BTN_counter = 0x00;
+// Maximum number of trace entries printed on each iteration of the main loop
+#define TRACE_ENTRIES_PER_LOOP 4
+
+// Period and duty cycle (in tenths of a percent) of the green RGB LED, which is blinked by TIMER_A1 without the CPU
+#define RGB_LED_BLINK_PERIOD_US 1000000
+#define RGB_LED_BLINK_DUTY 20
 
-// Global variable counter to keep track of the number of SysTick interrupts
-// that have occurred. it increments in SysTick_Handler on each interrupt event.
-uint32_t SysTick_counter = 0;
+// Period (in ms) of the front LEDs toggle task
+#define FRONT_LEDS_TOGGLE_RATE_MS 1000
 
-uint32_t SysTick_counter_2s = 0;
+// Sample periods (in ms) of the bumper switches and of the PMOD BTN push buttons used by the Sampler
+#define BUMPER_SENSORS_SAMPLE_PERIOD_MS 10
+#define PMOD_BTN_SAMPLE_PERIOD_MS 20
+
+// Global variable counter used in PMOD_BTN_Handler to determine the state of the PMOD 8LD module
+uint8_t PMOD_BTN_counter = 0x00;
 
-// Global variable flag used in SysTick_Handler to initiate SysTick_counter
+// Global variable flag used by the LED toggle tasks to enable or disable toggling LED1 and the back left red LED
 uint8_t SysTick_enable = 0x00;
 
 // Global variable used to store the current state of the bumper sensors when an interrupt
 // occurs (Bumper_Sensors_Handler). It will get updated on each interrupt event.
 uint8_t bumper_sensor_value;
 
+// IDs of the LED toggle tasks registered with the Scheduler
+int8_t LED1_toggle_task_id = -1;
+int8_t back_left_LED_toggle_task_id = -1;
+int8_t front_LEDs_toggle_task_id = -1;
 
-// Global variable counter to keep track of the number of SysTick interrupts
-// that have occurred. it increments in SysTick_Handler on each interrupt event.
-// This counter is intentionally made large and is used to debounce the bump sensor.
-uint64_t dbnc_counter = 0;
+// IDs of the Sampler inputs of the bumper switches and of the PMOD BTN push buttons
+int8_t bumper_sensors_sampler_id = -1;
+int8_t pmod_btn_sampler_id = -1;
+
+// Global variable flag used to send binary Telemetry records instead of text from the event handlers
+uint8_t telemetry_enable = 0x00;
 
 /**
  * @brief SysTick interrupt handler function.
  *
  * This is the interrupt handler for the SysTick timer. It is automatically called whenever the SysTick timer reaches
- * its specified period (SYSTICK_INT_NUM_CLK_CYCLES) and generates an interrupt. The handler always increments the 'dbnc_counter' variable. The handler also
- * increments the 'SysTick_counter' and 'SysTick_counter_2s' variables when the 'SysTick_enabled' variable is set to 1 and checks if they has reached
- * the toggle rate (SYSTICK_INT_TOGGLE_RATE_MS), (SYSTICK_INT_TOGGLE_RATE_MS) respectively. When the toggle rate is reached for Systick_counter,
- * it toggles the state of LED1 (P1.0). When the toggle rate is reached for SysTick_counter_2s, it toggles the back left red LED (P8.6).
- * Then, it resets the 'SysTick_counter' variable.
- * Otherwise, 'SysTick_counter', 'SysTick_counter_2s' will be 0 and LED1 and the back left LED are also set to 0 when 'SysTick_enabled' is 0.
+ * its specified period (SYSTICK_INT_NUM_CLK_CYCLES) and generates an interrupt. The handler only increments the 'SysTick_Interrupt_Ticks' variable,
+ * which is used as the time base of the Scheduler, the Time driver, and to timestamp the events in the Event_Queue.
+ * The periodic LED toggles are done by tasks registered with the Scheduler instead.
  *
  * @note Before using this handler, ensure that the SysTick timer has been initialized using the SysTick_Init function.
  *       The timer should be configured to generate periodic interrupts at the desired rate specified by SYSTICK_INT_NUM_CLK_CYCLES.
@@ -61,41 +86,89 @@ uint64_t dbnc_counter = 0;
  * @return None
  */
 
-void SysTick_Handler(void)
+RAM_FUNCTION void SysTick_Handler(void)
+{
+    ISR_PROFILER_ENTER_SYSTICK();
+
+    SysTick_Interrupt_Add_Ticks(1);
+
+    ISR_PROFILER_EXIT(ISR_PROFILER_SYSTICK);
+}
+
+/**
+ * @brief Scheduler task that toggles LED1 (P1.0).
+ *
+ * This task runs every SYSTICK_INT_TOGGLE_RATE_MS and toggles the state of LED1 when the 'SysTick_enable' variable is set to 1.
+ *
+ * @return None
+ */
+void LED1_Toggle_Task(void)
 {
-    dbnc_counter ++;
     if (SysTick_enable == 0x01)
     {
-        SysTick_counter++;
-        if (SysTick_counter >= SYSTICK_INT_TOGGLE_RATE_MS)
-        {
-            SysTick_counter = 0;
-            P1->OUT ^= 0x01;
-        }
+        GPIO_Pin_Toggle(P1, 0);
+    }
+}
 
-        SysTick_counter_2s++;
-        if (SysTick_counter_2s >= SYSTICK_INT_2S_TOGGLE_RATE_MS)
-        {
-            SysTick_counter_2s = 0;
-            P8->OUT ^= 0x40;
-        }
+/**
+ * @brief Scheduler task that toggles the back left red LED (P8.6).
+ *
+ * This task runs every SYSTICK_INT_2S_TOGGLE_RATE_MS and toggles the state of the back left red LED
+ * when the 'SysTick_enable' variable is set to 1.
+ *
+ * @return None
+ */
+void Back_Left_LED_Toggle_Task(void)
+{
+    if (SysTick_enable == 0x01)
+    {
+        GPIO_Pin_Toggle(P8, 6);
+    }
+}
+
+/**
+ * @brief Scheduler task that toggles the front yellow LEDs (P8.0 and P8.5).
+ *
+ * This task runs every second.
+ *
+ * @return None
+ */
+void Front_LEDs_Toggle_Task(void)
+{
+    GPIO_Pin_Toggle(P8, 0);
+    GPIO_Pin_Toggle(P8, 5);
+}
+
+/**
+ * @brief Applies a change of the 'SysTick_enable' variable to the LED toggle tasks.
+ *
+ * When 'SysTick_enable' is set to 1, the periods of the LED1 and back left red LED toggle tasks are restarted,
+ * so the first toggle occurs one full period after toggling was enabled.
+ * When 'SysTick_enable' is 0, LED1 and the back left red LED are turned off.
+ *
+ * @return None
+ */
+void SysTick_Enable_Update(void)
+{
+    if (SysTick_enable == 0x01)
+    {
+        Scheduler_Restart_Task(LED1_toggle_task_id);
+        Scheduler_Restart_Task(back_left_LED_toggle_task_id);
     }
     else
     {
-        SysTick_counter = 0;
-        SysTick_counter_2s = 0;
-        P1->OUT &= ~0x01;
-        P8->OUT &= ~0x40;
+        GPIO_Pin_Clear(P1, 0);
+        GPIO_Pin_Clear(P8, 6);
     }
 }
 
 /**
  * @brief Bumper sensor interrupt handler function.
  *
- * This is the interrupt handler for the bumper sensor interrupts. It is called when a falling edge event is detected on
- * any of the bump sensor pins. The function toggles the state of the back right red LED (P8.7).
- * Additionally, it updates the 'bump_sensor_value' variable with the provided 'bump_sensor' parameter, representing the
- * state of the bump sensors at the time of the interrupt. This only happens when the debouncing period has passed.
+ * This is the handler for the bumper sensor events. It is called from Event_Queue_Dispatch in the main loop for each
+ * falling edge event that was detected on any of the bump sensor pins. The function prints the state of the bump sensors.
+ * The back right red LED (P8.7) is toggled by Bumper_Sensors_LED_Handler, which is subscribed separately. Each bump sensor is debounced separately by the Debounce driver,
+ * so a second bump sensor that is pressed shortly after the first one still generates an event.
  *
  * @param bumper_sensor_state An 8-bit unsigned integer representing the bump sensor states at the time of the interrupt.
  *
@@ -104,33 +177,58 @@ void SysTick_Handler(void)
  *
  * @note The Bump_Sensors_Handler function should be defined and implemented separately before being used.
  *
- * @note Potential bug in this function is if the dbnc counter rolled over and the sensor interrupt was fired when the dbnc counter is between 0-300
- *
  * @return None
  */
 void Bumper_Sensors_Handler(uint8_t bumper_sensor_state)
 {
-    if (dbnc_counter >= 300){
-        printf("Bumper Sensor State: 0x%02X\n", bumper_sensor_state);
-        P8->OUT ^= 0x80;
-        dbnc_counter = 0;
+    // Sample the switches into the Sampler windows until they are released for a full window
+    Sampler_Start();
+
+    if (telemetry_enable)
+    {
+        Telemetry_Send_Bumper(Event_Queue_Get_Timestamp(), bumper_sensor_state);
+    }
+    else
+    {
+        TRACE_INFO(TRACE_FMT_BUMPER_STATE, bumper_sensor_state, 0);
+        TRACE_DEBUG(TRACE_FMT_BUMPER_TIME, Event_Queue_Get_Timestamp(), 0);
     }
 }
 
+/**
+ * @brief Toggles the state of the back right red LED (P8.7) for each bumper sensor event.
+ *
+ * This handler is subscribed through the Event_Subscribers table below, so it is registered at compile time.
+ *
+ * @param bumper_sensor_state An 8-bit unsigned integer representing the bump sensor states at the time of the interrupt.
+ *
+ * @return None
+ */
+void Bumper_Sensors_LED_Handler(uint8_t bumper_sensor_state)
+{
+    GPIO_Pin_Toggle(P8, 7);
+}
+
+// Subscribers that are registered at compile time (stored in flash)
+static const Event_Subscriber Event_Subscribers[] =
+{
+    { EVENT_SOURCE_BUMPER_SENSORS, BUMPER_SENSORS_RIGHT_PINS | BUMPER_SENSORS_LEFT_PINS, &Bumper_Sensors_LED_Handler }
+};
+
 /**
  * @brief PMOD BTN handler function.
  *
- * This function is the handler for the PMOD BTN interrupts. It is called when a button press event is
- * detected on the PMOD buttons. Depending on the state of the button(s) pressed, this function performs various actions
- * such as updating the counter for the PMOD 8LD module, setting the enable flag for SysTick_Handler, or toggling
+ * This function is the handler for the PMOD BTN events. It is called from Event_Queue_Dispatch in the main loop
+ * for each button press event that was detected on the PMOD buttons. Depending on the state of the button(s) pressed, this function performs various actions
+ * such as updating the counter for the PMOD 8LD module, setting the enable flag for the LED toggle tasks, or toggling
  * the state of the back right red LED (P8.7).
  *
  * @param pmod_btn_state An 8-bit unsigned integer representing the state of the PMOD buttons at the time of the interrupt.
  *                       Each bit corresponds to a specific button: Bit 0 for BTN0, Bit 1 for BTN1, Bit 2 for BTN2, and Bit 3 for BTN3.
  *                       A bit value of 1 indicates the button is pressed, and 0 indicates it is released.
  *
- *  button_status      PMOD 8 LED          SysTick Enable
- *  -------------      -----------        -----------------
+ *  pressed button     PMOD 8 LED          SysTick Enable
+ *  --------------     -----------        -----------------
  *      0x1              Count Up            Unaffected
  *      0x2              Count Down          Unaffected
  *      0x4              Reset (0s)           Disabled
@@ -146,7 +244,14 @@ void Bumper_Sensors_Handler(uint8_t bumper_sensor_state)
  */
 void PMOD_BTN_Handler(uint8_t pmod_btn_state)
 {
-    switch(pmod_btn_state)
+    // Each event is generated by one push button, and only its press has an action
+    // The release events (see PMOD_BTN_Set_Both_Edges) have a level of 0 and are only logged
+    uint8_t pressed_button = Event_Queue_Get_Pins() & Event_Queue_Get_Levels();
+
+    // Sample the buttons into the Sampler windows until they are released for a full window
+    Sampler_Start();
+
+    switch(pressed_button)
     {
         // PMOD BTN0 is pressed
         case 0x01:
@@ -168,6 +273,7 @@ void PMOD_BTN_Handler(uint8_t pmod_btn_state)
         case 0x04:
         {
             SysTick_enable = 0;
+            SysTick_Enable_Update();
             PMOD_BTN_counter = 0;
             PMOD_8LD_Output(PMOD_BTN_counter);
             break;
@@ -177,6 +283,7 @@ void PMOD_BTN_Handler(uint8_t pmod_btn_state)
         case 0x08:
         {
             SysTick_enable ^= 0x01;
+            SysTick_Enable_Update();
             PMOD_BTN_counter = 0xAA;
             PMOD_8LD_Output(PMOD_BTN_counter);
             break;
@@ -188,15 +295,524 @@ void PMOD_BTN_Handler(uint8_t pmod_btn_state)
         }
     }
 
-    printf("PMOD BTN State: 0x%02X\n", pmod_btn_state);
-    printf("PMOD BTN Counter: %d\n", PMOD_BTN_counter);
+    if (telemetry_enable)
+    {
+        Telemetry_Send_PMOD_BTN(Event_Queue_Get_Timestamp(), pmod_btn_state, PMOD_BTN_counter);
+    }
+    else
+    {
+        TRACE_INFO(TRACE_FMT_PMOD_BTN_STATE, pmod_btn_state, 0);
+        TRACE_INFO(TRACE_FMT_PMOD_BTN_COUNTER, PMOD_BTN_counter, 0);
+        TRACE_DEBUG(TRACE_FMT_PMOD_BTN_TIME, Event_Queue_Get_Timestamp(), 0);
+    }
 }
 
+/**
+ * @brief Shell command that shows or changes the period of an LED toggle task.
+ *
+ * Usage: rate <led1|back|front> [period_ms]
+ *
+ * @return None
+ */
+void Rate_Command(int argc, char *argv[])
+{
+    int8_t task_id = -1;
+    uint32_t period_ms;
+
+    if (argc >= 2)
+    {
+        if (strcmp(argv[1], "led1") == 0) task_id = LED1_toggle_task_id;
+        else if (strcmp(argv[1], "back") == 0) task_id = back_left_LED_toggle_task_id;
+        else if (strcmp(argv[1], "front") == 0) task_id = front_LEDs_toggle_task_id;
+    }
+
+    if (task_id < 0)
+    {
+        printf("Usage: rate <led1|back|front> [period_ms]\n");
+        return;
+    }
+
+    if (argc >= 3)
+    {
+        if ((Shell_Parse_UInt(argv[2], &period_ms) == 0) || (period_ms == 0))
+        {
+            printf("Invalid period: %s\n", argv[2]);
+            return;
+        }
+        Scheduler_Set_Period(task_id, SysTick_Interrupt_Ms_To_Ticks(period_ms));
+    }
+
+    printf("%s period: %u ms\n", argv[1], SysTick_Interrupt_Ticks_To_Ms(Scheduler_Get_Period(task_id)));
+}
+
+/**
+ * @brief Shell command that shows or changes the debounce window of a Bumper Sensor or PMOD BTN pin.
+ *
+ * Usage: debounce <p4|p6> <pin> [window_ms]
+ *
+ * @return None
+ */
+void Debounce_Command(int argc, char *argv[])
+{
+    Debounce_Port port = DEBOUNCE_NUM_PORTS;
+    uint32_t pin;
+    uint32_t window_ms;
+
+    if (argc >= 2)
+    {
+        if (strcmp(argv[1], "p4") == 0) port = DEBOUNCE_PORT_P4;
+        else if (strcmp(argv[1], "p6") == 0) port = DEBOUNCE_PORT_P6;
+    }
+
+    if ((port == DEBOUNCE_NUM_PORTS) || (argc < 3) || (Shell_Parse_UInt(argv[2], &pin) == 0) || (pin > 7))
+    {
+        printf("Usage: debounce <p4|p6> <pin> [window_ms]\n");
+        return;
+    }
+
+    if (argc >= 4)
+    {
+        if ((Shell_Parse_UInt(argv[3], &window_ms) == 0) || (window_ms > DEBOUNCE_MAX_WINDOW_MS))
+        {
+            printf("Invalid window: %s\n", argv[3]);
+            return;
+        }
+        Debounce_Set_Window(port, (uint8_t)pin, (uint16_t)window_ms);
+    }
+
+    printf("%s.%u debounce window: %u ms\n", argv[1], pin, Debounce_Get_Window(port, (uint8_t)pin));
+}
+
+/**
+ * @brief Shell command that selects whether the Bumper Sensors or the PMOD BTN report both the press and the release.
+ *
+ * Usage: edges <p4|p6> <both|press>
+ *
+ * @return None
+ */
+void Edges_Command(int argc, char *argv[])
+{
+    uint8_t both_edges;
+
+    if ((argc >= 3) && (strcmp(argv[2], "both") == 0)) both_edges = 1;
+    else if ((argc >= 3) && (strcmp(argv[2], "press") == 0)) both_edges = 0;
+    else
+    {
+        printf("Usage: edges <p4|p6> <both|press>\n");
+        return;
+    }
+
+    if (strcmp(argv[1], "p4") == 0) Bumper_Sensors_Set_Both_Edges(both_edges);
+    else if (strcmp(argv[1], "p6") == 0) PMOD_BTN_Set_Both_Edges(both_edges);
+    else
+    {
+        printf("Usage: edges <p4|p6> <both|press>\n");
+        return;
+    }
+
+    printf("%s events: %s\n", argv[1], argv[2]);
+}
+
+/**
+ * @brief Shell command that shows or changes the run-time level of the Trace driver.
+ *
+ * Usage: log [0-4] (0 = none, 1 = error, 2 = warn, 3 = info, 4 = debug)
+ *
+ * @return None
+ */
+void Log_Command(int argc, char *argv[])
+{
+    uint32_t level;
+
+    if (argc >= 2)
+    {
+        if ((Shell_Parse_UInt(argv[1], &level) == 0) || (level > TRACE_LEVEL_DEBUG))
+        {
+            printf("Usage: log [0-4]\n");
+            return;
+        }
+        Trace_Set_Level((uint8_t)level);
+    }
+
+    printf("Log level: %u\n", Trace_Get_Level());
+}
+
+/**
+ * @brief Shell command that selects binary Telemetry records or text for the event handlers.
+ *
+ * Usage: telem <on|off>
+ *
+ * @note The records can be decoded with tools/telemetry_decoder.py.
+ *
+ * @return None
+ */
+void Telem_Command(int argc, char *argv[])
+{
+    if ((argc >= 2) && (strcmp(argv[1], "on") == 0))
+    {
+        telemetry_enable = 0x01;
+        Trace_Set_Output(TRACE_OUTPUT_TELEMETRY);
+    }
+    else if ((argc >= 2) && (strcmp(argv[1], "off") == 0))
+    {
+        telemetry_enable = 0x00;
+        Trace_Set_Output(TRACE_OUTPUT_TEXT);
+    }
+    else
+    {
+        printf("Usage: telem <on|off>\n");
+        return;
+    }
+
+    printf("Telemetry: %s\n", argv[1]);
+}
+
+/**
+ * @brief Shell command that selects the low-power mode used by Tickless_Idle.
+ *
+ * Usage: idle <lpm0|lpm3>
+ *
+ * @note EUSCI_A0 cannot receive characters in LPM3, so Tickless_Idle uses LPM0 while the receive interrupt of the Shell is enabled.
+ *       LPM3 is only entered by an application that disables the receiver with EUSCI_A0_UART_Set_RX_Enable.
+ *
+ * @return None
+ */
+void Idle_Command(int argc, char *argv[])
+{
+    if ((argc >= 2) && (strcmp(argv[1], "lpm0") == 0))
+    {
+        Tickless_Idle_Set_Mode(TICKLESS_IDLE_MODE_LPM0);
+    }
+    else if ((argc >= 2) && (strcmp(argv[1], "lpm3") == 0))
+    {
+        Tickless_Idle_Set_Mode(TICKLESS_IDLE_MODE_LPM3);
+    }
+    else
+    {
+        printf("Usage: idle <lpm0|lpm3>\n");
+        return;
+    }
+
+    printf("Idle mode: %s\n", argv[1]);
+
+    if ((strcmp(argv[1], "lpm3") == 0) && EUSCI_A0_UART_RX_Enabled())
+    {
+        printf("LPM0 is used while the UART receiver is enabled\n");
+    }
+}
+
+/**
+ * @brief Shell command that changes the duty cycle of the RGB LEDs or the period of their PWM signal (TIMER_A1).
+ *
+ * Usage: pwm <red|green|blue> <duty_permille>
+ *        pwm period <period_us>
+ *
+ * @note Periods longer than TIMER_A_PWM_MAX_SMCLK_PERIOD_US (at 12 MHz) use ACLK, so the LEDs keep blinking in LPM3.
+ *
+ * @return None
+ */
+void PWM_Command(int argc, char *argv[])
+{
+    Timer_A_PWM_Output output = TIMER_A_PWM_NUM_OUTPUTS;
+    uint32_t value;
+
+    if ((argc < 3) || (Shell_Parse_UInt(argv[2], &value) == 0))
+    {
+        printf("Usage: pwm <red|green|blue> <duty_permille> | pwm period <period_us>\n");
+        return;
+    }
+
+    if (strcmp(argv[1], "period") == 0)
+    {
+        if ((value == 0) || (value > TIMER_A_PWM_MAX_PERIOD_US))
+        {
+            printf("Invalid period: %s\n", argv[2]);
+            return;
+        }
+        if (Timer_A_PWM_Init(TIMER_A_PWM_TA1, value) != 0)
+        {
+            printf("TIMER_A1 is used by the Timer_A_Interrupt driver\n");
+            return;
+        }
+        printf("PWM period: %u us\n", Timer_A_PWM_Get_Period(TIMER_A_PWM_TA1));
+        return;
+    }
+
+    if (strcmp(argv[1], "red") == 0) output = TIMER_A_PWM_LED2_RED;
+    else if (strcmp(argv[1], "green") == 0) output = TIMER_A_PWM_LED2_GREEN;
+    else if (strcmp(argv[1], "blue") == 0) output = TIMER_A_PWM_LED2_BLUE;
+
+    if ((output == TIMER_A_PWM_NUM_OUTPUTS) || (value > TIMER_A_PWM_DUTY_MAX))
+    {
+        printf("Usage: pwm <red|green|blue> <duty_permille> | pwm period <period_us>\n");
+        return;
+    }
+
+    Timer_A_PWM_Enable_Output(output, (uint16_t)value);
+    printf("%s duty: %u/%u\n", argv[1], Timer_A_PWM_Get_Duty(output), TIMER_A_PWM_DUTY_MAX);
+}
+
+/**
+ * @brief Shell command that prints the clock frequency or switches to another clock profile.
+ *
+ * Usage: clock [48|24|12|3]
+ *
+ * @note The transmission of the previous output is completed first, since EUSCI_A0 changes its baud rate
+ *       when SMCLK changes (in the 3 MHz profile).
+ *
+ * @return None
+ */
+void Clock_Command(int argc, char *argv[])
+{
+    static const uint32_t profile_mhz[CLOCK_NUM_PROFILES] = { 48, 24, 12, 3 };
+    uint32_t mhz;
+
+    if (argc >= 2)
+    {
+        Clock_Profile profile = CLOCK_NUM_PROFILES;
+
+        if (Shell_Parse_UInt(argv[1], &mhz))
+        {
+            for (uint8_t i = 0; i < CLOCK_NUM_PROFILES; i++)
+            {
+                if (profile_mhz[i] == mhz) profile = (Clock_Profile)i;
+            }
+        }
+
+        if (profile == CLOCK_NUM_PROFILES)
+        {
+            printf("Usage: clock [48|24|12|3]\n");
+            return;
+        }
+
+        while (EUSCI_A0_UART_TX_Busy());
+
+        if (Clock_SetProfile(profile) != 0)
+        {
+            printf("Clock switch failed\n");
+        }
+    }
+
+    printf("MCLK: %u Hz, SMCLK: %u Hz\n", Clock_GetFreq(), Clock_GetSMCLKFreq());
+}
+
+/**
+ * @brief Applies the current value of a setting of the Config driver to the driver that uses it.
+ *
+ * The SysTick settings are only used by SysTick_Interrupt_Init, so they are applied after a reset.
+ *
+ * @return None
+ */
+void Config_Apply(Config_Key key)
+{
+    uint32_t value = Config_Get(key);
+
+    switch (key)
+    {
+        case CONFIG_KEY_SYSTICK_TOGGLE_RATE_MS:
+            Scheduler_Set_Period(LED1_toggle_task_id, SysTick_Interrupt_Ms_To_Ticks(value));
+            break;
+
+        case CONFIG_KEY_SYSTICK_2S_TOGGLE_RATE_MS:
+            Scheduler_Set_Period(back_left_LED_toggle_task_id, SysTick_Interrupt_Ms_To_Ticks(value));
+            break;
+
+        case CONFIG_KEY_BUMPER_SENSORS_DEBOUNCE_MS:
+        case CONFIG_KEY_PMOD_BTN_DEBOUNCE_MS:
+        {
+            Debounce_Port port = (key == CONFIG_KEY_BUMPER_SENSORS_DEBOUNCE_MS) ? DEBOUNCE_PORT_P4 : DEBOUNCE_PORT_P6;
+            uint8_t pin_mask = (key == CONFIG_KEY_BUMPER_SENSORS_DEBOUNCE_MS) ? (BUMPER_SENSORS_RIGHT_PINS | BUMPER_SENSORS_LEFT_PINS) : 0x0F;
+
+            for (uint8_t pin = 0; pin < 8; pin++)
+            {
+                if (pin_mask & (1 << pin))
+                {
+                    Debounce_Set_Window(port, pin, (uint16_t)value);
+                }
+            }
+            break;
+        }
+
+        default:
+            printf("%s is applied after a reset\n", Config_Get_Name(key));
+            break;
+    }
+}
+
+/**
+ * @brief Shell command that lists, changes, or stores the settings of the Config driver.
+ *
+ * A new value is applied immediately (see Config_Apply), and it is kept after a reset once "config save" is entered.
+ *
+ * Usage: config [name [value]|save|defaults]
+ *
+ * @return None
+ */
+void Config_Command(int argc, char *argv[])
+{
+    Config_Key key;
+    uint32_t value;
+
+    if (argc < 2)
+    {
+        for (key = (Config_Key)0; key < CONFIG_NUM_KEYS; key++)
+        {
+            printf("%s: %u\n", Config_Get_Name(key), Config_Get(key));
+        }
+        return;
+    }
+
+    if (strcmp(argv[1], "save") == 0)
+    {
+        if (Config_Save() == 0)
+        {
+            printf("Settings saved\n");
+        }
+        else
+        {
+            printf("The settings could not be saved\n");
+        }
+        return;
+    }
+
+    if (strcmp(argv[1], "defaults") == 0)
+    {
+        Config_Reset_Defaults();
+        for (key = (Config_Key)0; key < CONFIG_NUM_KEYS; key++)
+        {
+            Config_Apply(key);
+        }
+        printf("Default settings restored (enter \"config save\" to keep them)\n");
+        return;
+    }
+
+    key = Config_Find_Key(argv[1]);
+
+    if (key == CONFIG_NUM_KEYS)
+    {
+        printf("Usage: config [name [value]|save|defaults]\n");
+        return;
+    }
+
+    if (argc >= 3)
+    {
+        uint32_t min;
+        uint32_t max;
+
+        Config_Get_Range(key, 0, &min, &max);
+
+        if ((Shell_Parse_UInt(argv[2], &value) == 0) || (Config_Set(key, value) != 0))
+        {
+            printf("Invalid value: %s (%u - %u)\n", argv[2], min, max);
+            return;
+        }
+        Config_Apply(key);
+    }
+
+    printf("%s: %u\n", argv[1], Config_Get(key));
+}
+
+/**
+ * @brief Shell command that prints the features of the Sampler window of the Bumper Sensors or the PMOD BTN.
+ *
+ * Usage: sample <bump|btn>
+ *
+ * @return None
+ */
+void Sample_Command(int argc, char *argv[])
+{
+    int8_t input = -1;
+    uint8_t num_pins = 0;
+    Sampler_Features features;
+
+    if (argc >= 2)
+    {
+        if (strcmp(argv[1], "bump") == 0)
+        {
+            input = bumper_sensors_sampler_id;
+            num_pins = 6;
+        }
+        else if (strcmp(argv[1], "btn") == 0)
+        {
+            input = pmod_btn_sampler_id;
+            num_pins = 4;
+        }
+    }
+
+    if (input < 0)
+    {
+        printf("Usage: sample <bump|btn>\n");
+        return;
+    }
+
+    if (Sampler_Get_Features(input, &features) != 0)
+    {
+        printf("No samples yet (the inputs are sampled after a press)\n");
+        return;
+    }
+
+    // The features are in ticks, and the tick period can be changed with the Config driver
+    uint32_t ms_per_1000_ticks = SysTick_Interrupt_Ticks_To_Ms(1000);
+
+    printf("state: 0x%02X, window: %u samples (%u ms), changes per s: %u, sampling: %s\n", features.state,
+           features.sample_count, SysTick_Interrupt_Ticks_To_Ms(features.window_ticks),
+           (ms_per_1000_ticks > 0) ? ((features.changes_per_1000_ticks * 1000) / ms_per_1000_ticks) : 0,
+           Sampler_Is_Running() ? "on" : "off");
+
+    for (uint8_t pin = 0; pin < num_pins; pin++)
+    {
+        printf("  %u: hits %u, hold %u ms\n", pin, features.hit_counts[pin], SysTick_Interrupt_Ticks_To_Ms(features.hold_ticks[pin]));
+    }
+}
+
+#if ISR_PROFILER_ENABLE
+/**
+ * @brief Shell command that prints or resets the statistics of the ISR_Profiler.
+ *
+ * Usage: prof [reset]
+ *
+ * @return None
+ */
+void Prof_Command(int argc, char *argv[])
+{
+    if ((argc >= 2) && (strcmp(argv[1], "reset") == 0))
+    {
+        ISR_Profiler_Reset();
+        return;
+    }
+
+    if (telemetry_enable)
+    {
+        ISR_Profiler_Stats stats;
+
+        for (uint8_t irq = 0; irq < ISR_PROFILER_NUM_IRQS; irq++)
+        {
+            ISR_Profiler_Get_Stats((ISR_Profiler_IRQ)irq, &stats);
+            Telemetry_Send_Profiler(SysTick_Interrupt_Get_Ticks(), (ISR_Profiler_IRQ)irq, &stats);
+        }
+        return;
+    }
+
+    ISR_Profiler_Print();
+}
+#endif
+
 int main()
 {
     // Initialize the 48 MHz Clock
     Clock_Init48MHz();
 
+    // Enable the DWT cycle counter used by the Delay functions
+    Delay_Init();
+
+    // Load the settings stored in flash, which are used by the drivers initialized below
+    Config_Init();
+
+#if ISR_PROFILER_ENABLE
+    // Enable the DWT cycle counter used to measure the interrupt handlers
+    ISR_Profiler_Init();
+#endif
+
     // Initialize the built-in red LED and the RGB LEDs
     LED1_Init();
     LED2_Init();
@@ -204,12 +820,22 @@ int main()
     // Initialize the back left and right LEDs (P8.7 and P8.6) as output GPIO pins
     P8_Init();
 
+    // Blink the green RGB LED (P2.1) with TIMER_A1, which uses ACLK for this period and keeps running in LPM3
+    Timer_A_PWM_Init(TIMER_A_PWM_TA1, RGB_LED_BLINK_PERIOD_US);
+    Timer_A_PWM_Enable_Output(TIMER_A_PWM_LED2_GREEN, RGB_LED_BLINK_DUTY);
+
     // Initialize the SysTick timer which will be used to generate periodic interrupts
-    SysTick_Interrupt_Init(SYSTICK_INT_NUM_CLK_CYCLES, SYSTICK_INT_PRIORITY);
+    SysTick_Interrupt_Init(Config_Values.systick_num_clk_cycles, Config_Values.systick_priority);
+
+    // Initialize the microsecond time base, which uses SysTick and the clock frequency
+    Time_Init();
 
     // Initialize the bumper sensors which will be used to generate external I/O-triggered interrupts
     Bumper_Sensors_Init(&Bumper_Sensors_Handler);
 
+    // Register the event subscribers that are stored in flash
+    Event_Queue_Register_Static_Table(Event_Subscribers, sizeof(Event_Subscribers) / sizeof(Event_Subscribers[0]));
+
     // Initialize the PMOD 8LD module
     PMOD_8LD_Init();
 
@@ -219,14 +845,77 @@ int main()
     // Initialize EUSCI_A0_UART
     EUSCI_A0_UART_Init_Printf();
 
+    // Register the periodic LED toggle tasks with the Scheduler
+    // The first toggle of each task occurs one full period after the task is registered
+    // The periods are in ms, and a tick lasts Config_Values.systick_num_clk_cycles clock cycles, so they are converted to ticks
+    Scheduler_Init();
+    LED1_toggle_task_id = Scheduler_Add_Task(&LED1_Toggle_Task, SysTick_Interrupt_Ms_To_Ticks(Config_Values.systick_toggle_rate_ms),
+                                             SysTick_Interrupt_Ms_To_Ticks(Config_Values.systick_toggle_rate_ms));
+    back_left_LED_toggle_task_id = Scheduler_Add_Task(&Back_Left_LED_Toggle_Task, SysTick_Interrupt_Ms_To_Ticks(Config_Values.systick_2s_toggle_rate_ms),
+                                                      SysTick_Interrupt_Ms_To_Ticks(Config_Values.systick_2s_toggle_rate_ms));
+    front_LEDs_toggle_task_id = Scheduler_Add_Task(&Front_LEDs_Toggle_Task, SysTick_Interrupt_Ms_To_Ticks(FRONT_LEDS_TOGGLE_RATE_MS), 0);
+
+    // Sample the bumper switches and the PMOD BTN push buttons from the main loop into the windows of the Sampler
+    // Sampling is started by the bumper and PMOD BTN events and stops when they are idle, so LPM3 stays reachable
+    Sampler_Init();
+    // The periods are converted to ticks, since the tick period is set by Config_Values.systick_num_clk_cycles
+    bumper_sensors_sampler_id = Sampler_Add_Input(&Bumper_Read, 0x3F, SysTick_Interrupt_Ms_To_Ticks(BUMPER_SENSORS_SAMPLE_PERIOD_MS));
+    pmod_btn_sampler_id = Sampler_Add_Input(&PMOD_BTN_Read, 0x0F, SysTick_Interrupt_Ms_To_Ticks(PMOD_BTN_SAMPLE_PERIOD_MS));
+
+    // Register the commands that can be entered in the serial terminal
+    Shell_Register_Command("rate", "rate <led1|back|front> [period_ms]", &Rate_Command);
+    Shell_Register_Command("debounce", "debounce <p4|p6> <pin> [window_ms]", &Debounce_Command);
+    Shell_Register_Command("edges", "edges <p4|p6> <both|press>", &Edges_Command);
+    Shell_Register_Command("log", "log [0-4]", &Log_Command);
+    Shell_Register_Command("telem", "telem <on|off>", &Telem_Command);
+    Shell_Register_Command("idle", "idle <lpm0|lpm3>", &Idle_Command);
+    Shell_Register_Command("pwm", "pwm <red|green|blue> <duty_permille> | pwm period <period_us>", &PWM_Command);
+    Shell_Register_Command("clock", "clock [48|24|12|3]", &Clock_Command);
+    Shell_Register_Command("config", "config [name [value]|save|defaults]", &Config_Command);
+    Shell_Register_Command("sample", "sample <bump|btn>", &Sample_Command);
+#if ISR_PROFILER_ENABLE
+    Shell_Register_Command("prof", "prof [reset]", &Prof_Command);
+#endif
+    Shell_Init();
+
+    // Stop the 1 ms SysTick interrupt while sleeping until the next task deadline
+    // LPM0 is used so that EUSCI_A0 can receive commands while sleeping (use "idle lpm3" for the lowest power)
+    Tickless_Idle_Init(TICKLESS_IDLE_MODE_LPM0);
+
     // Enable the interrupts used by the SysTick timer and the GPIO pins used by the Bumper Sensors and the PMOD BTN module
-    EnableInterrupts();
+    CortexM_Enable_Interrupts();
 
     while(1)
     {
-        // Toggle front yellow LEDs every second in the main thread
-        P8->OUT ^= 0x01;
-        P8->OUT ^= 0x20;
-        Clock_Delay1ms(1000);
+        // Call the handlers of the events pushed by PORT4_IRQHandler and PORT6_IRQHandler
+        Event_Queue_Dispatch();
+
+        // Run the tasks that have reached their deadline
+        Scheduler_Run();
+
+        // Run the command entered in the serial terminal, if a complete line has been received
+        Shell_Run();
+
+        // Print the oldest trace entries
+        Trace_Process(TRACE_ENTRIES_PER_LOOP);
+
+        // Sleep until the next task deadline or interrupt if there are no events to handle, no tasks are due,
+        // no characters have been received, and no trace entries are waiting
+        // Interrupts are disabled while checking so that an event cannot be missed before WFI.
+        // WFI still wakes up on a pending interrupt while interrupts are disabled.
+        CortexM_Disable_Interrupts();
+        if (Event_Queue_Is_Empty() && !Scheduler_Is_Task_Due() && (EUSCI_A0_UART_RX_Available() == 0) && Trace_Is_Empty())
+        {
+            uint32_t next_deadline;
+            if (Scheduler_Get_Next_Deadline(&next_deadline))
+            {
+                Tickless_Idle_Sleep(next_deadline - SysTick_Interrupt_Get_Ticks());
+            }
+            else
+            {
+                CortexM_Wait_For_Interrupt();
+            }
+        }
+        CortexM_Enable_Interrupts();
     }
 }
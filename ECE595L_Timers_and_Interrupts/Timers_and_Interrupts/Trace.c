@@ -0,0 +1,133 @@
+/**
+ * @file Trace.c
+ * @brief Source code for the Trace driver.
+ *
+ * This file contains the function definitions for the Trace driver.
+ * Entries are stored in a ring buffer by Trace_Post and expanded from the main loop by Trace_Process.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include <stdio.h>
+#include "../inc/Trace.h"
+#include "../inc/Telemetry.h"
+#include "../inc/SysTick_Interrupt.h"
+#include "../inc/Critical_Section.h"
+
+// Mask used to wrap the ring buffer indices
+#define TRACE_BUFFER_MASK (TRACE_BUFFER_SIZE - 1)
+
+typedef struct
+{
+    uint8_t id;
+    uint8_t level;
+    uint32_t timestamp;
+    uint32_t args[2];
+} Trace_Entry;
+
+// trace_head is written by Trace_Post (in a critical section, since any handler can post),
+// trace_tail is only written by Trace_Process
+static Trace_Entry trace_buffer[TRACE_BUFFER_SIZE];
+static volatile uint32_t trace_head = 0;
+static volatile uint32_t trace_tail = 0;
+
+static volatile uint32_t trace_overflow_count = 0;
+
+static uint8_t trace_level = TRACE_LEVEL_INFO;
+static Trace_Output trace_output = TRACE_OUTPUT_TEXT;
+
+// Format strings generated from TRACE_FORMATS
+#define TRACE_FORMAT_STRING(id, format) format,
+static const char * const trace_formats[TRACE_NUM_FORMATS] =
+{
+    TRACE_FORMATS(TRACE_FORMAT_STRING)
+};
+#undef TRACE_FORMAT_STRING
+
+void Trace_Post(uint8_t level, Trace_Format id, uint32_t arg0, uint32_t arg1)
+{
+    if (level > trace_level) return;
+
+    // The entry is written before trace_head is moved, so several handlers with different priorities
+    // can post without using the same entry
+    uint32_t sr = Critical_Section_Enter();
+
+    uint32_t head = trace_head;
+
+    if ((head - trace_tail) >= TRACE_BUFFER_SIZE)
+    {
+        trace_overflow_count++;
+    }
+    else
+    {
+        Trace_Entry *entry = &trace_buffer[head & TRACE_BUFFER_MASK];
+        entry->id = (uint8_t)id;
+        entry->level = level;
+        entry->timestamp = SysTick_Interrupt_Ticks;
+        entry->args[0] = arg0;
+        entry->args[1] = arg1;
+        trace_head = head + 1;
+    }
+
+    Critical_Section_Exit(sr);
+}
+
+void Trace_Set_Level(uint8_t level)
+{
+    trace_level = (level > TRACE_LEVEL_DEBUG) ? TRACE_LEVEL_DEBUG : level;
+}
+
+uint8_t Trace_Get_Level()
+{
+    return trace_level;
+}
+
+void Trace_Set_Output(Trace_Output output)
+{
+    trace_output = output;
+}
+
+uint32_t Trace_Process(uint32_t max_entries)
+{
+    uint32_t count = 0;
+
+    while ((count < max_entries) && (trace_tail != trace_head))
+    {
+        Trace_Entry entry = trace_buffer[trace_tail & TRACE_BUFFER_MASK];
+        trace_tail++;
+        count++;
+
+        if (entry.id >= TRACE_NUM_FORMATS) continue;
+
+        if (trace_output == TRACE_OUTPUT_TELEMETRY)
+        {
+            // Payload: format ID (1 byte), level (1 byte), arguments (4 bytes each, little-endian)
+            uint8_t payload[10];
+            payload[0] = entry.id;
+            payload[1] = entry.level;
+            for (uint8_t i = 0; i < 8; i++)
+            {
+                payload[2 + i] = (uint8_t)(entry.args[i >> 2] >> ((i & 3) * 8));
+            }
+            Telemetry_Send(TELEMETRY_TYPE_TRACE, entry.timestamp, payload, 10);
+        }
+        else
+        {
+            printf(trace_formats[entry.id], entry.args[0], entry.args[1]);
+            printf("\n");
+        }
+    }
+
+    return count;
+}
+
+uint8_t Trace_Is_Empty()
+{
+    return (trace_tail == trace_head) ? 1 : 0;
+}
+
+uint32_t Trace_Overflow_Count()
+{
+    return trace_overflow_count;
+}
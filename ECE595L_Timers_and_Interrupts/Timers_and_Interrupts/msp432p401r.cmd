@@ -40,7 +40,10 @@
 
 MEMORY
 {
-    MAIN       (RX) : origin = 0x00000000, length = 0x00040000
+    /* The last two sectors of bank 1 hold the settings of the Config      */
+    /* driver (Config.h), so they are not used by the linker.               */
+    MAIN       (RX) : origin = 0x00000000, length = 0x0003E000
+    CONFIG     (R)  : origin = 0x0003E000, length = 0x00002000
     INFO       (RX) : origin = 0x00200000, length = 0x00004000
 #ifdef  __TI_COMPILER_VERSION__
 #if     __TI_COMPILER_VERSION__ >= 15009000
@@ -102,7 +105,12 @@ SECTIONS
 
 #ifdef  __TI_COMPILER_VERSION__
 #if     __TI_COMPILER_VERSION__ >= 15009000
-    .TI.ramfunc : {} load=MAIN, run=SRAM_CODE, table(BINIT)
+    /* The functions marked with RAM_FUNCTION (RAM_Function.h) are copied   */
+    /* from flash to SRAM by Reset_Handler (startup_msp432p401r_ccs.c), with */
+    /* the symbols below, so they run without the flash wait states.        */
+    .TI.ramfunc : palign(4) {} load=MAIN, run=SRAM_CODE,
+                  LOAD_START(__ramfunc_load_start), RUN_START(__ramfunc_run_start),
+                  SIZE(__ramfunc_size)
 #endif
 #endif
 }
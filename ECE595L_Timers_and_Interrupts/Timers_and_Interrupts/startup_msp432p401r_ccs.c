@@ -46,6 +46,12 @@ extern void _c_int00(void);
 /* External declaration for system initialization function                  */
 extern void SystemInit(void);
 
+/* Linker symbols of the .TI.ramfunc section (see msp432p401r.cmd). The      */
+/* section is loaded in flash and runs from SRAM_CODE.                       */
+extern uint32_t __ramfunc_load_start;
+extern uint32_t __ramfunc_run_start;
+extern uint32_t __ramfunc_size;
+
 /* Forward declaration of the default fault handlers. */
 void Default_Handler            (void) __attribute__((weak));
 extern void Reset_Handler       (void) __attribute__((weak));
@@ -182,6 +188,18 @@ void Reset_Handler(void)
 {
     SystemInit();
 
+    /* Copy the functions marked with RAM_FUNCTION (RAM_Function.h) from     */
+    /* flash to SRAM before they can be called. The section is padded to a   */
+    /* multiple of 4 bytes, and it is empty when RAM_FUNCTION_ENABLE is 0.   */
+    const uint32_t *ramfunc_load = &__ramfunc_load_start;
+    uint32_t *ramfunc_run = &__ramfunc_run_start;
+    uint32_t ramfunc_words = (uint32_t)&__ramfunc_size / 4;
+
+    while (ramfunc_words--)
+    {
+        *ramfunc_run++ = *ramfunc_load++;
+    }
+
     /* Jump to the CCS C Initialization Routine. */
     __asm("    .global _c_int00\n"
           "    b.w     _c_int00");
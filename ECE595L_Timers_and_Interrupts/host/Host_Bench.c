@@ -0,0 +1,199 @@
+/**
+ * @file Host_Bench.c
+ * @brief Microbenchmarks of the hot functions of the drivers in the host simulation build.
+ *
+ * This program calls each function in a loop and prints one CSV line per benchmark:
+ *
+ *      name,iterations,ns_per_call,sim_cycles_per_call
+ *
+ * ns_per_call is measured on the host with CLOCK_MONOTONIC. It is only used to compare two versions of the C code
+ * of a driver (e.g. before and after a change), since the host CPU, the compiler, and the register mock
+ * are different from the target. sim_cycles_per_call is the simulated time in MCLK cycles, which is only
+ * different from 0 for the functions that read SysTick->VAL or DWT->CYCCNT (see HOST_SIM_READ_CYCLES).
+ * The benchmarks that inject an edge include the time of the simulator to deliver the interrupt.
+ *
+ * Build and run with: make -C host bench
+ * The number of iterations can be passed as the first argument (default HOST_BENCH_ITERATIONS).
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "Host_Sim.h"
+#include "../inc/Clock.h"
+#include "../inc/CortexM.h"
+#include "../inc/Critical_Section.h"
+#include "../inc/SysTick_Interrupt.h"
+#include "../inc/Time.h"
+#include "../inc/EUSCI_A0_UART.h"
+#include "../inc/Event_Queue.h"
+#include "../inc/Bumper_Sensors.h"
+#include "../inc/Debounce.h"
+#include "../inc/Format.h"
+#include "../inc/Telemetry.h"
+#include "../inc/CRC.h"
+
+#define HOST_BENCH_ITERATIONS 1000000
+
+// Results are written here so that the compiler keeps the calls
+static volatile uint32_t host_bench_sink;
+
+static char host_bench_buffer[32];
+static uint8_t host_bench_payload[16] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10 };
+static char host_bench_uart_output[256];
+
+static void Host_Bench_Format_UDec(uint32_t i)
+{
+    host_bench_sink = Format_UDec(host_bench_buffer, 4294967295U - i);
+}
+
+static void Host_Bench_Format_UHex(uint32_t i)
+{
+    host_bench_sink = Format_UHex(host_bench_buffer, 0xDEADBEEF ^ i, 8);
+}
+
+static void Host_Bench_Format_UFix(uint32_t i)
+{
+    host_bench_sink = Format_UFix(host_bench_buffer, 123456 + i, 3);
+}
+
+static void Host_Bench_Telemetry_CRC16(uint32_t i)
+{
+    host_bench_payload[0] = (uint8_t)i;
+    host_bench_sink = Telemetry_CRC16(0xFFFF, host_bench_payload, sizeof(host_bench_payload));
+}
+
+static void Host_Bench_CRC32(uint32_t i)
+{
+    host_bench_payload[0] = (uint8_t)i;
+    host_bench_sink = CRC_Compute(CRC_MODE_CRC32, CRC_CRC32_INITIAL, host_bench_payload, sizeof(host_bench_payload));
+}
+
+static void Host_Bench_Event_Queue_Push_Pop(uint32_t i)
+{
+    Event event;
+
+    Event_Queue_Push(EVENT_SOURCE_BUMPER_SENSORS, 0x01, 0x00, (uint8_t)i);
+    host_bench_sink = Event_Queue_Pop(&event);
+}
+
+static void Host_Bench_Bumper_Read(uint32_t i)
+{
+    host_bench_sink = Bumper_Read();
+}
+
+static void Host_Bench_Critical_Section(uint32_t i)
+{
+    uint32_t sr = Critical_Section_Enter();
+    host_bench_sink = i;
+    Critical_Section_Exit(sr);
+}
+
+static void Host_Bench_Critical_Section_Priority(uint32_t i)
+{
+    uint32_t state = Critical_Section_Enter_Priority(3);
+    host_bench_sink = i;
+    Critical_Section_Exit_Priority(state);
+}
+
+static void Host_Bench_Time_NowUs(uint32_t i)
+{
+    host_bench_sink = (uint32_t)Time_NowUs();
+}
+
+static void Host_Bench_PORT4_Edge(uint32_t i)
+{
+    Event event;
+
+    // Falling edge of BUMP_0 (PORT4_IRQHandler pushes an event), then back to idle
+    Host_Sim_Set_Input(4, 0x01, 0x00);
+    Host_Sim_Set_Input(4, 0x01, 0x01);
+    host_bench_sink = Event_Queue_Pop(&event);
+}
+
+static void Host_Bench_UART_OutUDec(uint32_t i)
+{
+    EUSCI_A0_UART_OutUDec(i);
+
+    // Empty the capture buffer from time to time
+    if ((i & 0xFF) == 0) Host_Sim_UART_Read(host_bench_uart_output, sizeof(host_bench_uart_output));
+}
+
+typedef struct
+{
+    const char *name;
+    void (*function)(uint32_t i);
+} Host_Bench;
+
+static const Host_Bench host_benches[] =
+{
+    { "Format_UDec",                    &Host_Bench_Format_UDec },
+    { "Format_UHex",                    &Host_Bench_Format_UHex },
+    { "Format_UFix",                    &Host_Bench_Format_UFix },
+    { "Telemetry_CRC16_16B",            &Host_Bench_Telemetry_CRC16 },
+    { "CRC_Compute_CRC32_16B",          &Host_Bench_CRC32 },
+    { "Event_Queue_Push_Pop",           &Host_Bench_Event_Queue_Push_Pop },
+    { "Bumper_Read",                    &Host_Bench_Bumper_Read },
+    { "Critical_Section",               &Host_Bench_Critical_Section },
+    { "Critical_Section_Priority",      &Host_Bench_Critical_Section_Priority },
+    { "Time_NowUs",                     &Host_Bench_Time_NowUs },
+    { "PORT4_Edge_IRQ_Pop",             &Host_Bench_PORT4_Edge },
+    { "EUSCI_A0_UART_OutUDec",          &Host_Bench_UART_OutUDec }
+};
+
+static uint64_t Host_Bench_Now_Ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], 0, 0) : HOST_BENCH_ITERATIONS;
+
+    if (iterations == 0) iterations = 1;
+
+    Host_Sim_Reset();
+
+    // The bumper switches are released (pulled up)
+    Host_Sim_Set_Input(4, 0xFF, 0xFF);
+
+    DisableInterrupts();
+    Clock_Init48MHz();
+    EUSCI_A0_UART_Init();
+    SysTick_Interrupt_Init(SYSTICK_INT_NUM_CLK_CYCLES, SYSTICK_INT_PRIORITY);
+    Time_Init();
+    Bumper_Sensors_Init(0);
+
+    // Without a debounce window, every edge of BUMP_0 reaches PORT4_IRQHandler
+    Debounce_Set_Window(DEBOUNCE_PORT_P4, 0, 0);
+    EnableInterrupts();
+
+    printf("name,iterations,ns_per_call,sim_cycles_per_call\n");
+
+    for (uint32_t b = 0; b < (sizeof(host_benches) / sizeof(host_benches[0])); b++)
+    {
+        const Host_Bench *bench = &host_benches[b];
+
+        // Warm up the caches and the branch predictors
+        for (uint32_t i = 0; i < (iterations / 10); i++) bench->function(i);
+
+        uint64_t start_cycles = Host_Sim_Get_Cycles();
+        uint64_t start_ns = Host_Bench_Now_Ns();
+
+        for (uint32_t i = 0; i < iterations; i++) bench->function(i);
+
+        uint64_t elapsed_ns = Host_Bench_Now_Ns() - start_ns;
+        uint64_t elapsed_cycles = Host_Sim_Get_Cycles() - start_cycles;
+
+        printf("%s,%u,%.2f,%.2f\n", bench->name, iterations,
+               (double)elapsed_ns / iterations, (double)elapsed_cycles / iterations);
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file Host_Clock.c
+ * @brief Host simulation version of the Clock driver.
+ *
+ * This file replaces Clock.c in the host simulation build. It keeps the frequencies of the clock profiles
+ * and calls the clock change handlers like Clock.c, without the CS, PCM, and FLCTL registers.
+ * The busy-wait delays advance the simulated time instead of counting loops.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "Host_Sim.h"
+#include "../inc/Clock.h"
+#include "../inc/Critical_Section.h"
+
+uint32_t ClockFrequency = 3000000;
+
+static uint32_t host_clock_smclk = 3000000;
+static Clock_Profile host_clock_profile = CLOCK_PROFILE_3MHZ;
+
+static Clock_Change_Handler host_clock_handlers[CLOCK_MAX_CHANGE_HANDLERS];
+static uint8_t host_clock_num_handlers = 0;
+
+// MCLK and SMCLK of each profile, as in Clock.c
+static const uint32_t host_clock_frequencies[CLOCK_NUM_PROFILES][2] =
+{
+    { 48000000, 12000000 },
+    { 24000000, 12000000 },
+    { 12000000, 12000000 },
+    {  3000000,  3000000 }
+};
+
+void Host_Clock_Reset(void)
+{
+    ClockFrequency = 3000000;
+    host_clock_smclk = 3000000;
+    host_clock_profile = CLOCK_PROFILE_3MHZ;
+}
+
+void Clock_Init48MHz(void)
+{
+    Clock_SetProfile(CLOCK_PROFILE_48MHZ);
+}
+
+int8_t Clock_SetProfile(Clock_Profile profile)
+{
+    if (profile >= CLOCK_NUM_PROFILES) return -1;
+
+    uint32_t sr = Critical_Section_Enter();
+    uint32_t previous_mclk = ClockFrequency;
+    uint32_t previous_smclk = host_clock_smclk;
+
+    ClockFrequency = host_clock_frequencies[profile][0];
+    host_clock_smclk = host_clock_frequencies[profile][1];
+    host_clock_profile = profile;
+    Host_Sim_Clock_Changed();
+
+    for (uint8_t i = 0; i < host_clock_num_handlers; i++)
+    {
+        (*host_clock_handlers[i])(previous_mclk, previous_smclk);
+    }
+
+    Critical_Section_Exit(sr);
+
+    return 0;
+}
+
+Clock_Profile Clock_GetProfile(void)
+{
+    return host_clock_profile;
+}
+
+int8_t Clock_AddChangeHandler(Clock_Change_Handler handler)
+{
+    if (handler == 0) return -1;
+
+    for (uint8_t i = 0; i < host_clock_num_handlers; i++)
+    {
+        if (host_clock_handlers[i] == handler) return 0;
+    }
+
+    if (host_clock_num_handlers >= CLOCK_MAX_CHANGE_HANDLERS) return -1;
+
+    host_clock_handlers[host_clock_num_handlers++] = handler;
+
+    return 0;
+}
+
+uint32_t Clock_GetFreq(void)
+{
+    return ClockFrequency;
+}
+
+uint32_t Clock_GetSMCLKFreq(void)
+{
+    return host_clock_smclk;
+}
+
+void delay(unsigned long ulCount)
+{
+    // One loop of Clock.c takes 3 cycles
+    Host_Sim_Advance_Cycles((uint64_t)ulCount * 3);
+}
+
+void Clock_Delay1us(uint32_t n)
+{
+    Host_Sim_Advance_Cycles((uint64_t)n * (ClockFrequency / 1000000));
+}
+
+void Clock_Delay1ms(uint32_t n)
+{
+    Host_Sim_Advance_Cycles((uint64_t)n * (ClockFrequency / 1000));
+}
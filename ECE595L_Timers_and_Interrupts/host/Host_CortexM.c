@@ -0,0 +1,39 @@
+/**
+ * @file Host_CortexM.c
+ * @brief Host simulation version of CortexM.c.
+ *
+ * This file replaces CortexM.c in the host simulation build, whose functions are written in assembly.
+ * The instructions are emulated by the simulator with the inline functions of CortexM_Inline.h.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include "../inc/CortexM.h"
+#include "../inc/CortexM_Inline.h"
+#include "../inc/Critical_Section.h"
+
+void DisableInterrupts(void)
+{
+    CortexM_Disable_Interrupts();
+}
+
+void EnableInterrupts(void)
+{
+    CortexM_Enable_Interrupts();
+}
+
+long StartCritical(void)
+{
+    return (long)Critical_Section_Enter();
+}
+
+void EndCritical(long sr)
+{
+    Critical_Section_Exit((uint32_t)sr);
+}
+
+void WaitForInterrupt(void)
+{
+    CortexM_Wait_For_Interrupt();
+}
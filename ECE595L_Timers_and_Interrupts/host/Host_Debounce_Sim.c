@@ -0,0 +1,169 @@
+/**
+ * @file Host_Debounce_Sim.c
+ * @brief Host simulation of the bumper switches and PMOD BTN with bouncing edges.
+ *
+ * This program initializes the drivers as in Timers_and_Interrupts_main.c, then injects timed edge sequences
+ * on P4 (bumper switches, falling edges, BUMPER_SENSORS_DEBOUNCE_MS window) and P6 (PMOD BTN, rising edges,
+ * PMOD_BTN_DEBOUNCE_MS window). Each press bounces a few times for less than 1 ms.
+ * BUMP_5 (P4.7) uses the longest window (DEBOUNCE_MAX_WINDOW_MS), and bounces until just before it expires.
+ * The main loop (Event_Queue_Dispatch) prints each event with its simulated time, then the number
+ * of handler calls is printed. The program returns 1 if the number of events is not the expected one.
+ *
+ * Build and run with: make -C host run
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include <stdio.h>
+#include "Host_Sim.h"
+#include "../inc/Clock.h"
+#include "../inc/CortexM.h"
+#include "../inc/SysTick_Interrupt.h"
+#include "../inc/Time.h"
+#include "../inc/EUSCI_A0_UART.h"
+#include "../inc/Event_Queue.h"
+#include "../inc/Bumper_Sensors.h"
+#include "../inc/Debounce.h"
+#include "../inc/PMOD_BTN_Interrupt.h"
+
+// Number of events expected from the sequence
+#define HOST_DEBOUNCE_SIM_BUMPER_EVENTS 4
+#define HOST_DEBOUNCE_SIM_PMOD_BTN_EVENTS 2
+
+#define HOST_DEBOUNCE_SIM_END_US 1600000
+
+static const Host_Sim_Edge host_debounce_sim_edges[] =
+{
+    // BUMP_0 (P4.0) is pressed at 10 ms and bounces for 0.6 ms
+    {  10000, 4, 0x01, 0x00 },
+    {  10150, 4, 0x01, 0x01 },
+    {  10300, 4, 0x01, 0x00 },
+    {  10450, 4, 0x01, 0x01 },
+    {  10600, 4, 0x01, 0x00 },
+
+    // PMOD BTN0 (P6.0) is pressed at 100 ms and bounces for 0.4 ms, then released at 150 ms
+    { 100000, 6, 0x01, 0x01 },
+    { 100200, 6, 0x01, 0x00 },
+    { 100400, 6, 0x01, 0x01 },
+    { 150000, 6, 0x01, 0x00 },
+
+    // PMOD BTN0 is pressed again at 250 ms, after its debounce window
+    { 250000, 6, 0x01, 0x01 },
+    { 250100, 6, 0x01, 0x00 },
+    { 250200, 6, 0x01, 0x01 },
+    { 300000, 6, 0x01, 0x00 },
+
+    // BUMP_0 is released at 200 ms, during its debounce window, and bounces
+    { 200000, 4, 0x01, 0x01 },
+    { 200100, 4, 0x01, 0x00 },
+    { 200200, 4, 0x01, 0x01 },
+
+    // BUMP_0 is pressed again at 800 ms, and BUMP_3 (P4.5) 2 ms later
+    { 800000, 4, 0x01, 0x00 },
+    { 800300, 4, 0x01, 0x01 },
+    { 800500, 4, 0x01, 0x00 },
+    { 802000, 4, 0x20, 0x00 },
+    { 802200, 4, 0x20, 0x20 },
+    { 802400, 4, 0x20, 0x00 },
+
+    // BUMP_5 (P4.7) is pressed at 300 ms with a window of DEBOUNCE_MAX_WINDOW_MS, and bounces until 1250 ms
+    {  300000, 4, 0x80, 0x00 },
+    {  700000, 4, 0x80, 0x80 },
+    {  700100, 4, 0x80, 0x00 },
+    { 1000000, 4, 0x80, 0x80 },
+    { 1000100, 4, 0x80, 0x00 },
+    { 1250000, 4, 0x80, 0x80 },
+    { 1250100, 4, 0x80, 0x00 },
+    { 1400000, 4, 0x80, 0x80 }
+};
+
+static uint32_t host_debounce_sim_bumper_events = 0;
+static uint32_t host_debounce_sim_pmod_btn_events = 0;
+
+static void Host_Debounce_Sim_Bumper_Task(uint8_t bumper_sensor_state)
+{
+    host_debounce_sim_bumper_events++;
+    printf("%8llu us  tick %6u  bumper    pins 0x%02X  state 0x%02X\n",
+           (unsigned long long)Host_Sim_Get_Time_Us(), Event_Queue_Get_Timestamp(), Event_Queue_Get_Pins(), bumper_sensor_state);
+}
+
+static void Host_Debounce_Sim_PMOD_BTN_Task(uint8_t pmod_btn_state)
+{
+    host_debounce_sim_pmod_btn_events++;
+    printf("%8llu us  tick %6u  pmod_btn  pins 0x%02X  state 0x%02X\n",
+           (unsigned long long)Host_Sim_Get_Time_Us(), Event_Queue_Get_Timestamp(), Event_Queue_Get_Pins(), pmod_btn_state);
+}
+
+static void Host_Debounce_Sim_Main_Loop(void)
+{
+    Event_Queue_Dispatch();
+}
+
+/**
+ * @brief Sorts the sequence by time, since the entries are grouped by switch.
+ */
+static void Host_Debounce_Sim_Sort(Host_Sim_Edge *edges, uint16_t count)
+{
+    for (uint16_t i = 1; i < count; i++)
+    {
+        Host_Sim_Edge edge = edges[i];
+        uint16_t j = i;
+
+        while ((j > 0) && (edges[j - 1].time_us > edge.time_us))
+        {
+            edges[j] = edges[j - 1];
+            j--;
+        }
+
+        edges[j] = edge;
+    }
+}
+
+int main(void)
+{
+    Host_Sim_Edge edges[sizeof(host_debounce_sim_edges) / sizeof(host_debounce_sim_edges[0])];
+    uint16_t count = sizeof(host_debounce_sim_edges) / sizeof(host_debounce_sim_edges[0]);
+    char output[64];
+
+    for (uint16_t i = 0; i < count; i++) edges[i] = host_debounce_sim_edges[i];
+    Host_Debounce_Sim_Sort(edges, count);
+
+    Host_Sim_Reset();
+
+    // The bumper switches are pulled up, and the PMOD BTN buttons are pulled down
+    Host_Sim_Set_Input(4, 0xFF, 0xFF);
+    Host_Sim_Set_Input(6, 0xFF, 0x00);
+
+    DisableInterrupts();
+    Clock_Init48MHz();
+    EUSCI_A0_UART_Init();
+    SysTick_Interrupt_Init(SYSTICK_INT_NUM_CLK_CYCLES, SYSTICK_INT_PRIORITY);
+    Time_Init();
+    Bumper_Sensors_Init(&Host_Debounce_Sim_Bumper_Task);
+    PMOD_BTN_Interrupt_Init(&Host_Debounce_Sim_PMOD_BTN_Task);
+    Debounce_Set_Window(DEBOUNCE_PORT_P4, 7, DEBOUNCE_MAX_WINDOW_MS);
+    EnableInterrupts();
+
+    Host_Sim_Run(edges, count, HOST_DEBOUNCE_SIM_END_US, &Host_Debounce_Sim_Main_Loop);
+
+    EUSCI_A0_UART_OutString("UART capture OK\r\n");
+    Host_Sim_UART_Read(output, sizeof(output));
+
+    printf("\nSysTick: %u, PORT4: %u, PORT6: %u, TA2_N: %u interrupts in %llu us\n",
+           Host_Sim_Get_Interrupt_Count(HOST_SIM_SYSTICK_IRQ), Host_Sim_Get_Interrupt_Count(38),
+           Host_Sim_Get_Interrupt_Count(40), Host_Sim_Get_Interrupt_Count(13),
+           (unsigned long long)Host_Sim_Get_Time_Us());
+    printf("Bumper events: %u (expected %u), PMOD BTN events: %u (expected %u), overflows: %u\n",
+           host_debounce_sim_bumper_events, HOST_DEBOUNCE_SIM_BUMPER_EVENTS,
+           host_debounce_sim_pmod_btn_events, HOST_DEBOUNCE_SIM_PMOD_BTN_EVENTS, Event_Queue_Overflow_Count());
+    printf("UART: %s", output);
+
+    if ((host_debounce_sim_bumper_events != HOST_DEBOUNCE_SIM_BUMPER_EVENTS) ||
+        (host_debounce_sim_pmod_btn_events != HOST_DEBOUNCE_SIM_PMOD_BTN_EVENTS))
+    {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,881 @@
+/**
+ * @file Host_Sim.c
+ * @brief Source code for the host simulator of the MSP432 peripherals.
+ *
+ * This file contains the register instances of host/mock/msp.h, the register hooks,
+ * and the simulation of SysTick, Timer_A, the ports, EUSCI_A0, and the NVIC (see Host_Sim.h).
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#include <string.h>
+#include "msp.h"
+#include "file.h"
+#include "Host_Sim.h"
+#include "../inc/Clock.h"
+#include "../inc/SysTick_Interrupt.h"
+
+// IRQ numbers of the simulated peripherals (Table 6-39 of the MSP432P401R datasheet)
+#define HOST_SIM_IRQ_TA0_0      8
+#define HOST_SIM_IRQ_TA3_N      15
+#define HOST_SIM_IRQ_EUSCIA0    16
+#define HOST_SIM_IRQ_PORT1      35
+#define HOST_SIM_IRQ_PORT6      40
+
+// Context of the code that is running
+#define HOST_SIM_THREAD         -2
+
+// Longest time that WFI waits for an interrupt (in MCLK cycles at the current frequency, one second)
+#define HOST_SIM_MAX_SLEEP_CYCLES   ((uint64_t)Clock_GetFreq())
+
+// Priority of the thread mode (lower than all exceptions)
+#define HOST_SIM_THREAD_PRIORITY    0x100
+
+DIO_PORT_Interruptable_Type Host_P1, Host_P2, Host_P3, Host_P4, Host_P5, Host_P6, Host_P7, Host_P8, Host_P9, Host_P10, Host_PJ;
+PMAP_COMMON_Type Host_PMAP;
+PMAP_REGISTER_Type Host_P2MAP;
+EUSCI_A_Type Host_EUSCI_A0;
+Timer_A_Type Host_TIMER_A0, Host_TIMER_A1, Host_TIMER_A2, Host_TIMER_A3;
+Timer32_Type Host_TIMER32_1, Host_TIMER32_2;
+DMA_Channel_Type Host_DMA_Channel;
+DMA_Control_Type Host_DMA_Control;
+CRC32_Type Host_CRC32;
+WDT_A_Type Host_WDT_A;
+SysTick_Type Host_SysTick;
+SCB_Type Host_SCB;
+NVIC_Type Host_NVIC;
+DWT_Type Host_DWT;
+CoreDebug_Type Host_CoreDebug;
+CS_Type Host_CS;
+PCM_Type Host_PCM;
+FLCTL_Type Host_FLCTL;
+
+volatile uint32_t Host_PRIMASK = 0;
+volatile uint32_t Host_BASEPRI = 0;
+
+// Handlers of the simulated interrupts, defined by the drivers
+void SysTick_Handler(void);
+void TA0_0_IRQHandler(void);
+void TA0_N_IRQHandler(void);
+void TA1_0_IRQHandler(void);
+void TA1_N_IRQHandler(void);
+void TA2_N_IRQHandler(void);
+void TA3_0_IRQHandler(void);
+void EUSCIA0_IRQHandler(void);
+void PORT4_IRQHandler(void);
+void PORT6_IRQHandler(void);
+
+// Vector table of the simulated device, indexed by exception number like the one of startup_msp432p401r_ccs.c
+// The handlers are called from this table, or from the table pointed to by SCB->VTOR (see IRQ_Init)
+void (* const interruptVectors[16 + 41])(void) =
+{
+    [15]      = SysTick_Handler,
+    [16 + 8]  = TA0_0_IRQHandler,
+    [16 + 9]  = TA0_N_IRQHandler,
+    [16 + 10] = TA1_0_IRQHandler,
+    [16 + 11] = TA1_N_IRQHandler,
+    [16 + 13] = TA2_N_IRQHandler,
+    [16 + 14] = TA3_0_IRQHandler,
+    [16 + 16] = EUSCIA0_IRQHandler,
+    [16 + 38] = PORT4_IRQHandler,
+    [16 + 40] = PORT6_IRQHandler
+};
+
+// Interrupts that have a handler, in order of exception number (SysTick first)
+static const int16_t host_sim_irqs[] = { HOST_SIM_SYSTICK_IRQ, 8, 9, 10, 11, 13, 14, 16, 38, 40 };
+
+#define HOST_SIM_NUM_HANDLED_IRQS (sizeof(host_sim_irqs) / sizeof(host_sim_irqs[0]))
+
+static DIO_PORT_Interruptable_Type * const host_sim_ports[10] =
+{
+    P1, P2, P3, P4, P5, P6, P7, P8, P9, P10
+};
+
+static Timer_A_Type * const host_sim_timers[4] =
+{
+    TIMER_A0, TIMER_A1, TIMER_A2, TIMER_A3
+};
+
+// Simulated time in MCLK cycles, and the time in microseconds at the last clock profile switch
+static uint64_t host_sim_cycles = 0;
+static uint64_t host_sim_base_cycles = 0;
+static uint64_t host_sim_base_us = 0;
+static uint32_t host_sim_mclk = 3000000;
+
+// Number of ACLK edges since the last clock profile switch, and the state of the dividers of each timer
+static uint64_t host_sim_aclk_edges = 0;
+static uint16_t host_sim_timer_prescalers[4];
+
+// State of the NVIC: enable and pending bits, and the context that is running
+static uint32_t host_sim_enabled[2];
+static uint32_t host_sim_pending[2];
+static int16_t host_sim_active_irq = HOST_SIM_THREAD;
+static uint16_t host_sim_active_priority = HOST_SIM_THREAD_PRIORITY;
+static uint32_t host_sim_interrupt_counts[HOST_SIM_NUM_IRQS + 1];
+static uint32_t host_sim_deliveries = 0;
+
+// Data input register of CRC32 that was accessed last, processed at the next access of the module
+static uint8_t host_sim_crc32_pending = 0;
+
+// Main flash (256 KB), erased at the first access and kept by Host_Sim_Reset like the flash of the device
+#define HOST_SIM_FLASH_SIZE 0x40000
+static uint32_t host_sim_flash[HOST_SIM_FLASH_SIZE / 4];
+static uint8_t host_sim_flash_initialized = 0;
+
+// Simulated time at which WFI stops waiting (set by Host_Sim_Run)
+static uint64_t host_sim_wake_limit = UINT64_MAX;
+
+// Characters transmitted by EUSCI_A0
+// TXBUF_register[0] is 0xFFFF when it does not hold a character that has not been captured
+static char host_sim_uart_capture[HOST_SIM_UART_CAPTURE_SIZE];
+static uint32_t host_sim_uart_head = 0;
+static uint32_t host_sim_uart_tail = 0;
+
+/**
+ * @brief Moves the last character written to TXBUF to the capture buffer.
+ */
+static void Host_Sim_Capture_TXBUF(void)
+{
+    if (Host_EUSCI_A0.TXBUF_register[0] == 0xFFFF) return;
+
+    if ((host_sim_uart_head - host_sim_uart_tail) < HOST_SIM_UART_CAPTURE_SIZE)
+    {
+        host_sim_uart_capture[host_sim_uart_head & (HOST_SIM_UART_CAPTURE_SIZE - 1)] = (char)Host_EUSCI_A0.TXBUF_register[0];
+        host_sim_uart_head++;
+    }
+
+    Host_EUSCI_A0.TXBUF_register[0] = 0xFFFF;
+}
+
+/**
+ * @brief Applies the bits written to ISER, ICER, ISPR, and ICPR since the last access, then clears them.
+ */
+static void Host_Sim_Update_NVIC(void)
+{
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        host_sim_enabled[i] |= Host_NVIC.ISER_register[0][i];
+        host_sim_enabled[i] &= ~Host_NVIC.ICER_register[0][i];
+        host_sim_pending[i] |= Host_NVIC.ISPR_register[0][i];
+        host_sim_pending[i] &= ~Host_NVIC.ICPR_register[0][i];
+
+        Host_NVIC.ISER_register[0][i] = 0;
+        Host_NVIC.ICER_register[0][i] = 0;
+        Host_NVIC.ISPR_register[0][i] = 0;
+        Host_NVIC.ICPR_register[0][i] = 0;
+    }
+}
+
+/**
+ * @brief Returns 1 if the peripheral of an IRQ requests an interrupt (the level of its interrupt line).
+ */
+static uint8_t Host_Sim_Is_Requested(int16_t irq)
+{
+    if (irq == HOST_SIM_SYSTICK_IRQ)
+    {
+        return (Host_SCB.ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+    }
+
+    if ((host_sim_pending[irq >> 5] >> (irq & 31)) & 1) return 1;
+
+    if ((irq >= HOST_SIM_IRQ_PORT1) && (irq <= HOST_SIM_IRQ_PORT6))
+    {
+        DIO_PORT_Interruptable_Type *port = host_sim_ports[irq - HOST_SIM_IRQ_PORT1];
+        return (port->IFG & port->IE) != 0;
+    }
+
+    if ((irq >= HOST_SIM_IRQ_TA0_0) && (irq <= HOST_SIM_IRQ_TA3_N))
+    {
+        Timer_A_Type *timer = host_sim_timers[(irq - HOST_SIM_IRQ_TA0_0) >> 1];
+
+        // TAx_0: CCIFG and CCIE of CCR0
+        if (((irq - HOST_SIM_IRQ_TA0_0) & 1) == 0)
+        {
+            return (timer->CCTL[0] & 0x0011) == 0x0011;
+        }
+
+        // TAx_N: CCIFG and CCIE of CCR1 to CCR6, or TAIFG and TAIE
+        for (uint8_t channel = 1; channel < 7; channel++)
+        {
+            if ((timer->CCTL[channel] & 0x0011) == 0x0011) return 1;
+        }
+
+        return (timer->CTL & 0x0003) == 0x0003;
+    }
+
+    if (irq == HOST_SIM_IRQ_EUSCIA0)
+    {
+        return (Host_EUSCI_A0.IFG & Host_EUSCI_A0.IE & 0x000F) != 0;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Returns 1 if an IRQ is enabled in the NVIC (SysTick is always enabled, since TICKINT controls its pending bit).
+ */
+static uint8_t Host_Sim_Is_Enabled(int16_t irq)
+{
+    if (irq == HOST_SIM_SYSTICK_IRQ) return 1;
+
+    return (host_sim_enabled[irq >> 5] >> (irq & 31)) & 1;
+}
+
+/**
+ * @brief Returns the 8-bit priority of an IRQ (only the upper 3 bits are implemented).
+ */
+static uint16_t Host_Sim_Get_Priority(int16_t irq)
+{
+    if (irq == HOST_SIM_SYSTICK_IRQ) return Host_SCB.SHP[11] & 0xE0;
+
+    return Host_NVIC.IP[irq] & 0xE0;
+}
+
+/**
+ * @brief Returns the mask of the group priority bits of an 8-bit priority, from the PRIGROUP field of SCB->AIRCR.
+ */
+static uint16_t Host_Sim_Get_Group_Mask(void)
+{
+    uint8_t prigroup = (Host_SCB.AIRCR >> 8) & 0x7;
+
+    return (0xFF << (prigroup + 1)) & 0xE0;
+}
+
+/**
+ * @brief Returns the requested and enabled interrupt with the highest priority that can preempt the running code, or HOST_SIM_THREAD.
+ *
+ * Only a lower group priority preempts the running handler. Among the interrupts that can preempt it,
+ * the lowest priority (group and sub-priority) is taken, and a tie is won by the lowest exception number,
+ * so SysTick is taken before the device IRQs of the same priority.
+ */
+static int16_t Host_Sim_Next_Interrupt(void)
+{
+    int16_t next = HOST_SIM_THREAD;
+    uint16_t next_priority = HOST_SIM_THREAD_PRIORITY;
+    uint16_t group_mask = Host_Sim_Get_Group_Mask();
+
+    if (Host_PRIMASK & 1) return HOST_SIM_THREAD;
+
+    Host_Sim_Update_NVIC();
+
+    for (uint8_t i = 0; i < HOST_SIM_NUM_HANDLED_IRQS; i++)
+    {
+        int16_t irq = host_sim_irqs[i];
+
+        if (!Host_Sim_Is_Enabled(irq) || !Host_Sim_Is_Requested(irq)) continue;
+
+        uint16_t priority = Host_Sim_Get_Priority(irq);
+
+        // The running handler is only preempted by a lower group priority
+        if ((priority & group_mask) >= host_sim_active_priority) continue;
+
+        // BASEPRI masks the group priorities greater than or equal to its group priority
+        if ((Host_BASEPRI != 0) && ((priority & group_mask) >= (Host_BASEPRI & group_mask))) continue;
+
+        if (priority < next_priority)
+        {
+            next = irq;
+            next_priority = priority;
+        }
+    }
+
+    return next;
+}
+
+/**
+ * @brief Returns 1 if an enabled interrupt is requested, even if it is masked (the condition that ends WFI).
+ */
+static uint8_t Host_Sim_Is_Wake_Up_Requested(void)
+{
+    Host_Sim_Update_NVIC();
+
+    for (uint8_t i = 0; i < HOST_SIM_NUM_HANDLED_IRQS; i++)
+    {
+        if (Host_Sim_Is_Enabled(host_sim_irqs[i]) && Host_Sim_Is_Requested(host_sim_irqs[i])) return 1;
+    }
+
+    return 0;
+}
+
+void Host_Sim_Check_Interrupts(void)
+{
+    int16_t irq;
+
+    while ((irq = Host_Sim_Next_Interrupt()) != HOST_SIM_THREAD)
+    {
+        int16_t previous_irq = host_sim_active_irq;
+        uint16_t previous_priority = host_sim_active_priority;
+
+        // Entering the handler clears the pending bit of SysTick and the software-pended bit of the IRQ
+        if (irq == HOST_SIM_SYSTICK_IRQ)
+        {
+            Host_SCB.ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+        }
+        else
+        {
+            host_sim_pending[irq >> 5] &= ~(1UL << (irq & 31));
+        }
+
+        host_sim_active_irq = irq;
+        host_sim_active_priority = Host_Sim_Get_Priority(irq) & Host_Sim_Get_Group_Mask();
+        host_sim_interrupt_counts[irq + 1]++;
+        host_sim_deliveries++;
+
+        void (* const *vectors)(void) = (Host_SCB.VTOR != 0) ? (void (* const *)(void))Host_SCB.VTOR : interruptVectors;
+        vectors[irq + 16]();
+
+        host_sim_active_irq = previous_irq;
+        host_sim_active_priority = previous_priority;
+    }
+}
+
+/**
+ * @brief Returns the simulated time of the next ACLK edge.
+ */
+static uint64_t Host_Sim_Next_ACLK_Edge(void)
+{
+    return host_sim_base_cycles + ((((host_sim_aclk_edges + 1) * host_sim_mclk) + HOST_SIM_ACLK_FREQUENCY - 1) / HOST_SIM_ACLK_FREQUENCY);
+}
+
+/**
+ * @brief Counts one ACLK cycle with the timers that are clocked by ACLK.
+ */
+static void Host_Sim_ACLK_Edge(void)
+{
+    for (uint8_t t = 0; t < 4; t++)
+    {
+        Timer_A_Type *timer = host_sim_timers[t];
+        uint16_t mode = (timer->CTL >> 4) & 0x3;
+
+        // TASSEL = 1 (ACLK) and MC other than stop
+        if ((((timer->CTL >> 8) & 0x3) != 1) || (mode == 0)) continue;
+
+        // Divide by ID and TAIDEX
+        uint16_t divider = (uint16_t)((1 << ((timer->CTL >> 6) & 0x3)) * ((timer->EX0 & 0x7) + 1));
+
+        if (++host_sim_timer_prescalers[t] < divider) continue;
+        host_sim_timer_prescalers[t] = 0;
+
+        if ((mode == 2) || (timer->R != timer->CCR[0]))
+        {
+            // Continuous mode counts to 0xFFFF, then sets TAIFG when it rolls over
+            if (++timer->R == 0) timer->CTL |= 0x0001;
+        }
+        else
+        {
+            // Up (and up/down) mode counts to CCR0, then sets TAIFG when it goes back to 0
+            timer->R = 0;
+            timer->CTL |= 0x0001;
+        }
+
+        // The compare of each channel sets its CCIFG when R reaches CCRn (CAP = 0)
+        for (uint8_t channel = 0; channel < 7; channel++)
+        {
+            if (((timer->CCTL[channel] & 0x0100) == 0) && (timer->R == timer->CCR[channel]))
+            {
+                timer->CCTL[channel] |= 0x0001;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns the number of cycles until the next SysTick event (the reload when VAL is 0, otherwise VAL reaching 0)
+ *        or the next ACLK edge, whichever comes first.
+ */
+static uint64_t Host_Sim_Cycles_To_Next_Event(void)
+{
+    uint64_t cycles = Host_Sim_Next_ACLK_Edge() - host_sim_cycles;
+    uint32_t value = Host_SysTick.VAL_register[0];
+
+    if ((Host_SysTick.CTRL & 0x1) && (cycles > ((value == 0) ? 1 : value)))
+    {
+        cycles = (value == 0) ? 1 : value;
+    }
+
+    return cycles;
+}
+
+void Host_Sim_Advance_Cycles(uint64_t cycles)
+{
+    while (cycles > 0)
+    {
+        uint64_t step = Host_Sim_Cycles_To_Next_Event();
+        uint64_t next_aclk = Host_Sim_Next_ACLK_Edge();
+        uint32_t value = Host_SysTick.VAL_register[0];
+        uint8_t systick_running = (Host_SysTick.CTRL & 0x1) != 0;
+
+        if (step > cycles) step = cycles;
+
+        host_sim_cycles += step;
+        cycles -= step;
+
+        if (Host_DWT.CTRL & 0x1)
+        {
+            Host_DWT.CYCCNT_register[0] += (uint32_t)step;
+        }
+
+        if (systick_running)
+        {
+            if (value == 0)
+            {
+                Host_SysTick.VAL_register[0] = Host_SysTick.LOAD & 0x00FFFFFF;
+            }
+            else
+            {
+                Host_SysTick.VAL_register[0] = value - (uint32_t)step;
+
+                // Reaching 0 sets COUNTFLAG and pends the interrupt if TICKINT is set
+                if (Host_SysTick.VAL_register[0] == 0)
+                {
+                    Host_SysTick.CTRL |= 0x00010000;
+                    if (Host_SysTick.CTRL & 0x2) Host_SCB.ICSR |= SCB_ICSR_PENDSTSET_Msk;
+                }
+            }
+        }
+
+        if (host_sim_cycles == next_aclk)
+        {
+            host_sim_aclk_edges++;
+            Host_Sim_ACLK_Edge();
+        }
+
+        Host_Sim_Check_Interrupts();
+    }
+}
+
+void Host_Sim_Advance_Us(uint32_t us)
+{
+    Host_Sim_Advance_Cycles((uint64_t)us * (host_sim_mclk / 1000000));
+}
+
+uint64_t Host_Sim_Get_Cycles(void)
+{
+    return host_sim_cycles;
+}
+
+uint64_t Host_Sim_Get_Time_Us(void)
+{
+    return host_sim_base_us + (((host_sim_cycles - host_sim_base_cycles) * 1000000) / host_sim_mclk);
+}
+
+void Host_Sim_Clock_Changed(void)
+{
+    // Start counting the microseconds and the ACLK edges again from the current time
+    host_sim_base_us = Host_Sim_Get_Time_Us();
+    host_sim_base_cycles = host_sim_cycles;
+    host_sim_aclk_edges = 0;
+    host_sim_mclk = Clock_GetFreq();
+}
+
+void Host_Sim_Reset(void)
+{
+    for (uint8_t port = 0; port < 10; port++)
+    {
+        memset((void *)host_sim_ports[port], 0, sizeof(DIO_PORT_Interruptable_Type));
+    }
+
+    memset(&Host_PJ, 0, sizeof(Host_PJ));
+    memset(&Host_PMAP, 0, sizeof(Host_PMAP));
+    memset(&Host_P2MAP, 0, sizeof(Host_P2MAP));
+    memset(&Host_EUSCI_A0, 0, sizeof(Host_EUSCI_A0));
+    memset(&Host_TIMER_A0, 0, sizeof(Host_TIMER_A0));
+    memset(&Host_TIMER_A1, 0, sizeof(Host_TIMER_A1));
+    memset(&Host_TIMER_A2, 0, sizeof(Host_TIMER_A2));
+    memset(&Host_TIMER_A3, 0, sizeof(Host_TIMER_A3));
+    memset(&Host_TIMER32_1, 0, sizeof(Host_TIMER32_1));
+    memset(&Host_TIMER32_2, 0, sizeof(Host_TIMER32_2));
+    memset(&Host_DMA_Channel, 0, sizeof(Host_DMA_Channel));
+    memset(&Host_DMA_Control, 0, sizeof(Host_DMA_Control));
+    memset(&Host_CRC32, 0, sizeof(Host_CRC32));
+    memset(&Host_WDT_A, 0, sizeof(Host_WDT_A));
+    memset(&Host_SysTick, 0, sizeof(Host_SysTick));
+    memset(&Host_SCB, 0, sizeof(Host_SCB));
+    memset(&Host_NVIC, 0, sizeof(Host_NVIC));
+    memset(&Host_DWT, 0, sizeof(Host_DWT));
+    memset(&Host_CoreDebug, 0, sizeof(Host_CoreDebug));
+    memset(&Host_CS, 0, sizeof(Host_CS));
+    memset(&Host_PCM, 0, sizeof(Host_PCM));
+    memset(&Host_FLCTL, 0, sizeof(Host_FLCTL));
+
+    // All the sectors of the main flash are protected against program and erase operations
+    Host_FLCTL.BANK0_MAIN_WEPROT = 0xFFFFFFFF;
+    Host_FLCTL.BANK1_MAIN_WEPROT = 0xFFFFFFFF;
+
+    // The transmitter is ready, and TXBUF does not hold a character
+    Host_EUSCI_A0.IFG = 0x0002;
+    Host_EUSCI_A0.TXBUF_register[0] = 0xFFFF;
+
+    Host_PRIMASK = 0;
+    Host_BASEPRI = 0;
+
+    memset(host_sim_enabled, 0, sizeof(host_sim_enabled));
+    memset(host_sim_pending, 0, sizeof(host_sim_pending));
+    memset(host_sim_interrupt_counts, 0, sizeof(host_sim_interrupt_counts));
+    memset(host_sim_timer_prescalers, 0, sizeof(host_sim_timer_prescalers));
+    host_sim_active_irq = HOST_SIM_THREAD;
+    host_sim_active_priority = HOST_SIM_THREAD_PRIORITY;
+    host_sim_deliveries = 0;
+    host_sim_crc32_pending = 0;
+
+    host_sim_cycles = 0;
+    host_sim_base_cycles = 0;
+    host_sim_base_us = 0;
+    host_sim_aclk_edges = 0;
+    Host_Clock_Reset();
+    host_sim_mclk = Clock_GetFreq();
+    host_sim_wake_limit = UINT64_MAX;
+
+    host_sim_uart_head = 0;
+    host_sim_uart_tail = 0;
+}
+
+void Host_Sim_Set_Input(uint8_t port, uint8_t pins, uint8_t levels)
+{
+    if ((port < 1) || (port > 10)) return;
+
+    DIO_PORT_Interruptable_Type *registers = host_sim_ports[port - 1];
+    uint8_t previous = registers->IN;
+    uint8_t next = (uint8_t)((previous & ~pins) | (levels & pins));
+
+    *((volatile uint8_t *)&registers->IN) = next;
+
+    // Only P1 to P6 have interrupts
+    if (port <= 6)
+    {
+        uint8_t rising = (uint8_t)(~previous & next);
+        uint8_t falling = (uint8_t)(previous & ~next);
+
+        // IES = 0 selects the rising edge, and IES = 1 selects the falling edge
+        registers->IFG |= (uint8_t)((rising & ~registers->IES) | (falling & registers->IES));
+    }
+
+    Host_Sim_Check_Interrupts();
+}
+
+void Host_Sim_Run(const Host_Sim_Edge *edges, uint16_t count, uint32_t end_us, void (*idle)(void))
+{
+    uint16_t index = 0;
+
+    while (1)
+    {
+        uint64_t now = Host_Sim_Get_Time_Us();
+        uint64_t next = (index < count) ? edges[index].time_us : end_us;
+
+        if (next > end_us) next = end_us;
+
+        if (now >= next)
+        {
+            if (index >= count) break;
+
+            if (idle) idle();
+            Host_Sim_Set_Input(edges[index].port, edges[index].pins, edges[index].levels);
+            index++;
+            continue;
+        }
+
+        // WFI in the idle function does not sleep past the next change
+        host_sim_wake_limit = host_sim_cycles + ((next - now) * (host_sim_mclk / 1000000));
+
+        if (idle) idle();
+
+        // Advance by at most one step if the idle function did not sleep until the next change
+        now = Host_Sim_Get_Time_Us();
+        if (now < next)
+        {
+            uint64_t step = next - now;
+            if (step > HOST_SIM_IDLE_STEP_US) step = HOST_SIM_IDLE_STEP_US;
+            Host_Sim_Advance_Us((uint32_t)step);
+        }
+    }
+
+    host_sim_wake_limit = UINT64_MAX;
+
+    if (idle) idle();
+}
+
+void Host_Sim_UART_Receive(const char *text)
+{
+    while (*text)
+    {
+        *((volatile uint16_t *)&Host_EUSCI_A0.RXBUF_register[0]) = (uint8_t)*text;
+        Host_EUSCI_A0.IFG |= 0x0001;
+        Host_Sim_Check_Interrupts();
+        text++;
+    }
+}
+
+uint32_t Host_Sim_UART_Read(char *buffer, uint32_t size)
+{
+    uint32_t count = 0;
+
+    Host_Sim_Capture_TXBUF();
+
+    if (size == 0) return 0;
+
+    while ((host_sim_uart_tail != host_sim_uart_head) && (count < (size - 1)))
+    {
+        buffer[count++] = host_sim_uart_capture[host_sim_uart_tail & (HOST_SIM_UART_CAPTURE_SIZE - 1)];
+        host_sim_uart_tail++;
+    }
+
+    buffer[count] = 0;
+    return count;
+}
+
+uint32_t Host_Sim_Get_Interrupt_Count(int16_t irq)
+{
+    if ((irq < HOST_SIM_SYSTICK_IRQ) || (irq >= HOST_SIM_NUM_IRQS)) return 0;
+
+    return host_sim_interrupt_counts[irq + 1];
+}
+
+void Host_Sim_Instruction(const char *instruction)
+{
+    if (strcmp(instruction, "CPSID I") == 0)
+    {
+        Host_PRIMASK = 1;
+    }
+    else if (strcmp(instruction, "CPSIE I") == 0)
+    {
+        Host_PRIMASK = 0;
+        Host_Sim_Check_Interrupts();
+    }
+    else if (strcmp(instruction, "WFI") == 0)
+    {
+        uint64_t limit = host_sim_cycles + HOST_SIM_MAX_SLEEP_CYCLES;
+        uint32_t deliveries = host_sim_deliveries;
+
+        if (limit > host_sim_wake_limit) limit = host_sim_wake_limit;
+
+        // Sleep until an interrupt has been taken, or is requested while it is masked
+        while ((host_sim_deliveries == deliveries) && !Host_Sim_Is_Wake_Up_Requested() && (host_sim_cycles < limit))
+        {
+            uint64_t step = Host_Sim_Cycles_To_Next_Event();
+
+            if (step > (limit - host_sim_cycles)) step = limit - host_sim_cycles;
+            Host_Sim_Advance_Cycles(step);
+        }
+    }
+
+    // DSB and ISB have no effect, since the simulator completes each access before the next one
+}
+
+// Register hooks (see msp.h)
+
+uint32_t Host_Sim_Read_IV(void)
+{
+    int16_t irq = host_sim_active_irq;
+
+    if ((irq >= HOST_SIM_IRQ_PORT1) && (irq <= HOST_SIM_IRQ_PORT6))
+    {
+        // PxIV: the lowest pin with IFG and IE set, from 0x02 for Px.0 to 0x10 for Px.7
+        DIO_PORT_Interruptable_Type *port = host_sim_ports[irq - HOST_SIM_IRQ_PORT1];
+        uint8_t flags = port->IFG & port->IE;
+        uint16_t vector = 0;
+
+        for (uint8_t pin = 0; pin < 8; pin++)
+        {
+            if (flags & (1 << pin))
+            {
+                port->IFG &= (uint8_t)~(1 << pin);
+                vector = (uint16_t)((pin + 1) << 1);
+                break;
+            }
+        }
+
+        *((volatile uint16_t *)&port->IV_register[0]) = vector;
+    }
+    else if ((irq >= HOST_SIM_IRQ_TA0_0) && (irq <= HOST_SIM_IRQ_TA3_N) && ((irq - HOST_SIM_IRQ_TA0_0) & 1))
+    {
+        // TAxIV: 0x02 for CCR1 up to 0x0C for CCR6, then 0x0E for TAIFG
+        Timer_A_Type *timer = host_sim_timers[(irq - HOST_SIM_IRQ_TA0_0) >> 1];
+        uint16_t vector = 0;
+
+        for (uint8_t channel = 1; channel < 7; channel++)
+        {
+            if ((timer->CCTL[channel] & 0x0011) == 0x0011)
+            {
+                timer->CCTL[channel] &= ~0x0001;
+                vector = (uint16_t)(channel << 1);
+                break;
+            }
+        }
+
+        if ((vector == 0) && ((timer->CTL & 0x0003) == 0x0003))
+        {
+            timer->CTL &= ~0x0001;
+            vector = 0x000E;
+        }
+
+        *((volatile uint16_t *)&timer->IV_register[0]) = vector;
+    }
+
+    return 0;
+}
+
+uint32_t Host_Sim_TXBUF_Index(void)
+{
+    // The previous character has been written, so it can be captured before the next access
+    Host_Sim_Capture_TXBUF();
+
+    return 0;
+}
+
+uint32_t Host_Sim_Read_RXBUF(void)
+{
+    Host_EUSCI_A0.IFG &= ~0x0001;
+
+    return 0;
+}
+
+uint32_t Host_Sim_Read_VAL(void)
+{
+    Host_Sim_Advance_Cycles(HOST_SIM_READ_CYCLES);
+
+    return 0;
+}
+
+uint32_t Host_Sim_Read_CYCCNT(void)
+{
+    Host_Sim_Advance_Cycles(HOST_SIM_READ_CYCLES);
+
+    return 0;
+}
+
+uint32_t Host_Sim_NVIC_Access(void)
+{
+    Host_Sim_Update_NVIC();
+
+    return 0;
+}
+
+/**
+ * @brief Shifts one byte into a CRC signature, in the order of the polynomial (most significant bit of the signature first).
+ *
+ * @param lsb_first 1 for the DI registers (bit 0 of the byte first), 0 for the DIRB registers (bit 7 first).
+ */
+static uint32_t Host_Sim_CRC_Shift(uint32_t signature, uint8_t data, uint8_t width, uint32_t polynomial, uint8_t lsb_first)
+{
+    uint32_t mask = (width == 32) ? 0xFFFFFFFF : ((1UL << width) - 1);
+
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        uint8_t bit = lsb_first ? ((data >> i) & 1) : ((data >> (7 - i)) & 1);
+        uint8_t feedback = ((signature >> (width - 1)) & 1) ^ bit;
+
+        signature = (signature << 1) & mask;
+        if (feedback) signature ^= polynomial;
+    }
+
+    return signature;
+}
+
+static uint32_t Host_Sim_CRC_Reverse(uint32_t value, uint8_t width)
+{
+    uint32_t reversed = 0;
+
+    for (uint8_t i = 0; i < width; i++)
+    {
+        reversed = (reversed << 1) | ((value >> i) & 1);
+    }
+
+    return reversed;
+}
+
+uint32_t Host_Sim_CRC32_Access(uint8_t data_input)
+{
+    // The byte written to the previous data input register is processed before the next access
+    if (host_sim_crc32_pending == HOST_SIM_CRC32_DI32 || host_sim_crc32_pending == HOST_SIM_CRC32_DIRB32)
+    {
+        uint8_t lsb_first = (host_sim_crc32_pending == HOST_SIM_CRC32_DI32);
+        uint8_t data = (uint8_t)(lsb_first ? Host_CRC32.DI32_register[0] : Host_CRC32.DIRB32_register[0]);
+        uint32_t signature = ((uint32_t)Host_CRC32.INIRES32_HI_register[0] << 16) | Host_CRC32.INIRES32_LO_register[0];
+
+        signature = Host_Sim_CRC_Shift(signature, data, 32, 0x04C11DB7, lsb_first);
+
+        Host_CRC32.INIRES32_LO_register[0] = (uint16_t)signature;
+        Host_CRC32.INIRES32_HI_register[0] = (uint16_t)(signature >> 16);
+    }
+    else if (host_sim_crc32_pending == HOST_SIM_CRC32_DI16 || host_sim_crc32_pending == HOST_SIM_CRC32_DIRB16)
+    {
+        uint8_t lsb_first = (host_sim_crc32_pending == HOST_SIM_CRC32_DI16);
+        uint8_t data = (uint8_t)(lsb_first ? Host_CRC32.DI16_register[0] : Host_CRC32.DIRB16_register[0]);
+        uint32_t signature = Host_Sim_CRC_Shift(Host_CRC32.INIRES16_register[0], data, 16, 0x1021, lsb_first);
+
+        Host_CRC32.INIRES16_register[0] = (uint16_t)signature;
+    }
+
+    // The reversed signatures follow the signatures, including the initial values written to INIRES
+    uint32_t reversed = Host_Sim_CRC_Reverse(((uint32_t)Host_CRC32.INIRES32_HI_register[0] << 16) | Host_CRC32.INIRES32_LO_register[0], 32);
+    Host_CRC32.RESR32_LO_register[0] = (uint16_t)reversed;
+    Host_CRC32.RESR32_HI_register[0] = (uint16_t)(reversed >> 16);
+    Host_CRC32.RESR16_register[0] = (uint16_t)Host_Sim_CRC_Reverse(Host_CRC32.INIRES16_register[0], 16);
+
+    host_sim_crc32_pending = data_input;
+
+    return 0;
+}
+
+volatile uint32_t *Host_Sim_Flash(uint32_t address)
+{
+    if (host_sim_flash_initialized == 0)
+    {
+        memset(host_sim_flash, 0xFF, sizeof(host_sim_flash));
+        host_sim_flash_initialized = 1;
+    }
+
+    return &host_sim_flash[(address % HOST_SIM_FLASH_SIZE) / 4];
+}
+
+uint32_t Host_Sim_FLCTL_Erase_Access(void)
+{
+    uint32_t erase_ctlstat = Host_FLCTL.ERASE_CTLSTAT_register[0];
+
+    // CLR_STAT clears STATUS and ADDR_ERR
+    if (erase_ctlstat & 0x00080000)
+    {
+        erase_ctlstat &= ~(0x00080000 | 0x00040000 | 0x00030000);
+    }
+
+    // START erases the sector of ERASE_SECTADDR, which completes before the next access
+    // A protected sector is not erased, and the operation still completes
+    if (erase_ctlstat & 0x00000001)
+    {
+        uint32_t address = Host_FLCTL.ERASE_SECTADDR % HOST_SIM_FLASH_SIZE;
+        uint32_t bank_sector = (address % 0x20000) / 4096;
+        uint32_t protection = (address < 0x20000) ? Host_FLCTL.BANK0_MAIN_WEPROT : Host_FLCTL.BANK1_MAIN_WEPROT;
+
+        if ((protection & (1UL << bank_sector)) == 0)
+        {
+            memset((void *)Host_Sim_Flash(address & ~0xFFFU), 0xFF, 4096);
+        }
+
+        erase_ctlstat = (erase_ctlstat & ~0x00000001) | 0x00030000;
+    }
+
+    Host_FLCTL.ERASE_CTLSTAT_register[0] = erase_ctlstat;
+
+    return 0;
+}
+
+// Interrupt handler of SysTick, same as the one of Timers_and_Interrupts_main.c
+void SysTick_Handler(void)
+{
+    SysTick_Interrupt_Add_Ticks(1);
+}
+
+// The TI run-time library is not available, so the UART cannot be registered as a device for printf
+int add_device(char *name,
+               unsigned flags,
+               int (*dopen)(const char *path, unsigned flags, int llv_fd),
+               int (*dclose)(int dev_fd),
+               int (*dread)(int dev_fd, char *buf, unsigned count),
+               int (*dwrite)(int dev_fd, const char *buf, unsigned count),
+               off_t (*dlseek)(int dev_fd, off_t offset, int origin),
+               int (*dunlink)(const char *path),
+               int (*drename)(const char *old_name, const char *new_name))
+{
+    return -1;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file Host_Sim.h
+ * @brief Header file for the host simulator of the MSP432 peripherals.
+ *
+ * This file contains the function definitions for the host simulator. The simulator is used to compile and run
+ * the drivers of Timers_and_Interrupts on a PC (see host/Makefile), with the register mock in host/mock/msp.h.
+ * It simulates the following, with a time base of MCLK cycles:
+ *  - SysTick: VAL counts down and the SysTick interrupt is pended when it reaches 0 (with COUNTFLAG and PENDSTSET)
+ *  - Timer_A0 to Timer_A3 when they are clocked by ACLK (32.768 kHz): up and continuous modes, the dividers,
+ *    and the compare flags of all channels. Timers clocked by SMCLK do not count.
+ *  - P1 to P6: an edge injected with Host_Sim_Set_Input sets the interrupt flag of the pin if it matches PxIES
+ *  - EUSCI_A0: the transmitter is always ready (TXIFG is set), the characters written to TXBUF are captured,
+ *    and the characters passed to Host_Sim_UART_Receive are received one at a time
+ *  - NVIC: enable bits, priorities of the IRQs and of SysTick, PRIMASK, BASEPRI, and preemption by higher priorities
+ *  - The DWT cycle counter (when it is enabled)
+ *  - The main flash (Host_Sim_Flash), which is kept by Host_Sim_Reset, and the sector erase of FLCTL.
+ *    A program operation is a store that completes immediately.
+ * DMA and Timer32 are not simulated, so EUSCI_A0_UART_WriteAsync and the Timer32_Interrupt driver do not complete.
+ *
+ * Interrupts are delivered when the simulated time advances, when PRIMASK or BASEPRI is lowered, after an injected edge,
+ * and at the end of each handler. The time advances only when it is requested (Host_Sim_Advance_Us, Host_Sim_Run),
+ * for WFI, and by HOST_SIM_READ_CYCLES for each read of SysTick->VAL or DWT->CYCCNT. A busy-wait on a variable that
+ * is only written by a handler does not end, so the UART must use the polled or the dropping transmit mode.
+ *
+ * Usage:
+ *
+ *      Host_Sim_Reset();
+ *      Host_Sim_Set_Input(4, 0xFF, 0xFF);         // The bumper switches are released (pulled up)
+ *      Clock_Init48MHz();
+ *      SysTick_Interrupt_Init(SYSTICK_INT_NUM_CLK_CYCLES, SYSTICK_INT_PRIORITY);
+ *      Bumper_Sensors_Init(&Bumper_Task);
+ *      EnableInterrupts();
+ *      Host_Sim_Run(edges, edge_count, 50000, &Event_Queue_Dispatch_Task);
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef HOST_SIM_H_
+#define HOST_SIM_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Number of MCLK cycles added to the simulated time by each read of SysTick->VAL or DWT->CYCCNT
+ */
+#define HOST_SIM_READ_CYCLES 4
+
+/**
+ * @brief Frequency of ACLK (REFOCLK) in Hz
+ */
+#define HOST_SIM_ACLK_FREQUENCY 32768
+
+/**
+ * @brief Number of characters held by the UART capture buffer (must be a power of two)
+ */
+#define HOST_SIM_UART_CAPTURE_SIZE 65536
+
+/**
+ * @brief Longest time that the simulated time advances between two calls of the idle function of Host_Sim_Run
+ */
+#define HOST_SIM_IDLE_STEP_US 100
+
+/**
+ * @brief IRQ number used for SysTick (exception 15) in Host_Sim_Get_Interrupt_Count
+ */
+#define HOST_SIM_SYSTICK_IRQ -1
+
+/**
+ * @brief Number of device IRQs handled by the simulator (IRQ 0 to 63)
+ */
+#define HOST_SIM_NUM_IRQS 64
+
+/**
+ * @brief Change of input pins at a given time of a simulated sequence.
+ *
+ *  - time_us: The simulated time of the change, from the start of the simulation
+ *  - port:    The port number (1 to 10)
+ *  - pins:    The pins that are changed (e.g. 0x01 for Px.0)
+ *  - levels:  The new levels of those pins
+ */
+typedef struct
+{
+    uint32_t time_us;
+    uint8_t port;
+    uint8_t pins;
+    uint8_t levels;
+} Host_Sim_Edge;
+
+/**
+ * @brief Clears all registers, the simulated time, the UART capture buffer, and the interrupt counts.
+ *
+ * The input registers are set to 0, PRIMASK and BASEPRI are cleared, and the clock is 3 MHz as out of reset.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Host_Sim_Reset(void);
+
+/**
+ * @brief Returns the number of MCLK cycles since Host_Sim_Reset.
+ *
+ * @param None
+ *
+ * @return The simulated time in MCLK cycles.
+ */
+uint64_t Host_Sim_Get_Cycles(void);
+
+/**
+ * @brief Returns the simulated time in microseconds since Host_Sim_Reset, including the time before each clock profile switch.
+ *
+ * @param None
+ *
+ * @return The simulated time in microseconds.
+ */
+uint64_t Host_Sim_Get_Time_Us(void);
+
+/**
+ * @brief Advances the simulated time and delivers the interrupts that are requested on the way.
+ *
+ * @param cycles The number of MCLK cycles.
+ *
+ * @return None
+ */
+void Host_Sim_Advance_Cycles(uint64_t cycles);
+
+/**
+ * @brief Advances the simulated time by the specified number of microseconds.
+ *
+ * @param us The number of microseconds.
+ *
+ * @return None
+ */
+void Host_Sim_Advance_Us(uint32_t us);
+
+/**
+ * @brief Changes the level of input pins, sets the interrupt flags of the edges that match PxIES, and delivers the interrupts.
+ *
+ * @param port The port number (1 to 10). Only P1 to P6 have interrupts.
+ * @param pins The pins that are changed.
+ * @param levels The new levels of those pins.
+ *
+ * @return None
+ */
+void Host_Sim_Set_Input(uint8_t port, uint8_t pins, uint8_t levels);
+
+/**
+ * @brief Runs a sequence of timed input changes.
+ *
+ * The idle function plays the role of the main loop (e.g. it calls Event_Queue_Dispatch). It is called at least once
+ * every HOST_SIM_IDLE_STEP_US of simulated time, and just before each change of the sequence.
+ *
+ * @param edges The changes, sorted by time.
+ * @param count The number of changes.
+ * @param end_us The simulated time at which the run ends, from the start of the simulation.
+ * @param idle The function called between the changes, or 0.
+ *
+ * @return None
+ */
+void Host_Sim_Run(const Host_Sim_Edge *edges, uint16_t count, uint32_t end_us, void (*idle)(void));
+
+/**
+ * @brief Receives a string with EUSCI_A0, one character at a time.
+ *
+ * Each character sets RXIFG and the interrupts are delivered before the next one. A character that is not read
+ * before the next one is overwritten, as in an overrun.
+ *
+ * @param text The characters to receive.
+ *
+ * @return None
+ */
+void Host_Sim_UART_Receive(const char *text);
+
+/**
+ * @brief Moves the characters transmitted by EUSCI_A0 since the last call to a buffer.
+ *
+ * @param buffer The buffer that receives the characters. A terminating null character is added.
+ * @param size The size of the buffer.
+ *
+ * @return The number of characters copied, without the null character.
+ */
+uint32_t Host_Sim_UART_Read(char *buffer, uint32_t size);
+
+/**
+ * @brief Returns the number of times the handler of an interrupt has been called since Host_Sim_Reset.
+ *
+ * @param irq The IRQ number, or HOST_SIM_SYSTICK_IRQ.
+ *
+ * @return The number of calls.
+ */
+uint32_t Host_Sim_Get_Interrupt_Count(int16_t irq);
+
+/**
+ * @brief Notifies the simulator that the MCLK frequency has changed (called by Host_Clock.c).
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Host_Sim_Clock_Changed(void);
+
+/**
+ * @brief Sets the clock back to 3 MHz (CLOCK_PROFILE_3MHZ) as out of reset, without calling the clock change handlers.
+ *
+ * This function is called by Host_Sim_Reset. The drivers must be initialized again after a reset.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Host_Clock_Reset(void);
+
+/**
+ * @brief Delivers the interrupts that are requested, enabled, and not masked, in order of priority.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Host_Sim_Check_Interrupts(void);
+
+/**
+ * @brief Emulates the instructions of CortexM_Inline.h and CortexM.c (CPSIE I, CPSID I, WFI, DSB, ISB).
+ *
+ * WFI advances the simulated time until an interrupt is requested, for at most one second,
+ * and never past the time of the next change of Host_Sim_Run.
+ *
+ * @param instruction The instruction.
+ *
+ * @return None
+ */
+void Host_Sim_Instruction(const char *instruction);
+
+#endif /* HOST_SIM_H_ */
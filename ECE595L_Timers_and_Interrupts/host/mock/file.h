@@ -0,0 +1,30 @@
+/**
+ * @file file.h
+ * @brief Mock of the device driver interface of the TI C run-time library for the host simulation build.
+ *
+ * EUSCI_A0_UART_Init_Printf registers the UART as a device with add_device. On the host, add_device (in Host_Sim.c)
+ * does nothing and returns -1, so the harness must use EUSCI_A0_UART_Init instead, which leaves stdout as it is.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef FILE_H_
+#define FILE_H_
+
+#include <sys/types.h>
+
+// Stream type of add_device (single stream)
+#define _SSA 0
+
+int add_device(char *name,
+               unsigned flags,
+               int (*dopen)(const char *path, unsigned flags, int llv_fd),
+               int (*dclose)(int dev_fd),
+               int (*dread)(int dev_fd, char *buf, unsigned count),
+               int (*dwrite)(int dev_fd, const char *buf, unsigned count),
+               off_t (*dlseek)(int dev_fd, off_t offset, int origin),
+               int (*dunlink)(const char *path),
+               int (*drename)(const char *old_name, const char *new_name));
+
+#endif /* FILE_H_ */
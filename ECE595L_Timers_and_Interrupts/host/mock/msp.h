@@ -0,0 +1,414 @@
+/**
+ * @file msp.h
+ * @brief Register mock of the MSP432P401R device header for the host simulation build.
+ *
+ * This file replaces the msp.h header of the TI device support package when the drivers are compiled on the host
+ * (see host/Makefile). Each peripheral used by the drivers is a structure in RAM with the same register names,
+ * so the driver code is compiled without changes. The layouts are not the layouts of the device, only the names are kept.
+ *
+ * The registers that have a side effect when they are read are accessed through a hook of the simulator (see Host_Sim.h):
+ *  - PxIV and TAxIV return the highest pending interrupt of the handler that reads them and clear its flag
+ *  - EUSCI_A0->TXBUF stores each written character in the capture buffer of the simulator
+ *  - EUSCI_A0->RXBUF clears RXIFG
+ *  - SysTick->VAL and DWT->CYCCNT advance the simulated time by HOST_SIM_READ_CYCLES, so busy-waits terminate
+ *  - NVIC->ISER, ICER, ISPR, and ICPR only change the bits that are written as 1 (they read as 0)
+ *  - The data input registers of CRC32 update the signatures in INIRES and RESR (only 8-bit writes are simulated)
+ * The hook is the index of a one-element array, e.g. P4->IV expands to P4->IV_register[Host_Sim_Read_IV()].
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef MSP_H_
+#define MSP_H_
+
+#include <stdint.h>
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+
+// Interrupt numbers (the exception number minus 16), same values as the device header
+typedef enum
+{
+    NonMaskableInt_IRQn     = -14,
+    HardFault_IRQn          = -13,
+    MemoryManagement_IRQn   = -12,
+    BusFault_IRQn           = -11,
+    UsageFault_IRQn         = -10,
+    SVCall_IRQn             = -5,
+    DebugMonitor_IRQn       = -4,
+    PendSV_IRQn             = -2,
+    SysTick_IRQn            = -1,
+    PSS_IRQn                = 0,
+    CS_IRQn                 = 1,
+    PCM_IRQn                = 2,
+    WDT_A_IRQn              = 3,
+    FPU_IRQn                = 4,
+    FLCTL_IRQn              = 5,
+    COMP_E0_IRQn            = 6,
+    COMP_E1_IRQn            = 7,
+    TA0_0_IRQn              = 8,
+    TA0_N_IRQn              = 9,
+    TA1_0_IRQn              = 10,
+    TA1_N_IRQn              = 11,
+    TA2_0_IRQn              = 12,
+    TA2_N_IRQn              = 13,
+    TA3_0_IRQn              = 14,
+    TA3_N_IRQn              = 15,
+    EUSCIA0_IRQn            = 16,
+    EUSCIA1_IRQn            = 17,
+    EUSCIA2_IRQn            = 18,
+    EUSCIA3_IRQn            = 19,
+    EUSCIB0_IRQn            = 20,
+    EUSCIB1_IRQn            = 21,
+    EUSCIB2_IRQn            = 22,
+    EUSCIB3_IRQn            = 23,
+    ADC14_IRQn              = 24,
+    T32_INT1_IRQn           = 25,
+    T32_INT2_IRQn           = 26,
+    T32_INTC_IRQn           = 27,
+    AES256_IRQn             = 28,
+    RTC_C_IRQn              = 29,
+    DMA_ERR_IRQn            = 30,
+    DMA_INT3_IRQn           = 31,
+    DMA_INT2_IRQn           = 32,
+    DMA_INT1_IRQn           = 33,
+    DMA_INT0_IRQn           = 34,
+    PORT1_IRQn              = 35,
+    PORT2_IRQn              = 36,
+    PORT3_IRQn              = 37,
+    PORT4_IRQn              = 38,
+    PORT5_IRQn              = 39,
+    PORT6_IRQn              = 40
+} IRQn_Type;
+
+// Digital I/O ports (P1 to P10 and PJ)
+// OUT, SEL0, and SEL1 are cleared with "&= ~0xFF" by the drivers, which gcc reports as an overflow of an 8-bit value.
+// They are stored in 16 bits on the host, and only hold the 8-bit values written by the drivers.
+typedef struct
+{
+    __I  uint8_t IN;
+    __IO uint16_t OUT;
+    __IO uint8_t DIR;
+    __IO uint8_t REN;
+    __IO uint8_t DS;
+    __IO uint16_t SEL0;
+    __IO uint16_t SEL1;
+    __IO uint8_t SELC;
+    __IO uint8_t IES;
+    __IO uint8_t IE;
+    __IO uint8_t IFG;
+    __I  uint16_t IV_register[1];
+} DIO_PORT_Interruptable_Type;
+
+typedef DIO_PORT_Interruptable_Type DIO_PORT_Odd_Interruptable_Type;
+typedef DIO_PORT_Interruptable_Type DIO_PORT_Even_Interruptable_Type;
+typedef DIO_PORT_Interruptable_Type DIO_PORT_Not_Interruptable_Type;
+
+// Port mapping controller
+typedef struct
+{
+    __IO uint16_t KEYID;
+    __IO uint16_t CTL;
+} PMAP_COMMON_Type;
+
+typedef struct
+{
+    __IO uint8_t PMAP_REGISTER[8];
+} PMAP_REGISTER_Type;
+
+// eUSCI_A (UART mode)
+typedef struct
+{
+    __IO uint16_t CTLW0;
+    __IO uint16_t CTLW1;
+    __IO uint16_t BRW;
+    __IO uint16_t MCTLW;
+    __IO uint16_t STATW;
+    __I  uint16_t RXBUF_register[1];
+    __IO uint16_t TXBUF_register[1];
+    __IO uint16_t ABCTL;
+    __IO uint16_t IRCTL;
+    __IO uint16_t IE;
+    __IO uint16_t IFG;
+    __I  uint16_t IV;
+} EUSCI_A_Type;
+
+// Timer_A
+typedef struct
+{
+    __IO uint16_t CTL;
+    __IO uint16_t CCTL[7];
+    __IO uint16_t R;
+    __IO uint16_t CCR[7];
+    __IO uint16_t EX0;
+    __I  uint16_t IV_register[1];
+} Timer_A_Type;
+
+// Timer32
+typedef struct
+{
+    __IO uint32_t LOAD;
+    __I  uint32_t VALUE;
+    __IO uint32_t CONTROL;
+    __O  uint32_t INTCLR;
+    __I  uint32_t RIS;
+    __I  uint32_t MIS;
+    __IO uint32_t BGLOAD;
+} Timer32_Type;
+
+// DMA
+typedef struct
+{
+    __I  uint32_t DEVICE_CFG;
+    __IO uint32_t SW_CHTRIG;
+    __IO uint32_t CH_SRCCFG[32];
+    __IO uint32_t INT1_SRCCFG;
+    __IO uint32_t INT2_SRCCFG;
+    __IO uint32_t INT3_SRCCFG;
+    __I  uint32_t INT0_SRCFLG;
+    __O  uint32_t INT0_CLRFLG;
+} DMA_Channel_Type;
+
+typedef struct
+{
+    __I  uint32_t STAT;
+    __O  uint32_t CFG;
+    __IO uintptr_t CTLBASE;
+    __I  uint32_t ALTBASE;
+    __I  uint32_t WAITSTAT;
+    __O  uint32_t SWREQ;
+    __IO uint32_t USEBURSTSET;
+    __O  uint32_t USEBURSTCLR;
+    __IO uint32_t REQMASKSET;
+    __O  uint32_t REQMASKCLR;
+    __IO uint32_t ENASET;
+    __O  uint32_t ENACLR;
+    __IO uint32_t ALTSET;
+    __O  uint32_t ALTCLR;
+    __IO uint32_t PRIOSET;
+    __O  uint32_t PRIOCLR;
+    __IO uint32_t ERRCLR;
+} DMA_Control_Type;
+
+// CRC32
+typedef struct
+{
+    __IO uint16_t DI32_register[1];
+    __IO uint16_t DIRB32_register[1];
+    __IO uint16_t INIRES32_LO_register[1];
+    __IO uint16_t INIRES32_HI_register[1];
+    __IO uint16_t RESR32_LO_register[1];
+    __IO uint16_t RESR32_HI_register[1];
+    __IO uint16_t DI16_register[1];
+    __IO uint16_t DIRB16_register[1];
+    __IO uint16_t INIRES16_register[1];
+    __IO uint16_t RESR16_register[1];
+} CRC32_Type;
+
+// Watchdog
+typedef struct
+{
+    __IO uint16_t CTL;
+} WDT_A_Type;
+
+// SysTick
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL_register[1];
+    __I  uint32_t CALIB;
+} SysTick_Type;
+
+// System Control Block
+typedef struct
+{
+    __I  uint32_t CPUID;
+    __IO uint32_t ICSR;
+    __IO uintptr_t VTOR;          // Holds a host pointer to the vector table (see IRQ_Init)
+    __IO uint32_t AIRCR;
+    __IO uint32_t SCR;
+    __IO uint32_t CCR;
+    __IO uint8_t  SHP[12];
+    __IO uint32_t SHCSR;
+    __IO uint32_t CFSR;
+    __IO uint32_t HFSR;
+    __IO uint32_t DFSR;
+    __IO uint32_t MMFAR;
+    __IO uint32_t BFAR;
+    __IO uint32_t AFSR;
+    __IO uint32_t CPACR;
+} SCB_Type;
+
+// Nested Vectored Interrupt Controller
+typedef struct
+{
+    __IO uint32_t ISER_register[1][8];
+    __IO uint32_t ICER_register[1][8];
+    __IO uint32_t ISPR_register[1][8];
+    __IO uint32_t ICPR_register[1][8];
+    __IO uint32_t IABR[8];
+    __IO uint8_t  IP[240];
+    __O  uint32_t STIR;
+} NVIC_Type;
+
+// Data Watchpoint and Trace unit and Core Debug
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT_register[1];
+    __IO uint32_t CPICNT;
+    __IO uint32_t EXCCNT;
+    __IO uint32_t SLEEPCNT;
+    __IO uint32_t LSUCNT;
+    __IO uint32_t FOLDCNT;
+    __I  uint32_t PCSR;
+} DWT_Type;
+
+typedef struct
+{
+    __IO uint32_t DHCSR;
+    __IO uint32_t DCRSR;
+    __IO uint32_t DCRDR;
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+// Clock System, Power Control Manager, and Flash Controller (only used by Clock.c, which is replaced by Host_Clock.c)
+typedef struct
+{
+    __IO uint32_t KEY;
+    __IO uint32_t CTL0;
+    __IO uint32_t CTL1;
+    __IO uint32_t CTL2;
+    __IO uint32_t CTL3;
+    __IO uint32_t CLKEN;
+    __I  uint32_t STAT;
+    __IO uint32_t IE;
+    __I  uint32_t IFG;
+    __O  uint32_t CLRIFG;
+    __O  uint32_t SETIFG;
+} CS_Type;
+
+typedef struct
+{
+    __IO uint32_t CTL0;
+    __IO uint32_t CTL1;
+    __IO uint32_t IE;
+    __I  uint32_t IFG;
+    __O  uint32_t CLRIFG;
+} PCM_Type;
+
+typedef struct
+{
+    __IO uint32_t BANK0_RDCTL;
+    __IO uint32_t BANK1_RDCTL;
+    __IO uint32_t PRG_CTLSTAT;
+    __IO uint32_t ERASE_CTLSTAT_register[1];
+    __IO uint32_t ERASE_SECTADDR;
+    __IO uint32_t BANK0_MAIN_WEPROT;
+    __IO uint32_t BANK1_MAIN_WEPROT;
+    __I  uint32_t IFG;
+    __O  uint32_t CLRIFG;
+} FLCTL_Type;
+
+// Register instances (defined in Host_Sim.c)
+extern DIO_PORT_Interruptable_Type Host_P1, Host_P2, Host_P3, Host_P4, Host_P5, Host_P6, Host_P7, Host_P8, Host_P9, Host_P10, Host_PJ;
+extern PMAP_COMMON_Type Host_PMAP;
+extern PMAP_REGISTER_Type Host_P2MAP;
+extern EUSCI_A_Type Host_EUSCI_A0;
+extern Timer_A_Type Host_TIMER_A0, Host_TIMER_A1, Host_TIMER_A2, Host_TIMER_A3;
+extern Timer32_Type Host_TIMER32_1, Host_TIMER32_2;
+extern DMA_Channel_Type Host_DMA_Channel;
+extern DMA_Control_Type Host_DMA_Control;
+extern CRC32_Type Host_CRC32;
+extern WDT_A_Type Host_WDT_A;
+extern SysTick_Type Host_SysTick;
+extern SCB_Type Host_SCB;
+extern NVIC_Type Host_NVIC;
+extern DWT_Type Host_DWT;
+extern CoreDebug_Type Host_CoreDebug;
+extern CS_Type Host_CS;
+extern PCM_Type Host_PCM;
+extern FLCTL_Type Host_FLCTL;
+
+// The addresses are constants, so they can be used in static initializers (e.g. the port table of the Debounce driver)
+#define P1              (&Host_P1)
+#define P2              (&Host_P2)
+#define P3              (&Host_P3)
+#define P4              (&Host_P4)
+#define P5              (&Host_P5)
+#define P6              (&Host_P6)
+#define P7              (&Host_P7)
+#define P8              (&Host_P8)
+#define P9              (&Host_P9)
+#define P10             (&Host_P10)
+#define PJ              (&Host_PJ)
+#define PMAP            (&Host_PMAP)
+#define P2MAP           (&Host_P2MAP)
+#define EUSCI_A0        (&Host_EUSCI_A0)
+#define TIMER_A0        (&Host_TIMER_A0)
+#define TIMER_A1        (&Host_TIMER_A1)
+#define TIMER_A2        (&Host_TIMER_A2)
+#define TIMER_A3        (&Host_TIMER_A3)
+#define TIMER32_1       (&Host_TIMER32_1)
+#define TIMER32_2       (&Host_TIMER32_2)
+#define DMA_Channel     (&Host_DMA_Channel)
+#define DMA_Control     (&Host_DMA_Control)
+#define CRC32           (&Host_CRC32)
+#define WDT_A           (&Host_WDT_A)
+#define SysTick         (&Host_SysTick)
+#define SCB             (&Host_SCB)
+#define NVIC            (&Host_NVIC)
+#define DWT             (&Host_DWT)
+#define CoreDebug       (&Host_CoreDebug)
+#define CS              (&Host_CS)
+#define PCM             (&Host_PCM)
+#define FLCTL           (&Host_FLCTL)
+
+// Register hooks of the simulator (see Host_Sim.c)
+uint32_t Host_Sim_Read_IV(void);
+uint32_t Host_Sim_TXBUF_Index(void);
+uint32_t Host_Sim_Read_RXBUF(void);
+uint32_t Host_Sim_Read_VAL(void);
+uint32_t Host_Sim_Read_CYCCNT(void);
+uint32_t Host_Sim_NVIC_Access(void);
+uint32_t Host_Sim_CRC32_Access(uint8_t data_input);
+uint32_t Host_Sim_FLCTL_Erase_Access(void);
+
+// Words of the simulated main flash at an address of the memory map (e.g. 0x0003E000)
+volatile uint32_t *Host_Sim_Flash(uint32_t address);
+
+// Registers of CRC32 passed to Host_Sim_CRC32_Access (0 for the signature registers)
+#define HOST_SIM_CRC32_DI32     1
+#define HOST_SIM_CRC32_DIRB32   2
+#define HOST_SIM_CRC32_DI16     3
+#define HOST_SIM_CRC32_DIRB16   4
+
+#define IV              IV_register[Host_Sim_Read_IV()]
+#define TXBUF           TXBUF_register[Host_Sim_TXBUF_Index()]
+#define RXBUF           RXBUF_register[Host_Sim_Read_RXBUF()]
+#define VAL             VAL_register[Host_Sim_Read_VAL()]
+#define CYCCNT          CYCCNT_register[Host_Sim_Read_CYCCNT()]
+#define ISER            ISER_register[Host_Sim_NVIC_Access()]
+#define ICER            ICER_register[Host_Sim_NVIC_Access()]
+#define ISPR            ISPR_register[Host_Sim_NVIC_Access()]
+#define ICPR            ICPR_register[Host_Sim_NVIC_Access()]
+#define DI32            DI32_register[Host_Sim_CRC32_Access(HOST_SIM_CRC32_DI32)]
+#define DIRB32          DIRB32_register[Host_Sim_CRC32_Access(HOST_SIM_CRC32_DIRB32)]
+#define DI16            DI16_register[Host_Sim_CRC32_Access(HOST_SIM_CRC32_DI16)]
+#define DIRB16          DIRB16_register[Host_Sim_CRC32_Access(HOST_SIM_CRC32_DIRB16)]
+#define INIRES32_LO     INIRES32_LO_register[Host_Sim_CRC32_Access(0)]
+#define INIRES32_HI     INIRES32_HI_register[Host_Sim_CRC32_Access(0)]
+#define RESR32_LO       RESR32_LO_register[Host_Sim_CRC32_Access(0)]
+#define RESR32_HI       RESR32_HI_register[Host_Sim_CRC32_Access(0)]
+#define INIRES16        INIRES16_register[Host_Sim_CRC32_Access(0)]
+#define RESR16          RESR16_register[Host_Sim_CRC32_Access(0)]
+#define ERASE_CTLSTAT   ERASE_CTLSTAT_register[Host_Sim_FLCTL_Erase_Access()]
+
+#define SCB_ICSR_PENDSTSET_Msk      (1UL << 26)
+#define SCB_SCR_SLEEPONEXIT_Msk     (1UL << 1)
+#define SCB_SCR_SLEEPDEEP_Msk       (1UL << 2)
+
+#endif /* MSP_H_ */
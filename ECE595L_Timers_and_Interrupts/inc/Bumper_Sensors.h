@@ -32,39 +32,57 @@
 
 #include <stdint.h>
 #include "msp.h"
+#include "../inc/Event_Queue.h"
+#include "../inc/ISR_Profiler.h"
+#include "../inc/Debounce.h"
 
 /**
- * @brief User-defined task function for handling Bumper Sensor interrupt events.
- *
- * This is a user-defined function that can be assigned to the Bumper_Task pointer during initialization.
- * When a falling edge event is detected on any of the Bump Sensor pins (P4.7, P4.6, P4.5, P4.3, P4.2, or P4.0),
- * this function will be called, and the bumper_sensor_state parameter will indicate which specific bumper switch triggered the interrupt.
- *
- * @param bumper_sensor_state An 8-bit unsigned integer representing the Bump Sensor that triggered the interrupt.
- *                   The bit positions correspond to the following sensors:
- *                   - Bit 7 (MSB): P4.7 Bump Sensor
- *                   - Bit 6: P4.6 Bump Sensor
- *                   - Bit 5: P4.5 Bump Sensor
- *                   - Bit 4: Reserved (unused)
- *                   - Bit 3: P4.3 Bump Sensor
- *                   - Bit 2: P4.2 Bump Sensor
- *                   - Bit 1: Reserved (unused)
- *                   - Bit 0 (LSB): P4.0 Bump Sensor
+ * @brief Default debounce window of each bumper switch in ms.
+ */
+#define BUMPER_SENSORS_DEBOUNCE_MS 300
+
+/**
+ * @brief Port pins of the right bumper switches (BUMP_0 - BUMP_2: P4.0, P4.2, P4.3).
+ * Can be used as the pin mask of Event_Queue_Subscribe.
+ */
+#define BUMPER_SENSORS_RIGHT_PINS 0x0D
+
+/**
+ * @brief Port pins of the left bumper switches (BUMP_3 - BUMP_5: P4.5 - P4.7).
+ * Can be used as the pin mask of Event_Queue_Subscribe.
+ */
+#define BUMPER_SENSORS_LEFT_PINS 0xE0
+
+/**
+ * @brief Sample of the bumper switches captured by Bumper_Read_Burst.
  *
- * @return None
+ *  - timestamp: Lower 32 bits of Time_NowCycles when the sample was read (rolls over every 89 seconds at 48 MHz)
+ *  - state: State of the switches in the format returned by Bumper_Read
  */
-void (*Bumper_Task)(uint8_t bumper_sensor_state);
+typedef struct
+{
+    uint32_t timestamp;
+    uint8_t state;
+} Bumper_Sample;
 
 /**
  * @brief Initialize the Bumper Sensors and set up interrupt handling.
  *
  * This function initializes the bumper sensors and sets up the necessary configurations for interrupt handling.
- * The specified task function will be called when a falling edge event is detected on any of the following pins
- * used by the bumper sensors.
+ * When a falling edge event is detected on any of the pins used by the bumper sensors, PORT4_IRQHandler pushes
+ * an EVENT_SOURCE_BUMPER_SENSORS event into the Event_Queue for each switch whose interrupt flag is set.
+ * The event holds the pin of the switch and its new level. The specified task function is subscribed to
+ * the events of all switches, so it is called from Event_Queue_Dispatch in the main loop instead of in interrupt context.
+ *
+ * Each switch is debounced separately by the Debounce driver with a window of Config_Values.bumper_sensors_debounce_ms
+ * (BUMPER_SENSORS_DEBOUNCE_MS unless it was changed with the Config driver).
+ * The window of a switch can be changed with Debounce_Set_Window(DEBOUNCE_PORT_P4, pin, window_ms).
  *
- * The specified task function should take a single uint8_t parameter.
+ * The specified task function should take a single uint8_t parameter, which holds the state of the bumper switches
+ * when the interrupt occurred (in the format of Bumper_Read). Additional handlers can be subscribed to specific
+ * switches with Event_Queue_Subscribe and the BUMPER_SENSORS_RIGHT_PINS / BUMPER_SENSORS_LEFT_PINS masks.
  *
- * @param task A pointer to the user-defined function that will be called on a falling edge event.
+ * @param task A pointer to the user-defined function that will be called for each falling edge event, or NULL.
  *
  * @return None
  */
@@ -78,6 +96,8 @@ void Bumper_Sensors_Init(void(*task)(uint8_t));
  * represented as a uint8_t variable. Each bit of the result corresponds to one switch, where Bit 5 represents BUMP_5,
  * Bit 4 represents BUMP_4, and so on until Bit 0, which represents BUMP_0.
  *
+ * The value of P4->IN is converted with a 256-entry lookup table, so each call takes the same number of cycles.
+ *
  *  @note The Bumper Switches have negative logic behavior, where a logic high indicates a released (open) switch,
  *       and a logic low represents a pressed (closed) switch.
  *
@@ -85,4 +105,33 @@ void Bumper_Sensors_Init(void(*task)(uint8_t));
  */
 uint8_t Bumper_Read(void);
 
+/**
+ * @brief Read the state of the 6 Bumper Switches several times into a buffer.
+ *
+ * This function captures 'count' consecutive samples of the switches, each with a timestamp from Time_NowCycles,
+ * so that the samples can be filtered as a block. The function returns after the last sample has been read.
+ *
+ * @param samples         A pointer to the buffer that stores the samples. It must hold at least 'count' samples.
+ * @param count           The number of samples to read.
+ * @param interval_cycles The number of clock cycles between samples. For example, 9600 results in 5 kHz sampling at 48 MHz.
+ *                        A value of 0 reads the samples as fast as possible.
+ *
+ * @note Time_Init must be called before this function.
+ *
+ * @return None
+ */
+void Bumper_Read_Burst(Bumper_Sample *samples, uint16_t count, uint32_t interval_cycles);
+
+/**
+ * @brief Selects whether the switches generate events for both the press and the release.
+ *
+ * When enabled, the edge select (IES) of each switch is toggled after each edge, so a release generates an event
+ * with a level of 1 (see Event_Queue_Get_Levels). When disabled, only the falling edge (press) generates an event.
+ *
+ * @param enable 1 to report both edges, or 0 to report only the press.
+ *
+ * @return None
+ */
+void Bumper_Sensors_Set_Both_Edges(uint8_t enable);
+
 #endif /* BUMPER_SENSORS_H_ */
@@ -0,0 +1,148 @@
+/**
+ * @file CRC.h
+ * @brief Header file for the CRC driver.
+ *
+ * This file contains the function definitions for the CRC driver.
+ * It computes checksums with the CRC32 module, which has a 32-bit and a 16-bit engine.
+ * Each byte written to the module is processed in one clock cycle, so the CPU only writes the data
+ * (or the DMA does) instead of running a software loop for every bit.
+ *
+ * Supported checksums:
+ *  - CRC_MODE_CRC32:        CRC-32 (ISO 3309, also used by Ethernet and zlib), polynomial 0x04C11DB7, reflected,
+ *                           initial value 0xFFFFFFFF and final XOR 0xFFFFFFFF. The check value of "123456789" is 0xCBF43926.
+ *  - CRC_MODE_CRC16_CCITT:  CRC-16/CCITT-FALSE, polynomial 0x1021, not reflected, initial value 0xFFFF.
+ *                           This is the checksum of the Telemetry records. The check value of "123456789" is 0x29B1.
+ *
+ * A computation is started with CRC_Start, fed with CRC_Feed or CRC_Feed_DMA as many times as needed,
+ * and completed with CRC_Finalize. The two engines are independent, so one computation of each mode can be in progress.
+ *
+ * Usage:
+ *
+ *      CRC_Start(CRC_MODE_CRC32, CRC_CRC32_INITIAL);
+ *      CRC_Feed(CRC_MODE_CRC32, header, sizeof(header));
+ *      CRC_Feed_DMA(CRC_MODE_CRC32, block, block_size);
+ *      ... other work while the DMA feeds the block ...
+ *      uint32_t crc = CRC_Finalize(CRC_MODE_CRC32);
+ *
+ * For more information regarding the CRC32 module, refer to the CRC32 Module section (7)
+ * of the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @note The engines hold the state of the computation, so the functions must not be called from interrupt handlers
+ *       that can preempt a computation of the same mode (e.g. they are called from the main loop, like printf).
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef CRC_H_
+#define CRC_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+/**
+ * @brief DMA channel used by CRC_Feed_DMA (a software-triggered channel, so source 0 is selected)
+ */
+#define CRC_DMA_CHANNEL 7
+
+/**
+ * @brief Value of 'crc' passed to CRC_Start to start a new CRC-32 computation
+ */
+#define CRC_CRC32_INITIAL 0x00000000
+
+/**
+ * @brief Value of 'crc' passed to CRC_Start to start a new CRC-16/CCITT-FALSE computation
+ */
+#define CRC_CRC16_INITIAL 0xFFFF
+
+/**
+ * @brief Checksums computed by the CRC32 module.
+ */
+typedef enum
+{
+    CRC_MODE_CRC32 = 0,
+    CRC_MODE_CRC16_CCITT = 1
+} CRC_Mode;
+
+/**
+ * @brief Initializes the DMA channel used by CRC_Feed_DMA.
+ *
+ * It is called by CRC_Feed_DMA, and only the first call has an effect.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void CRC_Init(void);
+
+/**
+ * @brief Starts a computation.
+ *
+ * @param mode The checksum to compute.
+ * @param crc  CRC_CRC32_INITIAL or CRC_CRC16_INITIAL to start a new computation,
+ *             or a value returned by CRC_Finalize to continue that computation with more data.
+ *
+ * @return None
+ */
+void CRC_Start(CRC_Mode mode, uint32_t crc);
+
+/**
+ * @brief Feeds a buffer to a computation with the CPU.
+ *
+ * If a transfer of CRC_Feed_DMA is in progress, this function waits for it first, so the data is processed in order.
+ *
+ * @param mode   The checksum that was passed to CRC_Start.
+ * @param data   Pointer to the data.
+ * @param length Length of the data in bytes.
+ *
+ * @return None
+ */
+void CRC_Feed(CRC_Mode mode, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief Feeds a buffer to a computation with the DMA.
+ *
+ * The function returns when the last block of DMA_MAX_TRANSFER_SIZE bytes has been started,
+ * so the CPU can do other work during the transfer of buffers up to this size.
+ *
+ * @param mode   The checksum that was passed to CRC_Start.
+ * @param data   Pointer to the data. It must not be modified until CRC_Busy returns 0.
+ * @param length Length of the data in bytes.
+ *
+ * @note In the host simulation build (HOST_BUILD), the DMA controller is not simulated, so the data is fed by the CPU.
+ *
+ * @return None
+ */
+void CRC_Feed_DMA(CRC_Mode mode, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief Returns 1 if a transfer of CRC_Feed_DMA is in progress.
+ *
+ * @param None
+ *
+ * @return 1 if the DMA is still feeding the module, otherwise 0.
+ */
+uint8_t CRC_Busy(void);
+
+/**
+ * @brief Waits for the DMA transfer in progress, if any, and returns the checksum of the data fed since CRC_Start.
+ *
+ * @param mode The checksum that was passed to CRC_Start.
+ *
+ * @return The checksum (16 bits for CRC_MODE_CRC16_CCITT).
+ */
+uint32_t CRC_Finalize(CRC_Mode mode);
+
+/**
+ * @brief Computes the checksum of a buffer with the CPU (CRC_Start, CRC_Feed, and CRC_Finalize).
+ *
+ * @param mode   The checksum to compute.
+ * @param crc    CRC_CRC32_INITIAL or CRC_CRC16_INITIAL, or the result of a previous call to continue the computation.
+ * @param data   Pointer to the data.
+ * @param length Length of the data in bytes.
+ *
+ * @return The checksum.
+ */
+uint32_t CRC_Compute(CRC_Mode mode, uint32_t crc, const uint8_t *data, uint32_t length);
+
+#endif /* CRC_H_ */
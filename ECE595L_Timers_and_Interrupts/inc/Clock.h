@@ -1,7 +1,7 @@
 /**
  * @file      Clock.h
  * @brief     Provide functions that initialize the MSP432 clock module
- * @details   Reconfigure MSP432 to run at 48 MHz
+ * @details   Reconfigure MSP432 to run at 48 MHz, or switch between clock profiles at runtime
  * @version   V1.0
  * @author    Valvano
  * @copyright Copyright 2017 by Jonathan W. Valvano, valvano@mail.utexas.edu,
@@ -48,34 +48,121 @@ those of the authors and should not be interpreted as representing official
 policies, either expressed or implied, of the FreeBSD Project.
 */
 
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+#include <stdint.h>
+
+// Maximum number of functions that can be registered with Clock_AddChangeHandler
+#define CLOCK_MAX_CHANGE_HANDLERS 8
+
+/**
+ * Clock tree profiles (ACLK is always REFOCLK at 32.768 kHz)
+ *  - CLOCK_PROFILE_48MHZ: MCLK = HFXT 48 MHz, SMCLK = 12 MHz, VCORE1, 2 flash wait states
+ *  - CLOCK_PROFILE_24MHZ: MCLK = DCO 24 MHz, SMCLK = 12 MHz, VCORE0, 1 flash wait state
+ *  - CLOCK_PROFILE_12MHZ: MCLK = DCO 12 MHz, SMCLK = 12 MHz, VCORE0, 0 flash wait states
+ *  - CLOCK_PROFILE_3MHZ:  MCLK = DCO 3 MHz, SMCLK = 3 MHz, VCORE0, 0 flash wait states (same MCLK and SMCLK as out of reset)
+ * The DCO profiles are not as accurate as the crystal (see the DCO section of the datasheet).
+ */
+typedef enum
+{
+    CLOCK_PROFILE_48MHZ = 0,
+    CLOCK_PROFILE_24MHZ,
+    CLOCK_PROFILE_12MHZ,
+    CLOCK_PROFILE_3MHZ,
+    CLOCK_NUM_PROFILES
+} Clock_Profile;
+
+/**
+ * Function called after a clock profile switch
+ * @param previous_mclk  is the MCLK frequency of the previous profile in Hz
+ * @param previous_smclk is the SMCLK frequency of the previous profile in Hz
+ */
+typedef void (*Clock_Change_Handler)(uint32_t previous_mclk, uint32_t previous_smclk);
+
 /**
  * Configure the MSP432 clock to run at 48 MHz
  * @param none
  * @return none
  * @note  Since the crystal is used, the bus clock will be very accurate
+ * @note  Same as Clock_SetProfile(CLOCK_PROFILE_48MHZ)
  * @see Clock_GetFreq()
  * @brief  Initialize clock to 48 MHz
  */
 void Clock_Init48MHz(void);
- 
+
+/**
+ * Switch the clock tree to one of the profiles of Clock_Profile
+ * The flash wait states and the PCM active mode (VCORE level) are raised
+ * before the frequency is increased, and lowered after it is decreased.
+ * HFXT is started before interrupts are disabled, so the switch itself
+ * only masks interrupts for a few microseconds plus the change handlers.
+ * The change handlers are then called in the order they were added
+ * (e.g. EUSCI_A0_UART recomputes its baud rate divider, SysTick keeps its
+ * period in time, and Time continues from the same value).
+ * @param profile is the profile to use
+ * @return 0 on success, or -1 if the profile is invalid or the PCM or
+ *         HFXT did not respond (the previous profile is kept)
+ * @note  A character that is being transmitted by EUSCI_A0 when the baud
+ *        rate changes is lost, so wait until EUSCI_A0_UART_TX_Busy returns 0
+ * @note  Must be called from the main loop, not from an interrupt handler
+ * @see Clock_GetProfile(), Clock_AddChangeHandler()
+ * @brief  Change the MCLK and SMCLK frequencies at runtime
+ */
+int8_t Clock_SetProfile(Clock_Profile profile);
+
+/**
+ * Return the current clock profile
+ * @param none
+ * @return the profile selected by Clock_SetProfile, or CLOCK_PROFILE_3MHZ
+ *         out of reset
+ * @brief Returns the current clock profile
+ */
+Clock_Profile Clock_GetProfile(void);
+
+/**
+ * Register a function that is called after each clock profile switch
+ * The handler is called with interrupts disabled, after ClockFrequency
+ * and the SMCLK frequency have been updated, with the frequencies of the
+ * previous profile as its parameters. Adding a handler that is already
+ * registered does nothing, so drivers can add it from their Init function.
+ * @param handler is the function to call
+ * @return 0 on success, or -1 if handler is 0 or CLOCK_MAX_CHANGE_HANDLERS
+ *         handlers are already registered
+ * @brief Registers a clock change handler
+ */
+int8_t Clock_AddChangeHandler(Clock_Change_Handler handler);
+
 
 /**
  * Return the current bus clock frequency
  * @param none
  * @return frequency of the system clock in Hz
- * @note  In this module, the return result will be 3000000 or 48000000
- * @see Clock_Init48MHz()
+ * @note  In this module, the return result will be 3000000, 12000000,
+ *        24000000, or 48000000
+ * @see Clock_Init48MHz(), Clock_SetProfile()
  * @brief Returns current clock bus frequency in Hz
  */
 uint32_t Clock_GetFreq(void);
 
+/**
+ * Return the current SMCLK frequency
+ * @param none
+ * @return frequency of SMCLK in Hz
+ * @note  SMCLK is 12 MHz in every profile except CLOCK_PROFILE_3MHZ,
+ *        where it is 3 MHz
+ * @brief Returns current SMCLK frequency in Hz
+ */
+uint32_t Clock_GetSMCLKFreq(void);
+
 
 /**
  * Simple delay function which delays about n milliseconds.
  * It is implemented with a nested for-loop and is very approximate.
  * @param  n is the number of msec to wait
  * @return none
- * @note This function assumes a 48 MHz clock.
+ * @note The number of loops is computed from ClockFrequency, so the delay
+ * is kept when the clock profile changes.
  * This implementation is not very accurate.
  * To improve accuracy, you could tune this function
  * by adjusting the constant within the implementation
@@ -90,7 +177,9 @@ void Clock_Delay1ms(uint32_t n);
  * It is implemented with a nested for-loop and is very approximate.
  * @param  n is the number of usec to wait
  * @return none
- * @note This function assumes a 48 MHz clock.
+ * @note The number of loops is recomputed by Clock_SetProfile, so the delay
+ * is kept when the clock profile changes. At 3 MHz, one loop takes
+ * about 4 us, so short delays are rounded down.
  * This implementation is not very accurate.
  * To improve accuracy, you could tune this function
  * by adjusting the constant within the implementation
@@ -100,4 +189,4 @@ void Clock_Delay1ms(uint32_t n);
  */
 void Clock_Delay1us(uint32_t n);
 
-
+#endif /* CLOCK_H_ */
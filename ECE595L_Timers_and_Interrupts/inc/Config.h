@@ -0,0 +1,168 @@
+/**
+ * @file Config.h
+ * @brief Header file for the Config driver.
+ *
+ * This file contains the function definitions for the Config driver.
+ * It stores the settings of the robot in flash, so they can be changed from the serial terminal without a rebuild.
+ *
+ * Config_Init loads the settings into Config_Values once at boot, and the drivers read the fields of Config_Values
+ * directly (e.g. Config_Values.bumper_sensors_debounce_ms), which costs the same as reading a global variable.
+ * The settings are only used when the drivers are initialized or when they are changed, so the interrupt handlers
+ * are not affected. Config_Values is initialized with the default values, so the drivers can be used without Config_Init
+ * (e.g. in the host simulation build).
+ *
+ * Storage:
+ * The settings are stored in the last two sectors of the main flash (CONFIG_FLASH_ADDRESS, reserved in msp432p401r.cmd),
+ * which are used as a log to spread the wear of the flash:
+ *  - Each sector starts with a header that holds a sequence number. The active sector is the valid sector with the newest sequence number.
+ *  - Config_Save appends one record (key, value) for each setting that was changed. The last record of a key is its value.
+ *  - When the active sector is full, the current settings are written to the other sector, which is erased first,
+ *    and its header is written last. If the power fails before the header is written, the previous sector stays active.
+ * The header and each record take one 128-bit flash word, which is programmed once between two erases, and end with a CRC-32 (see CRC.h).
+ * A record with an invalid CRC (e.g. a write that was interrupted) or a value out of range is ignored.
+ * A setting without a record has its default value, so the defaults of a new firmware apply to the settings that were never changed.
+ *
+ * @note The functions that read or write the flash must be called from the main loop. Config_Save stalls the CPU
+ *       while a sector is erased (up to a few tens of ms), so it should only be called when requested (e.g. from the Shell).
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+/**
+ * @brief Address of the first flash sector used by the Config driver (sectors 30 and 31 of bank 1)
+ */
+#define CONFIG_FLASH_ADDRESS 0x0003E000
+
+/**
+ * @brief Size of a flash sector in bytes
+ */
+#define CONFIG_SECTOR_SIZE 4096
+
+/**
+ * @brief Number of flash sectors used by the Config driver
+ */
+#define CONFIG_NUM_SECTORS 2
+
+/**
+ * @brief Settings. The value of each key is stored in the field of Config_Settings with the same name.
+ *
+ * The values of the keys are stored in flash, so a key must not be renumbered. New keys are added at the end.
+ */
+typedef enum
+{
+    CONFIG_KEY_SYSTICK_TOGGLE_RATE_MS = 0,
+    CONFIG_KEY_SYSTICK_2S_TOGGLE_RATE_MS = 1,
+    CONFIG_KEY_SYSTICK_NUM_CLK_CYCLES = 2,
+    CONFIG_KEY_SYSTICK_PRIORITY = 3,
+    CONFIG_KEY_BUMPER_SENSORS_DEBOUNCE_MS = 4,
+    CONFIG_KEY_PMOD_BTN_DEBOUNCE_MS = 5,
+    CONFIG_NUM_KEYS
+} Config_Key;
+
+/**
+ * @brief Current values of the settings.
+ */
+typedef struct
+{
+    uint32_t systick_toggle_rate_ms;        // Period of the LED1 toggle task (default SYSTICK_INT_TOGGLE_RATE_MS)
+    uint32_t systick_2s_toggle_rate_ms;     // Period of the back left LED toggle task (default SYSTICK_INT_2S_TOGGLE_RATE_MS)
+    uint32_t systick_num_clk_cycles;        // Number of 48 MHz clock cycles per SysTick interrupt (default SYSTICK_INT_NUM_CLK_CYCLES)
+    uint32_t systick_priority;              // Priority of the SysTick interrupt (default SYSTICK_INT_PRIORITY)
+    uint32_t bumper_sensors_debounce_ms;    // Debounce window of the bumper switches (default BUMPER_SENSORS_DEBOUNCE_MS)
+    uint32_t pmod_btn_debounce_ms;          // Debounce window of the push buttons (default PMOD_BTN_DEBOUNCE_MS)
+} Config_Settings;
+
+/**
+ * @brief Current settings, read directly by the drivers. It must only be modified with Config_Set or Config_Reset_Defaults.
+ */
+extern Config_Settings Config_Values;
+
+/**
+ * @brief Loads the settings stored in flash into Config_Values.
+ *
+ * The settings that are not stored, or that are invalid, keep their default values.
+ * It should be called once at boot, after the clock is initialized and before the drivers that use the settings.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Config_Init(void);
+
+/**
+ * @brief Returns the key of a setting from its name (e.g. "bumper_sensors_debounce_ms").
+ *
+ * @param name The name of the setting.
+ *
+ * @return The key, or CONFIG_NUM_KEYS if there is no setting with this name.
+ */
+Config_Key Config_Find_Key(const char *name);
+
+/**
+ * @brief Returns the name of a setting, which is the name of its field in Config_Settings.
+ *
+ * @param key The key.
+ *
+ * @return The name, or 0 if the key is invalid.
+ */
+const char *Config_Get_Name(Config_Key key);
+
+/**
+ * @brief Returns the current value of a setting.
+ *
+ * @param key The key.
+ *
+ * @return The value, or 0 if the key is invalid.
+ */
+uint32_t Config_Get(Config_Key key);
+
+/**
+ * @brief Returns the default value and the range of a setting.
+ *
+ * @param key           The key.
+ * @param default_value Pointer to the variable that stores the default value. It can be 0.
+ * @param min           Pointer to the variable that stores the minimum value. It can be 0.
+ * @param max           Pointer to the variable that stores the maximum value. It can be 0.
+ *
+ * @return 0 on success, or -1 if the key is invalid.
+ */
+int8_t Config_Get_Range(Config_Key key, uint32_t *default_value, uint32_t *min, uint32_t *max);
+
+/**
+ * @brief Changes the value of a setting in Config_Values. The value is only stored in flash by Config_Save.
+ *
+ * The drivers are not reconfigured by this function, so the caller applies the new value (e.g. with Debounce_Set_Window).
+ *
+ * @param key   The key.
+ * @param value The new value. It must be in the range returned by Config_Get_Range.
+ *
+ * @return 0 on success, or -1 if the key is invalid or the value is out of range.
+ */
+int8_t Config_Set(Config_Key key, uint32_t value);
+
+/**
+ * @brief Sets all the settings of Config_Values to their default values. They are only stored in flash by Config_Save.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Config_Reset_Defaults(void);
+
+/**
+ * @brief Stores the settings that were changed since Config_Init or the last Config_Save in flash.
+ *
+ * @param None
+ *
+ * @return 0 on success, or -1 if the flash could not be programmed or erased.
+ */
+int8_t Config_Save(void);
+
+#endif /* CONFIG_H_ */
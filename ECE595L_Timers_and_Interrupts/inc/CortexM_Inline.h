@@ -0,0 +1,112 @@
+/**
+ * @file CortexM_Inline.h
+ * @brief Inline versions of the CortexM functions and memory barriers.
+ *
+ * This file contains static inline functions that compile to a single instruction where they are used,
+ * instead of a call to the functions of CortexM.c (which contain the instruction followed by BX LR):
+ *  - CortexM_Enable_Interrupts (CPSIE I), same as EnableInterrupts
+ *  - CortexM_Disable_Interrupts (CPSID I), same as DisableInterrupts
+ *  - CortexM_Wait_For_Interrupt (WFI), same as WaitForInterrupt
+ *
+ * It also contains the memory barriers:
+ *  - CortexM_DSB: waits until all memory accesses have completed. It should be used after clearing an interrupt flag
+ *    at the end of a handler (so the flag is cleared before the exception return and the handler is not entered again),
+ *    and before WFI (so the writes that prepare the sleep are done).
+ *  - CortexM_ISB: flushes the pipeline, so the following instructions see the effect of the previous ones
+ *    (e.g. after enabling an interrupt in NVIC or after a change of the sleep mode).
+ *  - CortexM_Sleep: DSB, WFI, and ISB, which is the sequence used to enter a low-power mode.
+ *
+ * The TI ARM compiler inlines its __asm statements, and GCC and Clang (including tiarmclang) use extended inline assembly.
+ * The "memory" clobber of the GCC version prevents the compiler from moving memory accesses across the instruction.
+ * In the host simulation build (HOST_BUILD, see host/Host_Sim.h), each instruction is emulated by Host_Sim_Instruction.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef CORTEXM_INLINE_H_
+#define CORTEXM_INLINE_H_
+
+#if defined(__TI_ARM__) && !defined(__clang__)
+
+// TI ARM compiler: the instruction must be preceded by a space
+#define CORTEXM_INLINE_ASM(instruction)     __asm(" " instruction)
+
+#elif defined(HOST_BUILD)
+
+// Host simulation build: the simulator changes PRIMASK, delivers the pending interrupts, or advances the time for WFI
+void Host_Sim_Instruction(const char *instruction);
+#define CORTEXM_INLINE_ASM(instruction)     Host_Sim_Instruction(instruction)
+
+#else
+
+// GCC and Clang
+#define CORTEXM_INLINE_ASM(instruction)     __asm volatile (instruction : : : "memory")
+
+#endif
+
+/**
+ * @brief Enables interrupts (clears PRIMASK).
+ *
+ * @return None
+ */
+static inline void CortexM_Enable_Interrupts(void)
+{
+    CORTEXM_INLINE_ASM("CPSIE I");
+}
+
+/**
+ * @brief Disables interrupts (sets PRIMASK).
+ *
+ * @return None
+ */
+static inline void CortexM_Disable_Interrupts(void)
+{
+    CORTEXM_INLINE_ASM("CPSID I");
+}
+
+/**
+ * @brief Waits for an interrupt in the low-power mode selected by SCB->SCR.
+ *
+ * An interrupt that is pending wakes up the processor even if interrupts are disabled with PRIMASK.
+ *
+ * @return None
+ */
+static inline void CortexM_Wait_For_Interrupt(void)
+{
+    CORTEXM_INLINE_ASM("WFI");
+}
+
+/**
+ * @brief Data synchronization barrier.
+ *
+ * @return None
+ */
+static inline void CortexM_DSB(void)
+{
+    CORTEXM_INLINE_ASM("DSB");
+}
+
+/**
+ * @brief Instruction synchronization barrier.
+ *
+ * @return None
+ */
+static inline void CortexM_ISB(void)
+{
+    CORTEXM_INLINE_ASM("ISB");
+}
+
+/**
+ * @brief Completes the pending writes and waits for an interrupt.
+ *
+ * @return None
+ */
+static inline void CortexM_Sleep(void)
+{
+    CortexM_DSB();
+    CortexM_Wait_For_Interrupt();
+    CortexM_ISB();
+}
+
+#endif /* CORTEXM_INLINE_H_ */
@@ -0,0 +1,207 @@
+/**
+ * @file Critical_Section.h
+ * @brief Inline critical sections based on PRIMASK or BASEPRI.
+ *
+ * This file contains static inline functions that protect data shared with interrupt handlers.
+ * Each function that enters a critical section returns the previous state, which is passed to the matching exit function,
+ * so critical sections can be nested (e.g. a function with a critical section can be called from another critical section).
+ *
+ *  - Critical_Section_Enter / Critical_Section_Exit mask all interrupts with PRIMASK (except NMI and faults).
+ *    They are needed for data that is shared with a handler of priority 0, which BASEPRI cannot mask.
+ *
+ *  - Critical_Section_Enter_Priority / Critical_Section_Exit_Priority mask only the interrupts with a priority
+ *    value greater than or equal to the specified priority with BASEPRI. Interrupts with a higher priority (lower value)
+ *    keep running. For example, Critical_Section_Enter_Priority(EUSCI_A0_UART_INT_PRIORITY) protects the UART buffers
+ *    from EUSCIA0_IRQHandler without delaying the Bumper Sensor, PMOD BTN, or SysTick interrupts.
+ *
+ * Usage:
+ *
+ *      uint32_t state = Critical_Section_Enter_Priority(3);
+ *      ... access the data shared with the handlers of priority 3 to 7 ...
+ *      Critical_Section_Exit_Priority(state);
+ *
+ * The TI ARM compiler uses its intrinsics, and GCC and Clang (including tiarmclang) use inline assembly,
+ * so each function compiles to a few instructions without a function call.
+ * In the host simulation build (HOST_BUILD, see host/Host_Sim.h), PRIMASK and BASEPRI are variables of the simulator.
+ *
+ * @note The priority of a BASEPRI critical section must be at most the priority value of every handler
+ *       that accesses the protected data. Priority 0 is not allowed, use Critical_Section_Enter instead.
+ *       With the priority grouping of IRQ_Priority.h, BASEPRI masks the whole tier of the specified priority
+ *       (e.g. Critical_Section_Enter_Priority(IRQ_PRIORITY_UART) also masks IRQ_PRIORITY_TICKLESS_WAKE).
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef CRITICAL_SECTION_H_
+#define CRITICAL_SECTION_H_
+
+#include <stdint.h>
+
+// Number of priority bits implemented by the MSP432P401R NVIC (priority values 0 to 7)
+#define CRITICAL_SECTION_PRIORITY_BITS 3
+
+#if defined(__TI_ARM__) && !defined(__clang__)
+
+// TI ARM compiler: _disable_IRQ returns the previous PRIMASK, and _set_interrupt_priority
+// writes BASEPRI and returns its previous value
+static inline uint32_t Critical_Section_Get_PRIMASK_And_Disable(void)
+{
+    return _disable_IRQ();
+}
+
+static inline void Critical_Section_Set_PRIMASK(uint32_t primask)
+{
+    _restore_interrupts(primask);
+}
+
+static inline void Critical_Section_Set_BASEPRI(uint32_t basepri)
+{
+    _set_interrupt_priority(basepri);
+}
+
+static inline uint32_t Critical_Section_Raise_BASEPRI(uint32_t basepri)
+{
+    // There is no intrinsic for BASEPRI_MAX, so mask everything while BASEPRI is compared
+    // This way the masking is never lowered, even for one instruction
+    uint32_t primask = _disable_IRQ();
+    uint32_t previous = _set_interrupt_priority(basepri);
+
+    // Keep the previous value if it masks more interrupts (a lower value other than 0)
+    if ((previous != 0) && (previous < basepri))
+    {
+        _set_interrupt_priority(previous);
+    }
+
+    _restore_interrupts(primask);
+
+    return previous;
+}
+
+#elif defined(HOST_BUILD)
+
+// Host simulation build: the simulator delivers the interrupts that were held back when PRIMASK or BASEPRI is lowered
+extern volatile uint32_t Host_PRIMASK;
+extern volatile uint32_t Host_BASEPRI;
+void Host_Sim_Check_Interrupts(void);
+
+static inline uint32_t Critical_Section_Get_PRIMASK_And_Disable(void)
+{
+    uint32_t primask = Host_PRIMASK;
+    Host_PRIMASK = 1;
+    return primask;
+}
+
+static inline void Critical_Section_Set_PRIMASK(uint32_t primask)
+{
+    Host_PRIMASK = primask;
+    if (primask == 0) Host_Sim_Check_Interrupts();
+}
+
+static inline void Critical_Section_Set_BASEPRI(uint32_t basepri)
+{
+    Host_BASEPRI = basepri;
+    Host_Sim_Check_Interrupts();
+}
+
+static inline uint32_t Critical_Section_Raise_BASEPRI(uint32_t basepri)
+{
+    uint32_t previous = Host_BASEPRI;
+
+    // Same rule as BASEPRI_MAX: only write the new value if it masks more interrupts
+    if ((basepri != 0) && ((previous == 0) || (basepri < previous)))
+    {
+        Host_BASEPRI = basepri;
+    }
+
+    return previous;
+}
+
+#else
+
+// GCC and Clang
+static inline uint32_t Critical_Section_Get_PRIMASK_And_Disable(void)
+{
+    uint32_t primask;
+    __asm volatile ("MRS %0, PRIMASK\n"
+                    "CPSID I" : "=r" (primask) : : "memory");
+    return primask;
+}
+
+static inline void Critical_Section_Set_PRIMASK(uint32_t primask)
+{
+    __asm volatile ("MSR PRIMASK, %0" : : "r" (primask) : "memory");
+}
+
+static inline void Critical_Section_Set_BASEPRI(uint32_t basepri)
+{
+    __asm volatile ("MSR BASEPRI, %0" : : "r" (basepri) : "memory");
+}
+
+static inline uint32_t Critical_Section_Raise_BASEPRI(uint32_t basepri)
+{
+    uint32_t previous;
+
+    // BASEPRI_MAX is only written if the new value masks more interrupts than the current one
+    // An interrupt between MRS and MSR restores BASEPRI before it returns, so 'previous' is still correct
+    __asm volatile ("MRS %0, BASEPRI\n"
+                    "MSR BASEPRI_MAX, %1\n"
+                    "ISB" : "=&r" (previous) : "r" (basepri) : "memory");
+    return previous;
+}
+
+#endif
+
+/**
+ * @brief Masks all interrupts with PRIMASK.
+ *
+ * @param None
+ *
+ * @return The previous value of PRIMASK, which must be passed to Critical_Section_Exit.
+ */
+static inline uint32_t Critical_Section_Enter(void)
+{
+    return Critical_Section_Get_PRIMASK_And_Disable();
+}
+
+/**
+ * @brief Restores PRIMASK to the value it had before the matching Critical_Section_Enter.
+ *
+ * Interrupts are only enabled again when the outermost critical section ends.
+ *
+ * @param state The value returned by Critical_Section_Enter.
+ *
+ * @return None
+ */
+static inline void Critical_Section_Exit(uint32_t state)
+{
+    Critical_Section_Set_PRIMASK(state);
+}
+
+/**
+ * @brief Masks the interrupts whose priority value is greater than or equal to 'priority' with BASEPRI.
+ *
+ * If a critical section that masks more interrupts is already active, BASEPRI is not changed.
+ *
+ * @param priority The lowest priority value that is masked, from 1 to 7.
+ *
+ * @return The previous value of BASEPRI, which must be passed to Critical_Section_Exit_Priority.
+ */
+static inline uint32_t Critical_Section_Enter_Priority(uint32_t priority)
+{
+    return Critical_Section_Raise_BASEPRI((priority << (8 - CRITICAL_SECTION_PRIORITY_BITS)) & 0xFF);
+}
+
+/**
+ * @brief Restores BASEPRI to the value it had before the matching Critical_Section_Enter_Priority.
+ *
+ * @param state The value returned by Critical_Section_Enter_Priority.
+ *
+ * @return None
+ */
+static inline void Critical_Section_Exit_Priority(uint32_t state)
+{
+    Critical_Section_Set_BASEPRI(state);
+}
+
+#endif /* CRITICAL_SECTION_H_ */
@@ -0,0 +1,131 @@
+/**
+ * @file DMA.h
+ * @brief Header file for the DMA driver.
+ *
+ * This file contains the function definitions for the DMA driver.
+ * It owns the channel control table of the DMA controller and provides basic-mode
+ * transfers that are used by other drivers (e.g. the EUSCI_A0_UART transmit path).
+ *
+ * For more information regarding the DMA controller, refer to the DMA section (11)
+ * of the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @note The MSP432P401R has 8 DMA channels. Each channel can be assigned to one of 8 trigger sources.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef DMA_H_
+#define DMA_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+/**
+ * @brief Number of DMA channels available on the MSP432P401R
+ */
+#define DMA_NUM_CHANNELS 8
+
+// Fields of the channel control word (section 11.2.2.3)
+#define DMA_CTRL_DST_INC_BYTE       0x00000000
+#define DMA_CTRL_DST_INC_NONE       0xC0000000
+#define DMA_CTRL_SRC_INC_BYTE       0x00000000
+#define DMA_CTRL_SRC_INC_NONE       0x0C000000
+#define DMA_CTRL_SIZE_8             0x00000000
+#define DMA_CTRL_MODE_BASIC         0x00000001
+#define DMA_CTRL_MODE_AUTO          0x00000002
+
+// Arbitration rate (R_POWER field): number of items transferred before the controller arbitrates again
+#define DMA_CTRL_ARBITRATE_1024     0x00028000
+
+/**
+ * @brief Maximum number of items in a single DMA cycle
+ */
+#define DMA_MAX_TRANSFER_SIZE 1024
+
+/**
+ * @brief Initializes the DMA controller.
+ *
+ * This function enables the DMA controller and sets the base address of the channel control table.
+ * It can be called by each driver that uses DMA, and only the first call has an effect.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void DMA_Init();
+
+/**
+ * @brief Assigns a trigger source to a DMA channel.
+ *
+ * @param channel The DMA channel (0 to 7).
+ * @param source  The trigger source for the channel (0 to 7). Refer to the device datasheet (Table 6-36)
+ *                for the list of sources. For example, channel 0 with source 1 is triggered by EUSCI_A0 TX.
+ *
+ * @return None
+ */
+void DMA_Set_Channel_Source(uint8_t channel, uint8_t source);
+
+/**
+ * @brief Starts a basic-mode transfer on a DMA channel.
+ *
+ * This function writes the primary control structure of the channel and enables the channel.
+ * One item is transferred for each trigger from the channel source. The channel is disabled
+ * by the hardware when all items have been transferred.
+ *
+ * @param channel  The DMA channel (0 to 7).
+ * @param src_end  Address of the last item of the source.
+ * @param dst_end  Address of the last item of the destination.
+ * @param control  Increment and size fields of the control word (DMA_CTRL_*).
+ * @param count    Number of items to transfer (1 to DMA_MAX_TRANSFER_SIZE).
+ *
+ * @return None
+ */
+void DMA_Start_Basic(uint8_t channel, const volatile void *src_end, volatile void *dst_end, uint32_t control, uint32_t count);
+
+/**
+ * @brief Starts an auto-mode transfer on a DMA channel with a software request.
+ *
+ * The whole transfer is performed after one request, without a trigger from a peripheral
+ * (e.g. to copy a buffer to a data input register). The channel source should be 0 (reserved on every channel),
+ * so that the channel is not also triggered by a peripheral.
+ *
+ * @param channel  The DMA channel (0 to 7).
+ * @param src_end  Address of the last item of the source.
+ * @param dst_end  Address of the last item of the destination.
+ * @param control  Increment and size fields of the control word (DMA_CTRL_*).
+ * @param count    Number of items to transfer (1 to DMA_MAX_TRANSFER_SIZE).
+ *
+ * @return None
+ */
+void DMA_Start_Software(uint8_t channel, const volatile void *src_end, volatile void *dst_end, uint32_t control, uint32_t count);
+
+/**
+ * @brief Returns 1 if the DMA channel is enabled (a transfer is still in progress).
+ *
+ * @param channel The DMA channel (0 to 7).
+ *
+ * @return 1 if the channel is enabled, otherwise 0.
+ */
+uint8_t DMA_Channel_Busy(uint8_t channel);
+
+/**
+ * @brief Routes the completion interrupt of a DMA channel to DMA_INT1, DMA_INT2, or DMA_INT3.
+ *
+ * @param interrupt_number The DMA interrupt to use (1 to 3).
+ * @param channel          The DMA channel (0 to 7).
+ *
+ * @return None
+ */
+void DMA_Set_Interrupt_Channel(uint8_t interrupt_number, uint8_t channel);
+
+/**
+ * @brief Clears the completion interrupt flag of a DMA channel.
+ *
+ * @param channel The DMA channel (0 to 7).
+ *
+ * @return None
+ */
+void DMA_Clear_Interrupt_Flag(uint8_t channel);
+
+#endif /* DMA_H_ */
@@ -0,0 +1,155 @@
+/**
+ * @file Debounce.h
+ * @brief Header file for the Debounce driver.
+ *
+ * This file contains the function definitions for the Debounce driver.
+ * It debounces each GPIO interrupt pin of P4 (Bumper Sensors) and P6 (PMOD BTN) separately.
+ * When a port interrupt handler reports an edge with Debounce_Edge, the interrupt of that pin is disabled
+ * for the debounce window of the pin, so the bounces of the switch do not generate more interrupts.
+ * When the window expires, TA2_N_IRQHandler re-samples the pin, clears its interrupt flag and enables its interrupt again.
+ * The other pins are not affected, so an edge on one pin does not hide an edge on another pin.
+ *
+ * The driver can also track both edges of a pin (see Debounce_Set_Both_Edges). After each edge, the edge select (IES)
+ * of the pin is set to the opposite edge, so both the press and the release of a switch generate an interrupt.
+ * If the level of the pin at the end of its window differs from the level at the edge (e.g. a switch that was released
+ * during the window), the change handler is called from TA2_N_IRQHandler so that the change is not lost.
+ *
+ * TIMER_A2 runs in continuous mode from ACLK (REFOCLK, 32.768 kHz), so the windows keep running in LPM3.
+ * CCR1 is set to the earliest deadline of all pins that are waiting.
+ *
+ * @note TIMER_A2 and TA2_N_IRQHandler are reserved by this driver.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef DEBOUNCE_H_
+#define DEBOUNCE_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+/**
+ * @brief Longest debounce window in ms. Longer windows are reduced to this value.
+ *
+ * The deadlines are compared with the 16-bit count of TIMER_A2 as signed differences, so a window must be
+ * at most 32767 ACLK cycles. 999 ms is 32735 cycles (1000 ms would be 32768 and would expire at once).
+ */
+#define DEBOUNCE_MAX_WINDOW_MS 999
+
+/**
+ * @brief Ports that can be debounced.
+ */
+typedef enum
+{
+    DEBOUNCE_PORT_P4 = 0,
+    DEBOUNCE_PORT_P6,
+    DEBOUNCE_NUM_PORTS
+} Debounce_Port;
+
+/**
+ * @brief Handler called when the level of a pin that tracks both edges changed during its debounce window.
+ *
+ * It is called in interrupt context (TA2_N_IRQHandler) with the pins that changed and their new level.
+ */
+typedef void (*Debounce_Change_Handler)(uint8_t pins, uint8_t level);
+
+/**
+ * @brief Initializes TIMER_A2 and its interrupt (IRQ 13).
+ *
+ * This function is called by Debounce_Configure_Port, and only the first call has an effect.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Debounce_Init();
+
+/**
+ * @brief Sets the pins of a port that are debounced and their debounce window.
+ *
+ * @param port      The port.
+ * @param pin_mask  The pins that generate interrupts (e.g. 0xED for the Bumper Sensors).
+ * @param window_ms The debounce window in ms used for all pins in 'pin_mask'. A window of 0 disables debouncing.
+ *
+ * @return None
+ */
+void Debounce_Configure_Port(Debounce_Port port, uint8_t pin_mask, uint16_t window_ms);
+
+/**
+ * @brief Sets the debounce window of one pin.
+ *
+ * @param port      The port.
+ * @param pin       The pin number (0 to 7).
+ * @param window_ms The debounce window in ms. A window of 0 disables debouncing for the pin.
+ *
+ * @return None
+ */
+void Debounce_Set_Window(Debounce_Port port, uint8_t pin, uint16_t window_ms);
+
+/**
+ * @brief Returns the debounce window of one pin in ms.
+ *
+ * @param port The port.
+ * @param pin  The pin number (0 to 7).
+ *
+ * @return The debounce window in ms.
+ */
+uint16_t Debounce_Get_Window(Debounce_Port port, uint8_t pin);
+
+/**
+ * @brief Selects the pins of a port whose edge select is toggled after each edge.
+ *
+ * When a pin is added, its edge select is set from its current level (falling edge if high, rising edge if low).
+ * When a pin is removed, its edge select is not changed, so the caller should restore the edge it uses.
+ *
+ * @param port    The port.
+ * @param pins    The pins that report both edges, or 0 to report only the edge selected by the caller.
+ * @param handler The function called when a change of level is found at the end of a debounce window, or NULL.
+ *
+ * @return None
+ */
+void Debounce_Set_Both_Edges(Debounce_Port port, uint8_t pins, Debounce_Change_Handler handler);
+
+/**
+ * @brief Starts the debounce window of the pins that generated an interrupt.
+ *
+ * This function must be called from the port interrupt handler after the interrupt flags have been cleared
+ * (e.g. by reading the IV register). It samples the new level of the pins, selects the opposite edge
+ * of the pins that report both edges, and disables the interrupt of each pin in 'pins' until its window expires.
+ *
+ * @param port The port.
+ * @param pins The pins whose interrupt flag was set.
+ *
+ * @return The level of the pins (the IN register masked with 'pins') after the edge.
+ */
+uint8_t Debounce_Edge(Debounce_Port port, uint8_t pins);
+
+/**
+ * @brief Returns the pins of a port that are waiting for their debounce window to expire.
+ *
+ * @param port The port.
+ *
+ * @return A bit mask of the pins whose interrupt is disabled.
+ */
+uint8_t Debounce_Get_Pending(Debounce_Port port);
+
+/**
+ * @brief Returns the input levels of a port that were sampled at the last edge or when the debounce windows expired.
+ *
+ * @param port The port.
+ *
+ * @return The last sampled value of the IN register for each debounced pin.
+ */
+uint8_t Debounce_Get_Stable_State(Debounce_Port port);
+
+/**
+ * @brief Interrupt handler for TIMER_A2 CCR1 to CCR4 and overflow.
+ *
+ * This function ends the debounce windows that have expired and sets CCR1 to the next deadline.
+ *
+ * @return None
+ */
+void TA2_N_IRQHandler(void);
+
+#endif /* DEBOUNCE_H_ */
@@ -0,0 +1,143 @@
+/**
+ * @file Delay.h
+ * @brief Header file for the Delay driver.
+ *
+ * This file contains the function definitions for the Delay driver.
+ * It provides busy-wait delays that compare the DWT cycle counter (CYCCNT) of the Cortex-M4 with a deadline,
+ * instead of counting down a calibrated loop like Clock_Delay1us. The delay does not depend on the optimization level,
+ * the flash wait states, or the calling convention, and it is resolved to one clock cycle (20.83 ns at 48 MHz).
+ * The short delays are inline functions, so the overhead is only a few cycles. For example, the charge time of the
+ * QTRX line sensor (10 us) and its discharge time (about 1 ms) can be timed with Delay_Us:
+ *
+ *      P7->OUT = 0xFF;     // Charge the capacitors
+ *      Delay_Us(10);
+ *      P7->DIR = 0x00;     // Let them discharge
+ *      Delay_Us(1000);
+ *
+ * Delay_Wait_Us is used for longer delays from the main loop: it sleeps (WFI) until the last SysTick period
+ * before the deadline and optionally calls a yield handler after each wake-up, then busy-waits until the deadline.
+ *
+ * The conversion from microseconds to cycles is updated when Clock_SetProfile changes the clock frequency.
+ * If an interrupt handler runs during a busy-wait, the delay is extended by the duration of the handler.
+ *
+ * For more information regarding the DWT unit, refer to the Cortex-M4 Technical Reference Manual.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef DELAY_H_
+#define DELAY_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+/**
+ * @brief Longest delay that can be passed to Delay_Ns (1 ms)
+ */
+#define DELAY_MAX_NS 1000000
+
+/**
+ * @brief Number of clock cycles per microsecond, updated by the clock change handler of the Delay driver.
+ */
+extern volatile uint32_t Delay_Cycles_Per_Us;
+
+/**
+ * @brief Enables the DWT cycle counter and reads the clock frequency.
+ *
+ * The cycle counter is not cleared, so the ISR_Profiler driver can use it at the same time.
+ *
+ * @param None
+ *
+ * @note Clock_Init48MHz must be called before this function.
+ *
+ * @return None
+ */
+void Delay_Init(void);
+
+/**
+ * @brief Waits for at least the specified number of clock cycles.
+ *
+ * The difference between CYCCNT and the start value is computed with unsigned subtraction,
+ * so the delay is correct when the counter rolls over (every 89 seconds at 48 MHz).
+ *
+ * @param cycles The number of clock cycles to wait.
+ *
+ * @return None
+ */
+static inline void Delay_Cycles(uint32_t cycles)
+{
+    uint32_t start = DWT->CYCCNT;
+
+    while ((DWT->CYCCNT - start) < cycles);
+}
+
+/**
+ * @brief Waits for at least the specified number of nanoseconds, rounded up to a whole clock cycle.
+ *
+ * @param ns The number of nanoseconds to wait, from 0 to DELAY_MAX_NS.
+ *
+ * @return None
+ */
+static inline void Delay_Ns(uint32_t ns)
+{
+    if (ns > DELAY_MAX_NS) ns = DELAY_MAX_NS;
+
+    Delay_Cycles(((ns * Delay_Cycles_Per_Us) + 999) / 1000);
+}
+
+/**
+ * @brief Waits for at least the specified number of microseconds.
+ *
+ * @param us The number of microseconds to wait. Up to 89 seconds at 48 MHz (2^32 cycles).
+ *
+ * @return None
+ */
+static inline void Delay_Us(uint32_t us)
+{
+    Delay_Cycles(us * Delay_Cycles_Per_Us);
+}
+
+/**
+ * @brief Waits for at least the specified number of milliseconds.
+ *
+ * @param ms The number of milliseconds to wait.
+ *
+ * @return None
+ */
+void Delay_Ms(uint32_t ms);
+
+/**
+ * @brief Registers a function that Delay_Wait_Us calls each time the CPU wakes up while waiting.
+ *
+ * For example, Event_Queue_Dispatch can be registered so that the bumper events are still handled during a long delay.
+ *
+ * @param handler The function to call, or 0 to only sleep.
+ *
+ * @note The handler must not call Delay_Wait_Us.
+ *
+ * @return None
+ */
+void Delay_Set_Yield_Handler(void (*handler)(void));
+
+/**
+ * @brief Waits for at least the specified number of microseconds, sleeping while more than one SysTick period is left.
+ *
+ * While the remaining time is longer than one SysTick period, the CPU sleeps until the next interrupt
+ * (at most one SysTick period) and then calls the yield handler, if one is registered.
+ * The rest of the delay is a busy-wait on the DWT cycle counter, so the deadline is met with the same accuracy
+ * as Delay_Us. Shorter delays are a busy-wait only.
+ *
+ * @param us The number of microseconds to wait.
+ *
+ * @note This function must only be called from the main loop (or from the Scheduler tasks) with interrupts enabled,
+ *       since the SysTick interrupt must be able to wake up the CPU. SysTick_Interrupt_Init and Time_Init must be called first.
+ *
+ * @note If an interrupt pushes work for the yield handler between the call of the handler and the sleep,
+ *       the work is done after the next wake-up (at most one SysTick period later).
+ *
+ * @return None
+ */
+void Delay_Wait_Us(uint64_t us);
+
+#endif /* DELAY_H_ */
@@ -19,6 +19,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include "msp.h"
+#include "IRQ_Priority.h"
 #include "file.h"
 
 /**
@@ -46,6 +47,65 @@
  */
 #define DEL  0x7F
 
+/**
+ * @brief Size of the transmit ring buffer used by the interrupt-driven TX modes (must be a power of two)
+ */
+#define EUSCI_A0_UART_TX_BUFFER_SIZE 256
+
+/**
+ * @brief Size of the receive ring buffer filled by EUSCIA0_IRQHandler (must be a power of two)
+ */
+#define EUSCI_A0_UART_RX_BUFFER_SIZE 64
+
+/**
+ * @brief Baud rate of EUSCI_A0. The divider is computed from the SMCLK frequency, and again after each clock profile switch.
+ */
+#define EUSCI_A0_UART_BAUD_RATE 115200
+
+/**
+ * @brief Priority level of the EUSCI_A0 interrupt (0 = highest, 7 = lowest), from the priority table of IRQ_Priority.h
+ */
+#define EUSCI_A0_UART_INT_PRIORITY IRQ_PRIORITY_UART
+
+/**
+ * @brief Transmit modes supported by the EUSCI_A0_UART driver.
+ *
+ *  - EUSCI_A0_UART_TX_MODE_POLLED:     Each character waits for TXIFG before it is written to TXBUF
+ *  - EUSCI_A0_UART_TX_MODE_RING_DROP:  Characters are queued in a ring buffer that is drained by EUSCIA0_IRQHandler.
+ *                                      Characters are dropped and counted when the ring buffer is full.
+ *  - EUSCI_A0_UART_TX_MODE_RING_BLOCK: Same as RING_DROP, but the caller waits for space when the ring buffer is full
+ */
+typedef enum
+{
+    EUSCI_A0_UART_TX_MODE_POLLED = 0,
+    EUSCI_A0_UART_TX_MODE_RING_DROP,
+    EUSCI_A0_UART_TX_MODE_RING_BLOCK
+} EUSCI_A0_UART_TX_Mode;
+
+/**
+ * @brief Transmit mode selected by EUSCI_A0_UART_Init_Printf
+ */
+#define EUSCI_A0_UART_TX_MODE_DEFAULT EUSCI_A0_UART_TX_MODE_RING_DROP
+
+/**
+ * @brief Number of buffers that can be queued by EUSCI_A0_UART_WriteAsync (one being sent, one being filled)
+ */
+#define EUSCI_A0_UART_DMA_QUEUE_SIZE 2
+
+/**
+ * @brief State of a line that is assembled by EUSCI_A0_UART_Line_Poll.
+ *
+ *  - buffer: Buffer that stores the line. It must hold at least (max + 1) characters.
+ *  - max:    Maximum number of characters in the line
+ *  - length: Number of characters received so far
+ */
+typedef struct
+{
+    char *buffer;
+    uint16_t max;
+    uint16_t length;
+} EUSCI_A0_UART_Line;
+
 /**
  * @brief Initializes the UART module EUSCI_A0 for communication.
  *
@@ -55,25 +115,158 @@
  * - Parity: Disabled
  * - Stop bits: 1
  * - Data bits: 8
- * - Baud rate: 115200
+ * - Baud rate: EUSCI_A0_UART_BAUD_RATE (115200)
  * - Mode: UART
  * - LSB first
  * - UART clock source: SMCLK
- * - Interrupts disabled
+ * - Receive interrupt enabled
+ *
+ * The EUSCI_A0 interrupt (IRQ 16) is enabled in the NVIC with priority EUSCI_A0_UART_INT_PRIORITY.
+ * The received characters are copied to a ring buffer of EUSCI_A0_UART_RX_BUFFER_SIZE bytes by EUSCIA0_IRQHandler.
+ * The transmit interrupt is only requested when an interrupt-driven TX mode queues a character.
  *
  * For more information regarding the registers used, refer to the eUSCI_A UART Registers section (24.4)
  * of the MSP432Pxx Microcontrollers Technical Reference Manual
  *
  * @note Pins P1.2 and P1.3 are used for UART communication via USB.
  *
+ * @note A clock change handler is registered, so the baud rate divider is recomputed when Clock_SetProfile changes SMCLK
+ *       (104 at 12 MHz, 26 at 3 MHz).
+ *
  * @return None
  */
 void EUSCI_A0_UART_Init();
 
+/**
+ * @brief The EUSCI_A0_UART_Set_TX_Mode function selects how characters are transmitted.
+ *
+ * In the ring buffer modes, EUSCI_A0_UART_OutChar (and therefore printf, EUSCI_A0_UART_Write,
+ * and the EUSCI_A0_UART_Out* functions) only copies the character into a ring buffer of EUSCI_A0_UART_TX_BUFFER_SIZE bytes
+ * and returns. The characters are sent by EUSCIA0_IRQHandler. Switching to EUSCI_A0_UART_TX_MODE_POLLED
+ * waits until the ring buffer is empty.
+ *
+ * @param mode The transmit mode to use.
+ *
+ * @note The ring buffer has a single producer. Characters must not be written from contexts that can preempt each other
+ *       (e.g. the main loop and an ISR at the same time) while a ring buffer mode is selected.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_Set_TX_Mode(EUSCI_A0_UART_TX_Mode mode);
+
+/**
+ * @brief The EUSCI_A0_UART_Get_TX_Mode function returns the current transmit mode.
+ *
+ * @param None
+ *
+ * @return The transmit mode selected by EUSCI_A0_UART_Set_TX_Mode.
+ */
+EUSCI_A0_UART_TX_Mode EUSCI_A0_UART_Get_TX_Mode();
+
+/**
+ * @brief The EUSCI_A0_UART_TX_Flush function waits until the transmit ring buffer is empty.
+ *
+ * The transfers queued by EUSCI_A0_UART_WriteAsync are completed first.
+ *
+ * @param None
+ *
+ * @note The DMA transfers are completed by DMA_INT1_IRQHandler and EUSCIA0_IRQHandler, so this function must not be called
+ *       from an interrupt handler of priority EUSCI_A0_UART_INT_PRIORITY or higher, or with the interrupts masked
+ *       (e.g. between Critical_Section_Enter and Critical_Section_Exit), while a transfer is queued. It would wait forever.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_TX_Flush();
+
+/**
+ * @brief The EUSCI_A0_UART_TX_Busy function returns 1 while characters are still being transmitted.
+ *
+ * This can be used to check that the SMCLK used by EUSCI_A0 can be stopped (e.g. before entering LPM3).
+ *
+ * @param None
+ *
+ * @return 1 if the ring buffer or the DMA queue is not empty or the EUSCI_A0 module is busy, otherwise 0.
+ */
+uint8_t EUSCI_A0_UART_TX_Busy();
+
+/**
+ * @brief The EUSCI_A0_UART_TX_Overflow_Count function returns the number of characters dropped in EUSCI_A0_UART_TX_MODE_RING_DROP.
+ *
+ * @param None
+ *
+ * @return The number of characters that were dropped because the transmit ring buffer was full.
+ */
+uint32_t EUSCI_A0_UART_TX_Overflow_Count();
+
+/**
+ * @brief Interrupt handler for the EUSCI_A0 module.
+ *
+ * This function is an interrupt service routine (ISR) for EUSCI_A0. When a character is received, it is copied to
+ * the receive ring buffer (or dropped and counted if the buffer is full). When the transmit interrupt is enabled,
+ * it moves one character from the transmit ring buffer to TXBUF each time TXIFG is set. When the ring buffer is empty,
+ * it starts the next transfer queued by EUSCI_A0_UART_WriteAsync (if any) and disables the transmit interrupt.
+ *
+ * @return None
+ */
+void EUSCIA0_IRQHandler(void);
+
+/**
+ * @brief The EUSCI_A0_UART_DMA_Init function sets up DMA channel 0 for EUSCI_A0_UART_WriteAsync.
+ *
+ * This function selects EUSCI_A0 TX as the trigger source of DMA channel 0 and enables the
+ * DMA_INT1 interrupt (IRQ 33) with the same priority as the EUSCI_A0 interrupt.
+ *
+ * @param None
+ *
+ * @note EUSCI_A0_UART_Init must be called before this function.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_DMA_Init();
+
+/**
+ * @brief The EUSCI_A0_UART_WriteAsync function sends a buffer using DMA without waiting for the transfer.
+ *
+ * The buffer is queued and sent by DMA channel 0, which generates a single interrupt when all bytes have been written to TXBUF.
+ * Then, the callback function is called from DMA_INT1_IRQHandler with the address of the buffer, which can be filled again.
+ * Up to EUSCI_A0_UART_DMA_QUEUE_SIZE buffers can be queued, so the application can fill one buffer while the other is being sent.
+ * Characters queued in the transmit ring buffer are sent before the next DMA transfer is started.
+ *
+ * Unlike EUSCI_A0_UART_Write, no carriage return is added before a newline character.
+ *
+ * @param buf      Pointer to the buffer containing the data to be transmitted. It must not be modified until the callback is called.
+ * @param count    Number of bytes to write (1 to 1024).
+ * @param callback Function called when the buffer has been sent (can be NULL).
+ *
+ * @note EUSCI_A0_UART_DMA_Init must be called before this function.
+ *
+ * @return 0 if the buffer was queued, otherwise -1 (count out of range or both buffers in use).
+ */
+int EUSCI_A0_UART_WriteAsync(const char *buf, unsigned count, void (*callback)(const char *buf));
+
+/**
+ * @brief The EUSCI_A0_UART_DMA_Pending function returns the number of buffers queued by EUSCI_A0_UART_WriteAsync that have not been sent yet.
+ *
+ * @param None
+ *
+ * @return The number of queued buffers (0 to EUSCI_A0_UART_DMA_QUEUE_SIZE).
+ */
+uint32_t EUSCI_A0_UART_DMA_Pending();
+
+/**
+ * @brief Interrupt handler for the DMA_INT1 interrupt.
+ *
+ * This function is called when DMA channel 0 has written the last byte of a buffer to TXBUF.
+ * It calls the callback function of the buffer and lets EUSCIA0_IRQHandler continue with the next transfer.
+ *
+ * @return None
+ */
+void DMA_INT1_IRQHandler(void);
+
 /**
  * @brief The EUSCI_A0_UART_InChar function reads a character from the UART receive buffer.
  *
- * This function waits until a character is available in the UART receive buffer (EUSCI_A0)
+ * This function waits until a character is available in the receive ring buffer
  * from the serial terminal input and returns the received character as a char type.
  *
  * @param None
@@ -82,14 +275,100 @@ void EUSCI_A0_UART_Init();
  */
 char EUSCI_A0_UART_InChar();
 
+/**
+ * @brief The EUSCI_A0_UART_RX_Read function reads a character from the receive ring buffer without waiting.
+ *
+ * @param character Pointer to the variable that stores the received character.
+ *
+ * @return 1 if a character was read, or 0 if the receive ring buffer is empty.
+ */
+uint8_t EUSCI_A0_UART_RX_Read(char *character);
+
+/**
+ * @brief The EUSCI_A0_UART_RX_Available function returns the number of characters in the receive ring buffer.
+ *
+ * @param None
+ *
+ * @return The number of characters that can be read without waiting.
+ */
+uint32_t EUSCI_A0_UART_RX_Available();
+
+/**
+ * @brief The EUSCI_A0_UART_RX_Overflow_Count function returns the number of received characters that were dropped.
+ *
+ * @param None
+ *
+ * @return The number of characters that were dropped because the receive ring buffer was full.
+ */
+uint32_t EUSCI_A0_UART_RX_Overflow_Count();
+
+/**
+ * @brief The EUSCI_A0_UART_Set_RX_Enable function enables or disables the receive interrupt.
+ *
+ * The receive interrupt is enabled by EUSCI_A0_UART_Init. While it is disabled, the received characters are not
+ * copied to the receive ring buffer, and Tickless_Idle can enter LPM3 (which stops the SMCLK used by the receiver).
+ *
+ * @param enable 1 to enable the receive interrupt, 0 to disable it.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_Set_RX_Enable(uint8_t enable);
+
+/**
+ * @brief The EUSCI_A0_UART_RX_Enabled function returns 1 if the receive interrupt is enabled.
+ *
+ * This can be used to check that the SMCLK used by EUSCI_A0 can be stopped (e.g. before entering LPM3).
+ *
+ * @param None
+ *
+ * @return 1 if characters can be received, otherwise 0.
+ */
+uint8_t EUSCI_A0_UART_RX_Enabled();
+
+/**
+ * @brief The EUSCI_A0_UART_Line_Init function prepares a line to be assembled by EUSCI_A0_UART_Line_Poll.
+ *
+ * @param line   Pointer to the state of the line.
+ * @param buffer Pointer to the buffer that stores the line. It must hold at least (max + 1) characters.
+ * @param max    Maximum number of characters in the line.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_Line_Init(EUSCI_A0_UART_Line *line, char *buffer, uint16_t max);
+
+/**
+ * @brief The EUSCI_A0_UART_Line_Poll function adds the received characters to a line without waiting.
+ *
+ * This function processes the characters in the receive ring buffer in the same way as EUSCI_A0_UART_InString:
+ * the characters are echoed, a backspace (BS or DEL) deletes the last character, and the characters are ignored
+ * when the line is full. Line feed characters are ignored. It returns as soon as the receive ring buffer is empty
+ * or a carriage return (CR) is received, so it can be called on each iteration of the main loop.
+ *
+ * @param line Pointer to the state of the line initialized by EUSCI_A0_UART_Line_Init.
+ *
+ * @note The receive ring buffer has a single consumer. EUSCI_A0_UART_Line_Poll, EUSCI_A0_UART_RX_Read, and EUSCI_A0_UART_InChar
+ *       must be called from the same context (e.g. the main loop).
+ *
+@return 1 if a complete line is in the buffer (null-terminated, without the CR), otherwise 0.
+ *         The next call starts a new line.
+ */
+uint8_t EUSCI_A0_UART_Line_Poll(EUSCI_A0_UART_Line *line);
+
 /**
  * @brief The EUSCI_A0_UART_OutChar function transmits a character via UART to the serial terminal.
  *
- * This function waits until the UART transmit buffer (EUSCI_A0) is ready to accept
+ * In EUSCI_A0_UART_TX_MODE_POLLED, this function waits until the UART transmit buffer (EUSCI_A0) is ready to accept
  * a new character and then writes the specified character in the transmit buffer to the serial terminal.
+ * In the ring buffer modes, the character is queued and sent by EUSCIA0_IRQHandler.
  *
  * @param letter The character to be transmitted to the serial terminal.
  *
+ * @note In EUSCI_A0_UART_TX_MODE_POLLED, and in EUSCI_A0_UART_TX_MODE_RING_BLOCK when the ring buffer is full,
+ *       the function waits for the transfers of EUSCI_A0_UART_WriteAsync, which are completed by DMA_INT1_IRQHandler
+ *       and EUSCIA0_IRQHandler. While a transfer is queued, it must not be called from an interrupt handler
+ *       of priority EUSCI_A0_UART_INT_PRIORITY or higher, or with the interrupts masked (e.g. between Critical_Section_Enter
+ *       and Critical_Section_Exit), since it would wait forever. EUSCI_A0_UART_TX_MODE_RING_DROP never waits.
+ *
  * @return None
  */
 void EUSCI_A0_UART_OutChar(char letter);
@@ -139,6 +418,7 @@ uint32_t EUSCI_A0_UART_InUDec();
  * @brief The EUSCI_A0_UART_OutUDec function transmits an unsigned decimal number via UART to the serial terminal.
  *
  * This function transmits the provided unsigned decimal number (n) via UART to the serial terminal.
+ * The number is converted with Format_UDec.
  *
  * @param n The unsigned decimal number to be transmitted to the serial terminal.
  *
@@ -150,7 +430,7 @@ void EUSCI_A0_UART_OutUDec(uint32_t n);
  * @brief The EUSCI_A0_UART_OutSDec function transmits a signed decimal number via UART to the serial terminal.
  *
  * This function transmits the provided signed decimal number (n) via UART to the serial terminal.
- * If the number is negative, a minus sign '-' is transmitted first.
+ * If the number is negative, a minus sign '-' is transmitted first. The number is converted with Format_SDec.
  *
  * @param n The signed decimal number to be transmitted to the serial terminal.
  *
@@ -163,6 +443,7 @@ void EUSCI_A0_UART_OutSDec(int32_t n);
  *
  * This function transmits the provided unsigned fixed-point number (n) via UART to the serial terminal.
  * The number is assumed to have one decimal place, and a period '.' is transmitted before the fractional part.
+ * The number is converted with Format_UFix.
  *
  * @param n The unsigned fixed-point number to be transmitted to the serial terminal.
  *
@@ -189,7 +470,7 @@ uint32_t UART0_InUHex();
  * @brief The EUSCI_A0_UART_OutUHex function transmits an unsigned hexadecimal number via UART to the serial terminal.
  *
  * This function transmits the provided unsigned hexadecimal number (number) via UART to the serial terminal.
- * The number is converted into a hexadecimal ASCII string and transmitted character by character.
+ * The number is converted into a hexadecimal ASCII string with Format_UHex and transmitted character by character.
  *
  * @param number The unsigned hexadecimal number to be transmitted to the serial terminal.
  *
@@ -197,6 +478,18 @@ uint32_t UART0_InUHex();
  */
 void EUSCI_A0_UART_OutUHex(uint32_t number);
 
+/**
+ * @brief The EUSCI_A0_UART_OutUHex_Width function transmits an unsigned hexadecimal number with a fixed number of digits.
+ *
+ * For example, a value of 0x2A with a width of 4 is transmitted as "002A".
+ *
+ * @param number The unsigned hexadecimal number to be transmitted to the serial terminal.
+ * @param width  The number of digits (1 to 8), or 0 to transmit only the significant digits.
+ *
+ * @return None
+ */
+void EUSCI_A0_UART_OutUHex_Width(uint32_t number, uint8_t width);
+
 /**
  * @brief The EUSCI_A0_UART_Open function initializes the UART communication.
  *
@@ -242,6 +535,10 @@ int EUSCI_A0_UART_Read(int dev_fd, char *buf, unsigned count);
  *
  * This function writes data from the provided buffer (buf) to the UART transmit buffer (EUSCI_A0) for transmission.
  * It transmits each character one by one and handles newline character ('\n') by sending a carriage return ('\r') first.
+ * The characters are passed to EUSCI_A0_UART_OutChar, so the current transmit mode applies.
+ *
+ * @note In EUSCI_A0_UART_TX_MODE_RING_DROP, count is returned even if some characters were dropped.
+ *       Use EUSCI_A0_UART_TX_Overflow_Count to check for dropped characters.
  *
  * @param dev_fd Device file descriptor.
  * @param buf Pointer to the buffer containing the data to be transmitted.
@@ -292,6 +589,7 @@ int EUSCI_A0_UART_Rename(const char *old_name, const char *new_name);
  *
  * This function initializes the UART module (EUSCI_A0) for communication and configures it for printf output.
  * It adds the UART device to the device list, sets stdout to use the UART output, and turns off buffering for stdout.
+ * Then, it selects EUSCI_A0_UART_TX_MODE_DEFAULT as the transmit mode.
  *
  * @param None
  *
@@ -0,0 +1,221 @@
+/**
+ * @file Event_Queue.h
+ * @brief Header file for the Event_Queue driver.
+ *
+ * This file contains the function definitions for the Event_Queue driver.
+ * Interrupt handlers push a small record for each event into a lock-free queue, and the
+ * main loop drains the queue and calls the handlers subscribed to the event source.
+ * This keeps the interrupt handlers short, independent of how much work the handlers do.
+ *
+ * Each source can have several subscribers, and each subscriber has a pin mask. A subscriber is only called
+ * for the events whose changed pins match its mask. Subscribers can be registered at run time with
+ * Event_Queue_Subscribe (up to EVENT_MAX_SUBSCRIBERS per source), or at compile time with a constant table
+ * stored in flash that is passed to Event_Queue_Register_Static_Table:
+ *
+ *      static const Event_Subscriber app_subscribers[] =
+ *      {
+ *          { EVENT_SOURCE_BUMPER_SENSORS, BUMPER_SENSORS_LEFT_PINS, &Left_Bumper_Handler },
+ *          { EVENT_SOURCE_PMOD_BTN, EVENT_ALL_PINS, &PMOD_BTN_LED_Handler }
+ *      };
+ *
+ *      Event_Queue_Register_Static_Table(app_subscribers, 2);
+ *
+ * The subscribers of the static table are called first, followed by the run-time subscribers in the order in which they were registered.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef EVENT_QUEUE_H_
+#define EVENT_QUEUE_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Number of events that can be held by the queue (must be a power of two)
+ */
+#define EVENT_QUEUE_SIZE 32
+
+/**
+ * @brief Maximum number of run-time subscribers per event source
+ */
+#define EVENT_MAX_SUBSCRIBERS 4
+
+/**
+ * @brief Pin mask that matches all pins
+ */
+#define EVENT_ALL_PINS 0xFF
+
+/**
+ * @brief Sources of the events pushed into the queue.
+ */
+typedef enum
+{
+    EVENT_SOURCE_BUMPER_SENSORS = 0,
+    EVENT_SOURCE_PMOD_BTN,
+    EVENT_NUM_SOURCES
+} Event_Source;
+
+/**
+ * @brief Record stored in the queue for each event.
+ *
+ *  - source:    The Event_Source that generated the event
+ *  - pins:      The port pins that generated the event (e.g. 0x04 for P4.2)
+ *  - levels:    The level of those pins after the edge (the IN register masked with 'pins')
+ *  - state:     The state of the input port when the event occurred
+ *  - timestamp: The SysTick tick count when the event occurred (see SysTick_Interrupt_Get_Ticks)
+ */
+typedef struct
+{
+    uint8_t source;
+    uint8_t pins;
+    uint8_t levels;
+    uint8_t state;
+    uint32_t timestamp;
+} Event;
+
+/**
+ * @brief Handler of an event. It receives the state stored with the event.
+ */
+typedef void (*Event_Handler)(uint8_t state);
+
+/**
+ * @brief Entry of a static subscriber table.
+ *
+ *  - source:   The event source
+ *  - pin_mask: The port pins of interest. The handler is called when (event pins & pin_mask) is not 0.
+ *  - handler:  The function that is called
+ */
+typedef struct
+{
+    Event_Source source;
+    uint8_t pin_mask;
+    Event_Handler handler;
+} Event_Subscriber;
+
+/**
+ * @brief Subscribes a handler to the events of a source at run time.
+ *
+ * The handler is called from Event_Queue_Dispatch (i.e. in the main loop), not in interrupt context.
+ *
+ * @param source   The event source.
+ * @param pin_mask The port pins of interest, or EVENT_ALL_PINS.
+ * @param handler  A pointer to the user-defined function.
+ *
+ * @return 0 if the handler was subscribed, or -1 if the handler is NULL or the source already has EVENT_MAX_SUBSCRIBERS subscribers.
+ */
+int8_t Event_Queue_Subscribe(Event_Source source, uint8_t pin_mask, Event_Handler handler);
+
+/**
+ * @brief Removes a handler that was subscribed with Event_Queue_Subscribe.
+ *
+ * @param source  The event source.
+ * @param handler A pointer to the user-defined function.
+ *
+ * @return None
+ */
+void Event_Queue_Unsubscribe(Event_Source source, Event_Handler handler);
+
+/**
+ * @brief Registers a constant table of subscribers.
+ *
+ * The table is not copied, so it should be declared as 'static const' to be stored in flash.
+ * Registering a table replaces the previous table.
+ *
+ * @param table Pointer to the table, or NULL to remove the previous table.
+ * @param count Number of entries in the table.
+ *
+ * @return None
+ */
+void Event_Queue_Register_Static_Table(const Event_Subscriber *table, uint8_t count);
+
+/**
+ * @brief Pushes an event into the queue.
+ *
+ * This function is intended to be called from interrupt handlers. It only stores the source, the pins,
+ * their levels, the state, and the current tick count, so it takes a few dozen cycles.
+ *
+ * @param source The event source.
+ * @param pins   The port pins that generated the event.
+ * @param levels The level of those pins after the edge.
+ * @param state  The state of the input port.
+ *
+ * @note The queue has a single producer. All interrupt handlers that push events must have the same
+ *       priority so that they cannot preempt each other.
+ *
+ * @return 1 if the event was queued, or 0 if the queue was full and the event was dropped.
+ */
+uint8_t Event_Queue_Push(Event_Source source, uint8_t pins, uint8_t levels, uint8_t state);
+
+/**
+ * @brief Removes the oldest event from the queue.
+ *
+ * @param event Pointer to the record where the event will be stored.
+ *
+ * @return 1 if an event was removed, or 0 if the queue was empty.
+ */
+uint8_t Event_Queue_Pop(Event *event);
+
+/**
+ * @brief Returns 1 if the queue is empty.
+ *
+ * @param None
+ *
+ * @return 1 if there are no queued events, otherwise 0.
+ */
+uint8_t Event_Queue_Is_Empty();
+
+/**
+ * @brief Removes all queued events and calls the subscribers whose pin mask matches each one.
+ *
+ * This function should be called from the main loop.
+ *
+ * @param None
+ *
+ * @return The number of events that were removed from the queue.
+ */
+uint32_t Event_Queue_Dispatch();
+
+/**
+ * @brief Returns the timestamp of the event that is being dispatched.
+ *
+ * This function can be called by a handler to find out when its event occurred.
+ *
+ * @param None
+ *
+ * @return The SysTick tick count stored with the event.
+ */
+uint32_t Event_Queue_Get_Timestamp();
+
+/**
+ * @brief Returns the pins of the event that is being dispatched.
+ *
+ * This function can be called by a handler to find out which pins generated its event.
+ *
+ * @param None
+ *
+ * @return The port pins stored with the event.
+ */
+uint8_t Event_Queue_Get_Pins();
+
+/**
+ * @brief Returns the levels of the pins of the event that is being dispatched.
+ *
+ * When the input driver reports both edges, this function can be used to tell a press from a release.
+ *
+ * @param None
+ *
+ * @return The level of the pins returned by Event_Queue_Get_Pins after the edge.
+ */
+uint8_t Event_Queue_Get_Levels();
+
+/**
+ * @brief Returns the number of events that were dropped because the queue was full.
+ *
+ * @param None
+ *
+ * @return The number of dropped events.
+ */
+uint32_t Event_Queue_Overflow_Count();
+
+#endif /* EVENT_QUEUE_H_ */
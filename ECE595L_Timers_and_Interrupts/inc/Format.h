@@ -0,0 +1,99 @@
+/**
+ * @file Format.h
+ * @brief Header file for the Format driver.
+ *
+ * This file contains the function definitions for the Format driver.
+ * It converts integers to text in a buffer provided by the caller, without printf, recursion, or heap memory.
+ * Decimal digits are computed with a multiplication by the reciprocal of 10 instead of a division.
+ *
+ * The FORMAT_* macros check at compile time that the destination is an array large enough for the result.
+ * For example:
+ *
+ *      char text[FORMAT_UDEC_SIZE];
+ *      FORMAT_UDEC(text, value);          // compiles
+ *
+ *      char small[4];
+ *      FORMAT_UDEC(small, value);         // compile error: array too small
+ *
+ * All functions write a null-terminated string and return its length (without the null character).
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef FORMAT_H_
+#define FORMAT_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Buffer sizes (including the null character) required by each conversion.
+ */
+#define FORMAT_UDEC_SIZE    11      // "4294967295"
+#define FORMAT_SDEC_SIZE    12      // "-2147483648"
+#define FORMAT_UHEX_SIZE    9       // "FFFFFFFF"
+#define FORMAT_UFIX_SIZE    12      // "429496729.5" or "4.294967295"
+
+/**
+ * @brief Compile-time check used by the FORMAT_* macros.
+ *
+ * The expression is an error (array with a negative size) when 'buffer' is smaller than 'size' bytes.
+ * A pointer is also rejected for conversions that need more than 4 or 8 bytes, since sizeof(buffer) is then the size of the pointer.
+ */
+#define FORMAT_CHECK_SIZE(buffer, size) ((void)sizeof(char[(sizeof(buffer) >= (size)) ? 1 : -1]))
+
+#define FORMAT_UDEC(buffer, n)              (FORMAT_CHECK_SIZE(buffer, FORMAT_UDEC_SIZE), Format_UDec((buffer), (n)))
+#define FORMAT_SDEC(buffer, n)              (FORMAT_CHECK_SIZE(buffer, FORMAT_SDEC_SIZE), Format_SDec((buffer), (n)))
+#define FORMAT_UHEX(buffer, n)              (FORMAT_CHECK_SIZE(buffer, FORMAT_UHEX_SIZE), Format_UHex((buffer), (n), 0))
+#define FORMAT_UHEX8(buffer, n)             (FORMAT_CHECK_SIZE(buffer, 3), Format_UHex((buffer), (n), 2))
+#define FORMAT_UHEX16(buffer, n)            (FORMAT_CHECK_SIZE(buffer, 5), Format_UHex((buffer), (n), 4))
+#define FORMAT_UHEX32(buffer, n)            (FORMAT_CHECK_SIZE(buffer, 9), Format_UHex((buffer), (n), 8))
+#define FORMAT_UFIX(buffer, n, decimals)    (FORMAT_CHECK_SIZE(buffer, FORMAT_UFIX_SIZE), Format_UFix((buffer), (n), (decimals)))
+
+/**
+ * @brief Converts an unsigned number to decimal text.
+ *
+ * @param buffer Pointer to the buffer. It must hold at least FORMAT_UDEC_SIZE characters.
+ * @param n      The number to convert.
+ *
+ * @return The number of characters written (1 to 10).
+ */
+uint8_t Format_UDec(char *buffer, uint32_t n);
+
+/**
+ * @brief Converts a signed number to decimal text. A minus sign '-' is written first if the number is negative.
+ *
+ * @param buffer Pointer to the buffer. It must hold at least FORMAT_SDEC_SIZE characters.
+ * @param n      The number to convert.
+ *
+ * @return The number of characters written (1 to 11).
+ */
+uint8_t Format_SDec(char *buffer, int32_t n);
+
+/**
+ * @brief Converts an unsigned number to hexadecimal text (uppercase, without the "0x" prefix).
+ *
+ * @param buffer Pointer to the buffer. It must hold at least (width + 1) characters, or FORMAT_UHEX_SIZE when width is 0.
+ * @param n      The number to convert.
+ * @param width  The number of digits (1 to 8). Leading zeros are added, and the upper digits are dropped if the number is larger.
+ *               A width of 0 writes only the significant digits.
+ *
+ * @return The number of characters written.
+ */
+uint8_t Format_UHex(char *buffer, uint32_t n, uint8_t width);
+
+/**
+ * @brief Converts an unsigned fixed-point number to decimal text.
+ *
+ * The number is the value multiplied by 10^decimals. For example, n = 1234 with decimals = 2 is written as "12.34",
+ * and n = 5 with decimals = 1 is written as "0.5".
+ *
+ * @param buffer   Pointer to the buffer. It must hold at least FORMAT_UFIX_SIZE characters.
+ * @param n        The fixed-point number to convert.
+ * @param decimals The number of decimal places (0 to 9). A value of 0 writes an integer without a period.
+ *
+ * @return The number of characters written.
+ */
+uint8_t Format_UFix(char *buffer, uint32_t n, uint8_t decimals);
+
+#endif /* FORMAT_H_ */
@@ -49,6 +49,51 @@ extern const uint8_t PMOD_8LD_ALL_ON;
 extern const uint8_t PMOD_8LD_0_3_ON;
 extern const uint8_t PMOD_8LD_4_7_ON;
 
+// Start of the peripheral region and of its bit-band alias region (section 2.2.6 of the MSP432P4xx Technical Reference Manual)
+#define GPIO_PERIPH_BASE            0x40000000
+#define GPIO_BITBAND_PERI_BASE      0x42000000
+
+/**
+ * @brief Bit-band alias of one bit of a peripheral register.
+ *
+ * Each bit of the peripheral region has an alias in the bit-band region. A write to the alias changes only that bit
+ * in a single bus transaction, which cannot be interrupted. Unlike a read-modify-write such as P8->OUT ^= 0x80,
+ * it does not undo a change of another bit of the register that an interrupt handler made in the meantime,
+ * so no critical section is needed. A read of the alias returns the bit (0 or 1).
+ *
+ * @param reg A peripheral register (e.g. P8->OUT).
+ * @param bit The bit number (0 to 7).
+ */
+#define GPIO_BITBAND(reg, bit)      (*((volatile uint8_t *)(GPIO_BITBAND_PERI_BASE + ((((uint32_t)&(reg)) - GPIO_PERIPH_BASE) * 32) + ((bit) * 4))))
+
+/**
+ * @brief Atomic operations on one pin of a port (e.g. GPIO_Pin_Toggle(P8, 7) for P8.7).
+ *
+ * GPIO_Pin_Set, GPIO_Pin_Clear, and GPIO_Pin_Write are single writes to the bit-band alias of the OUT register.
+ * GPIO_Pin_Toggle reads and writes the alias of one bit, so it never changes the other pins of the port. It is only
+ * unsafe if another context changes the same pin between the read and the write.
+ * The port and the pin should be constants, so the compiler computes the alias address.
+ */
+#if defined(HOST_BUILD)
+
+// Host simulation build (see host/Host_Sim.h): the registers are not in the peripheral region, so there is no bit-band alias
+// The simulator does not run interrupt handlers in the middle of a read-modify-write, so these are still atomic
+#define GPIO_Pin_Set(port, pin)             ((port)->OUT |= (uint8_t)(1 << (pin)))
+#define GPIO_Pin_Clear(port, pin)           ((port)->OUT &= (uint8_t)~(1 << (pin)))
+#define GPIO_Pin_Write(port, pin, value)    ((port)->OUT = (uint8_t)(((port)->OUT & ~(1 << (pin))) | (((value) != 0) << (pin))))
+#define GPIO_Pin_Toggle(port, pin)          ((port)->OUT ^= (uint8_t)(1 << (pin)))
+#define GPIO_Pin_Read(port, pin)            (((port)->IN >> (pin)) & 1)
+
+#else
+
+#define GPIO_Pin_Set(port, pin)             (GPIO_BITBAND((port)->OUT, pin) = 1)
+#define GPIO_Pin_Clear(port, pin)           (GPIO_BITBAND((port)->OUT, pin) = 0)
+#define GPIO_Pin_Write(port, pin, value)    (GPIO_BITBAND((port)->OUT, pin) = ((value) != 0))
+#define GPIO_Pin_Toggle(port, pin)          (GPIO_BITBAND((port)->OUT, pin) ^= 1)
+#define GPIO_Pin_Read(port, pin)            (GPIO_BITBAND((port)->IN, pin))
+
+#endif
+
 /**
  * @brief The LED1_Init function initializes the built-in red LED (P1.0).
  *
@@ -65,10 +110,8 @@ void LED1_Init();
  * @brief The LED1_Output function sets the output of the built-in red LED and returns the status.
  *
  * This function sets the output of the built-in red LED based on the value of the input, led_value.
- * A bitwise AND operation (& 0xFE) is performed to mask the first bit (LSB) of the output register
- * to preserve the state of other pins connected to Port 1 while keeping the LED pin unaffected.
- * Then, a bitwise OR operation is performed with led_value to set the LED pin to the desired state
- * specified by led_value.
+ * The pin is written through its bit-band alias (GPIO_Pin_Write), so the state of the other pins connected to Port 1
+ * is preserved even if an interrupt handler changes them at the same time.
  *
  * @param led_value An 8-bit unsigned integer that determines the output of the built-in red LED. To turn off
  *                  the LED, set led_value to 0. Otherwise, setting led_value to 1 turns on the LED.
@@ -98,10 +141,8 @@ void LED2_Init();
  * @brief The LED2_Output function sets the output of the RGB LED and returns the status.
  *
  * This function sets the output of the RGB LED based on the value of the input, led_value.
- * A bitwise AND operation (& 0xF8) is performed to mask the lower three bits of the output register
- * to preserve the state of other pins connected to Port 2 while keeping the RGB LED pin unaffected.
- * Then, a bitwise OR operation is performed with led_value to set the RGB LED pin to the desired state
- * specified by led_value.
+ * Each of the three pins is written through its bit-band alias (GPIO_Pin_Write), so the state of the other pins
+ * connected to Port 2 is preserved even if an interrupt handler changes them at the same time.
  *
  * @param led_value An 8-bit unsigned integer that determines the output of the RGB LED. To turn off
  *                  the RGB LED, set led_value to 0. The following values determine the color of the RGB LED:
@@ -129,6 +170,7 @@ uint8_t LED2_Output(uint8_t led_value);
  * The 'led_value' parameter is an 8-bit unsigned integer, where each bit corresponds to an LED connected to P2.
  * When a bit is set to 1 in 'led_value', the corresponding LED will toggle its state (from OFF to ON or vice versa).
  * When a bit is set to 0, the corresponding LED state remains unchanged.
+ * Each LED is toggled through its bit-band alias (GPIO_Pin_Toggle), so the other pins of Port 2 are not affected.
  *
  * @param led_value An 8-bit unsigned integer that determines the output of the RGB LED.
  *
@@ -198,6 +240,7 @@ void PMOD_8LD_Init();
  *
  * This function sets the output value of the PMOD 8LD module by writing the provided led_value to the
  * corresponding output pins. It then reads back the actual value written to the PMOD 8LD module and returns it.
+ * All eight pins of P9 are used by the module, so the value is written with a single store, which is already atomic.
  *
  * @param led_value An 8-bit unsigned integer representing the desired output value for the PMOD 8LD module.
  *
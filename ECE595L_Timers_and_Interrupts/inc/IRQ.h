@@ -0,0 +1,132 @@
+/**
+ * @file IRQ.h
+ * @brief Header file for the IRQ driver.
+ *
+ * This file contains the function definitions for the IRQ driver.
+ * It can copy the interrupt vector table of startup_msp432p401r_ccs.c (in flash) to SRAM and point SCB->VTOR at the copy,
+ * so that interrupt handlers can be installed in their vector at runtime with IRQ_Register.
+ *
+ * By default, each driver defines the handler that is linked in the vector table (e.g. T32_INT1_IRQHandler),
+ * which clears the interrupt flag and calls the task of the application through a function pointer.
+ * A handler registered with IRQ_Register is called directly by the NVIC, without this extra call, which is useful
+ * for the interrupts with the highest rate (e.g. the encoders or a fast timer). A registered handler must clear
+ * the interrupt flag of its peripheral itself. For example, with TIMER32_1 configured by Timer32_Interrupt_Init:
+ *
+ *      void Encoder_Timer_Handler(void)
+ *      {
+ *          TIMER32_1->INTCLR = 0;      // Acknowledge the interrupt
+ *          ...
+ *      }
+ *
+ *      IRQ_Register(T32_INT1_IRQn, &Encoder_Timer_Handler, 1);
+ *
+ * A handler can also be replaced while the interrupt is enabled (e.g. to swap a driver at runtime),
+ * since the vector is a single 32-bit word. The interrupt that is running when its vector is replaced
+ * finishes with the previous handler.
+ *
+ * The RAM vector table is placed in the .vtable section (0x20000000 in msp432p401r.cmd), and it is only used
+ * after the first call of IRQ_Init or IRQ_Register. Until then, the vectors of the flash table are used.
+ *
+ * For more information regarding the vector table, refer to the Vector Table section (2.4.2)
+ * of the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef IRQ_H_
+#define IRQ_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "IRQ_Priority.h"
+
+/**
+ * @brief Number of device interrupts in the vector table (PSS_IRQn = 0 to PORT6_IRQn = 40)
+ */
+#define IRQ_NUM_INTERRUPTS 41
+
+/**
+ * @brief Number of entries of the vector table: the initial stack pointer, the 15 system exceptions, and the device interrupts
+ */
+#define IRQ_NUM_VECTORS (16 + IRQ_NUM_INTERRUPTS)
+
+/**
+ * @brief Alignment of the RAM vector table in bytes. VTOR requires a power of two that is larger than the table
+ *        (64 interrupts are implemented, so 80 entries of 4 bytes).
+ */
+#define IRQ_VECTOR_TABLE_ALIGNMENT 512
+
+/**
+ * @brief Interrupt handler installed in the vector table.
+ */
+typedef void (*IRQ_Handler)(void);
+
+/**
+ * @brief Copies the vector table from flash to SRAM and sets SCB->VTOR to the copy.
+ *
+ * Only the first call has an effect. This function is called by IRQ_Register.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void IRQ_Init(void);
+
+/**
+ * @brief Sets the priority grouping of SCB->AIRCR to IRQ_PRIORITY_GROUPING (see IRQ_Priority.h).
+ *
+ * This function is called by IRQ_Set_Priority, so the grouping is set before the first priority is used.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void IRQ_Priority_Init(void);
+
+/**
+ * @brief Sets the priority of an interrupt or a system exception.
+ *
+ * The drivers pass their entry of the priority table (e.g. IRQ_PRIORITY_BUMPER_SENSORS) instead of writing NVIC->IP or SCB->SHP.
+ * The priority grouping is set by the first call.
+ *
+ * @param irqn     The interrupt number (e.g. PORT4_IRQn or SysTick_IRQn), from MemoryManagement_IRQn to PORT6_IRQn.
+ * @param priority The priority level of the interrupt. Valid values range from 0 (highest priority) to 7 (lowest priority).
+ *
+ * @return 0 on success, or -1 if the interrupt number or the priority is invalid.
+ */
+int8_t IRQ_Set_Priority(IRQn_Type irqn, uint8_t priority);
+
+/**
+ * @brief Installs a handler in the vector of an interrupt, sets its priority, and enables it.
+ *
+ * The RAM vector table is initialized by the first call, and the priority is set with IRQ_Set_Priority.
+ * A system exception (e.g. SysTick_IRQn or PendSV_IRQn) is not enabled here (e.g. SysTick is enabled by SysTick->CTRL).
+ *
+ * @param irqn     The interrupt number (e.g. T32_INT1_IRQn or PORT4_IRQn), from MemoryManagement_IRQn to PORT6_IRQn.
+ * @param handler  The function called by the NVIC on each interrupt. It cannot be 0.
+ * @param priority The priority level of the interrupt. Valid values range from 0 (highest priority) to 7 (lowest priority).
+ *
+ * @return 0 on success, or -1 if the interrupt number, the handler, or the priority is invalid.
+ */
+int8_t IRQ_Register(IRQn_Type irqn, IRQ_Handler handler, uint8_t priority);
+
+/**
+ * @brief Disables an interrupt and restores the handler of the flash vector table.
+ *
+ * @param irqn The interrupt number that was passed to IRQ_Register.
+ *
+ * @return 0 on success, or -1 if the interrupt number is invalid.
+ */
+int8_t IRQ_Unregister(IRQn_Type irqn);
+
+/**
+ * @brief Returns the handler that is called for an interrupt, from the RAM vector table if it is used, or from the flash table.
+ *
+ * @param irqn The interrupt number.
+ *
+ * @return The handler, or 0 if the interrupt number is invalid.
+ */
+IRQ_Handler IRQ_Get_Handler(IRQn_Type irqn);
+
+#endif /* IRQ_H_ */
@@ -0,0 +1,95 @@
+/**
+ * @file IRQ_Priority.h
+ * @brief Priority tiers and priority table of the interrupts used by the drivers.
+ *
+ * The MSP432P401R NVIC implements 3 priority bits (priority values 0 to 7). With IRQ_PRIORITY_GROUPING,
+ * the upper 2 bits are the group priority (preemption) and the lowest bit is the sub-priority:
+ *  - An interrupt can only preempt a handler of a lower tier (a greater group priority value).
+ *  - Two interrupts of the same tier never preempt each other. When both are pending, the one with the lower
+ *    sub-priority value is taken first, then the one with the lower interrupt number.
+ *
+ * Tiers, from the highest to the lowest priority:
+ *  - IRQ_PRIORITY_TIER_TIMING_CRITICAL: timekeeping (SysTick). It preempts every other handler,
+ *    so the jitter of the tick is bounded by the longest critical section that masks it.
+ *  - IRQ_PRIORITY_TIER_CONTROL: periodic tasks of Timer32_Interrupt and Timer_A_Interrupt (e.g. motor control).
+ *  - IRQ_PRIORITY_TIER_IO: inputs from the user and the environment (Bumper Sensors, PMOD BTN, and their debounce timer).
+ *  - IRQ_PRIORITY_TIER_LOGGING: UART output and the wake-up timer of Tickless_Idle.
+ *
+ * Each driver sets the priority of its interrupts with IRQ_Set_Priority and its entry of the table below,
+ * so the preemption order of the whole system is changed here only.
+ *
+ * For more information regarding the priority grouping, refer to the Application Interrupt and Reset Control Register (AIRCR)
+ * in the NVIC section (2.4.3) of the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef IRQ_PRIORITY_H_
+#define IRQ_PRIORITY_H_
+
+/**
+ * @brief Number of priority bits implemented by the NVIC.
+ */
+#define IRQ_PRIORITY_BITS 3
+
+/**
+ * @brief Number of sub-priority bits of a priority value.
+ */
+#define IRQ_PRIORITY_SUB_BITS 1
+
+/**
+ * @brief Value of the PRIGROUP field of SCB->AIRCR for IRQ_PRIORITY_SUB_BITS.
+ *
+ * The 8-bit priority fields are split at bit PRIGROUP: bits 7 to (PRIGROUP + 1) are the group priority,
+ * and the implemented bits 5 to 0 below are the sub-priority. PRIGROUP = 5 gives bits 7-6 for the group and bit 5 for the sub-priority.
+ */
+#define IRQ_PRIORITY_GROUPING (7 - IRQ_PRIORITY_BITS + IRQ_PRIORITY_SUB_BITS)
+
+/**
+ * @brief Priority tiers (group priorities), from the highest to the lowest priority.
+ *        They are macros rather than an enumeration so that the table can be checked by the preprocessor.
+ */
+#define IRQ_PRIORITY_TIER_TIMING_CRITICAL   0
+#define IRQ_PRIORITY_TIER_CONTROL           1
+#define IRQ_PRIORITY_TIER_IO                2
+#define IRQ_PRIORITY_TIER_LOGGING           3
+
+/**
+ * @brief Priority value (0 to 7) of a tier and a sub-priority within the tier (0 or 1).
+ */
+#define IRQ_PRIORITY(tier, sub_priority) (((tier) << IRQ_PRIORITY_SUB_BITS) | (sub_priority))
+
+/**
+ * @brief Tier of a priority value.
+ */
+#define IRQ_PRIORITY_TIER_OF(priority) ((priority) >> IRQ_PRIORITY_SUB_BITS)
+
+// Priority table
+// Interrupt                            Tier                                    Sub-priority
+#define IRQ_PRIORITY_SYSTICK            IRQ_PRIORITY(IRQ_PRIORITY_TIER_TIMING_CRITICAL,   0)
+#define IRQ_PRIORITY_TIMER_TASK         IRQ_PRIORITY(IRQ_PRIORITY_TIER_CONTROL,           0)
+#define IRQ_PRIORITY_BUMPER_SENSORS     IRQ_PRIORITY(IRQ_PRIORITY_TIER_IO,                0)
+#define IRQ_PRIORITY_PMOD_BTN           IRQ_PRIORITY(IRQ_PRIORITY_TIER_IO,                0)
+#define IRQ_PRIORITY_DEBOUNCE           IRQ_PRIORITY(IRQ_PRIORITY_TIER_IO,                0)
+#define IRQ_PRIORITY_UART               IRQ_PRIORITY(IRQ_PRIORITY_TIER_LOGGING,           0)
+#define IRQ_PRIORITY_UART_DMA           IRQ_PRIORITY(IRQ_PRIORITY_TIER_LOGGING,           0)
+#define IRQ_PRIORITY_TICKLESS_WAKE      IRQ_PRIORITY(IRQ_PRIORITY_TIER_LOGGING,           1)
+
+// The debounce timer and the port handlers modify the IE registers of P4 and P6, so they must not preempt each other
+#if (IRQ_PRIORITY_TIER_OF(IRQ_PRIORITY_DEBOUNCE) != IRQ_PRIORITY_TIER_OF(IRQ_PRIORITY_BUMPER_SENSORS)) || \
+    (IRQ_PRIORITY_TIER_OF(IRQ_PRIORITY_DEBOUNCE) != IRQ_PRIORITY_TIER_OF(IRQ_PRIORITY_PMOD_BTN))
+#error "IRQ_PRIORITY_DEBOUNCE must be in the same tier as IRQ_PRIORITY_BUMPER_SENSORS and IRQ_PRIORITY_PMOD_BTN"
+#endif
+
+// EUSCIA0_IRQHandler and the DMA completion handler share the transmit state, so they must not preempt each other
+#if IRQ_PRIORITY_TIER_OF(IRQ_PRIORITY_UART) != IRQ_PRIORITY_TIER_OF(IRQ_PRIORITY_UART_DMA)
+#error "IRQ_PRIORITY_UART and IRQ_PRIORITY_UART_DMA must be in the same tier"
+#endif
+
+// The UART buffers are protected with BASEPRI, which cannot mask priority 0
+#if IRQ_PRIORITY_UART == 0
+#error "IRQ_PRIORITY_UART must be greater than 0"
+#endif
+
+#endif /* IRQ_PRIORITY_H_ */
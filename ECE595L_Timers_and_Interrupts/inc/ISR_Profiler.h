@@ -0,0 +1,175 @@
+/**
+ * @file ISR_Profiler.h
+ * @brief Header file for the ISR_Profiler driver.
+ *
+ * This file contains the function definitions for the ISR_Profiler driver.
+ * It uses the DWT cycle counter (CYCCNT) of the Cortex-M4 to measure the execution time of interrupt handlers.
+ * For each instrumented interrupt, it records the number of calls, the minimum, maximum, and mean number of cycles,
+ * and a histogram of the execution time. When the time between the hardware request and the entry of the handler
+ * can be measured (SysTick), the entry latency is recorded as well. For the other interrupts, the time of the request
+ * can be marked with ISR_Profiler_Mark_Request just before the request is generated (e.g. a GPIO loopback).
+ *
+ * The instrumentation is only compiled when ISR_PROFILER_ENABLE is defined as 1 (e.g. with --define=ISR_PROFILER_ENABLE=1).
+ * Otherwise, the ISR_PROFILER_ENTER and ISR_PROFILER_EXIT macros are empty and the driver adds no code to the handlers.
+ *
+ * @note The execution time of a handler includes the time spent in handlers with a higher priority that preempt it.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef ISR_PROFILER_H_
+#define ISR_PROFILER_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+#ifndef ISR_PROFILER_ENABLE
+#define ISR_PROFILER_ENABLE 0
+#endif
+
+/**
+ * @brief Number of bins of the execution time histogram
+ *
+ * Bin 0 counts handlers that took fewer than 32 cycles, and each following bin doubles the upper bound
+ * (64, 128, ...). The last bin counts everything above 2^(ISR_PROFILER_HISTOGRAM_BINS + 3) cycles.
+ */
+#define ISR_PROFILER_HISTOGRAM_BINS 12
+
+/**
+ * @brief Value used when the entry latency of an interrupt cannot be measured
+ */
+#define ISR_PROFILER_LATENCY_UNKNOWN 0xFFFFFFFF
+
+/**
+ * @brief Interrupts that can be instrumented.
+ */
+typedef enum
+{
+    ISR_PROFILER_SYSTICK = 0,
+    ISR_PROFILER_PORT4,
+    ISR_PROFILER_PORT6,
+    ISR_PROFILER_EUSCIA0,
+    ISR_PROFILER_NUM_IRQS
+} ISR_Profiler_IRQ;
+
+/**
+ * @brief Statistics recorded for each interrupt.
+ */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+    uint32_t latency_count;
+    uint32_t min_latency;
+    uint32_t max_latency;
+    uint64_t total_latency;
+    uint32_t histogram[ISR_PROFILER_HISTOGRAM_BINS];
+} ISR_Profiler_Stats;
+
+#if ISR_PROFILER_ENABLE
+
+/**
+ * @brief Place at the start of an interrupt handler. The latency is not measured.
+ */
+#define ISR_PROFILER_ENTER() \
+    uint32_t isr_profiler_entry = DWT->CYCCNT; \
+    uint32_t isr_profiler_latency = ISR_PROFILER_LATENCY_UNKNOWN
+
+/**
+ * @brief Place at the start of SysTick_Handler. The latency is the number of cycles since SysTick was reloaded.
+ *
+ * @note The latency is not correct for the first tick after a tickless sleep, since LOAD holds the normal reload value.
+ */
+#define ISR_PROFILER_ENTER_SYSTICK() \
+    uint32_t isr_profiler_entry = DWT->CYCCNT; \
+    uint32_t isr_profiler_latency = SysTick->LOAD - SysTick->VAL
+
+/**
+ * @brief Place at the end of an interrupt handler (before each return).
+ */
+#define ISR_PROFILER_EXIT(irq) \
+    ISR_Profiler_Record((irq), isr_profiler_entry, isr_profiler_latency)
+
+#else
+
+#define ISR_PROFILER_ENTER()
+#define ISR_PROFILER_ENTER_SYSTICK()
+#define ISR_PROFILER_EXIT(irq)
+
+#endif
+
+/**
+ * @brief Enables the DWT cycle counter and clears the statistics.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void ISR_Profiler_Init();
+
+/**
+ * @brief Adds one measurement to the statistics of an interrupt.
+ *
+ * This function is called by ISR_PROFILER_EXIT.
+ *
+ * @param irq          The instrumented interrupt.
+ * @param entry_cycles The value of CYCCNT at the start of the handler.
+ * @param latency      The entry latency in cycles, or ISR_PROFILER_LATENCY_UNKNOWN.
+ *
+ * @return None
+ */
+void ISR_Profiler_Record(ISR_Profiler_IRQ irq, uint32_t entry_cycles, uint32_t latency);
+
+/**
+ * @brief Marks the time of the next request of an interrupt, so that its entry latency is recorded.
+ *
+ * The next call of ISR_Profiler_Record for this interrupt uses the number of cycles between this call and the entry
+ * of the handler as the latency, if the handler does not measure it itself. For example, an output pin that is wired
+ * to P4.0 can be toggled right after this call to measure the latency of PORT4_IRQHandler.
+ *
+ * @param irq The instrumented interrupt.
+ *
+ * @note The latency includes the code that generates the request after this call (a few cycles for a GPIO write).
+ *
+ * @return None
+ */
+void ISR_Profiler_Mark_Request(ISR_Profiler_IRQ irq);
+
+/**
+ * @brief Copies the statistics of an interrupt.
+ *
+ * The copy is made with interrupts disabled, so it is consistent.
+ *
+ * @param irq   The instrumented interrupt.
+ * @param stats Pointer to the structure where the statistics will be stored.
+ *
+ * @return None
+ */
+void ISR_Profiler_Get_Stats(ISR_Profiler_IRQ irq, ISR_Profiler_Stats *stats);
+
+/**
+ * @brief Clears the statistics of all interrupts.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void ISR_Profiler_Reset();
+
+/**
+ * @brief Prints the statistics of all interrupts via UART (printf).
+ *
+ * Each interrupt is printed on one line with the following format:
+ * "ISR <name> count=<n> min=<cycles> max=<cycles> mean=<cycles> lat_min=<cycles> lat_max=<cycles> lat_mean=<cycles> hist=<bin0>,<bin1>,..."
+ * The latency fields are printed as "-" when the latency cannot be measured.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void ISR_Profiler_Print();
+
+#endif /* ISR_PROFILER_H_ */
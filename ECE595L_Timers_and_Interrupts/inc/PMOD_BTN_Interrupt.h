@@ -27,35 +27,39 @@
 
 #include <stdint.h>
 #include "msp.h"
+#include "../inc/Event_Queue.h"
+#include "../inc/ISR_Profiler.h"
+#include "../inc/Debounce.h"
 
 /**
- * @brief User-defined task function for handling PMOD BTN interrupt events.
- *
- * This is a user-defined function that can be assigned to the PMOD_BTN_Task pointer during initialization.
- * When a rising edge event is detected on any of the PMOD BTN pins (P6.0, P6.1, P6.2, and P6.3),
- * this function will be called, and the pmod_btn_state parameter will indicate which specific bumper switch triggered the interrupt.
- *
- * @param bumper_sensor An 8-bit unsigned integer representing the Bump Sensor that triggered the interrupt.
- *                   The bit positions correspond to the following sensors:
- *                   - Bit 0: P6.0 (PMOD BTN0)
- *                   - Bit 1: P6.1 (PMOD BTN1)
- *                   - Bit 2: P6.2 (PMOD BTN2)
- *                   - Bit 3: P6.3 (PMOD BTN3)
- *
- * @return None
+ * @brief Default debounce window of each push button in ms.
  */
-void (*PMOD_BTN_Task)(uint8_t pmod_btn_state);
+#define PMOD_BTN_DEBOUNCE_MS 20
 
 /**
  * @brief Initialize the PMOD BTN module and set up interrupt handling.
  *
  * This function initializes the PMOD BTN module and sets up the necessary configurations for interrupt handling.
- * The specified task function will be called when a rising edge event is detected on any of the following pins
- * used by the PMOD BTN module.
+ * When a rising edge event is detected on any of the pins used by the PMOD BTN module, PORT6_IRQHandler pushes
+ * an EVENT_SOURCE_PMOD_BTN event into the Event_Queue for each push button whose interrupt flag is set.
+ * The event holds the pin of the push button and its new level. The specified task function is subscribed to
+ * the events of all push buttons, so it is called from Event_Queue_Dispatch in the main loop instead of in interrupt context.
  *
- * The specified task function should take a single uint8_t parameter.
+ * Each push button is debounced separately by the Debounce driver with a window of Config_Values.pmod_btn_debounce_ms
+ * (PMOD_BTN_DEBOUNCE_MS unless it was changed with the Config driver).
+ * The window of a push button can be changed with Debounce_Set_Window(DEBOUNCE_PORT_P6, pin, window_ms).
  *
- * @param task A pointer to the user-defined function that will be called on a rising edge event.
+ * The specified task function should take a single uint8_t parameter, which holds the state of the push buttons
+ * when the interrupt occurred (in the format of PMOD_BTN_Read):
+ *      - Bit 0: P6.0 (PMOD BTN0)
+ *      - Bit 1: P6.1 (PMOD BTN1)
+ *      - Bit 2: P6.2 (PMOD BTN2)
+ *      - Bit 3: P6.3 (PMOD BTN3)
+ *
+ * Additional handlers can be subscribed to specific push buttons with Event_Queue_Subscribe,
+ * using the same bit positions as the pin mask.
+ *
+ * @param task A pointer to the user-defined function that will be called for each rising edge event, or NULL.
  *
  * @return None
  */
@@ -75,4 +79,16 @@ void PMOD_BTN_Interrupt_Init(void(*task)(uint8_t));
  */
 uint8_t PMOD_BTN_Read(void);
 
+/**
+ * @brief Selects whether the push buttons generate events for both the press and the release.
+ *
+ * When enabled, the edge select (IES) of each push button is toggled after each edge, so a release generates an event
+ * with a level of 0 (see Event_Queue_Get_Levels). When disabled, only the rising edge (press) generates an event.
+ *
+ * @param enable 1 to report both edges, or 0 to report only the press.
+ *
+ * @return None
+ */
+void PMOD_BTN_Set_Both_Edges(uint8_t enable);
+
 #endif /* PMOD_BTN_INTERRUPT_H_ */
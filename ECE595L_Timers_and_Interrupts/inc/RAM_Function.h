@@ -0,0 +1,36 @@
+/**
+ * @file RAM_Function.h
+ * @brief Attribute that places the most frequent interrupt handlers in SRAM.
+ *
+ * At 48 MHz, the flash needs 2 wait states (see Clock_Init48MHz), so each instruction fetch that misses the flash
+ * read buffer stalls the CPU. The functions marked with RAM_FUNCTION are placed in the .TI.ramfunc section,
+ * which msp432p401r.cmd loads in flash (MAIN) and runs from SRAM_CODE. Reset_Handler (startup_msp432p401r_ccs.c)
+ * copies the section to SRAM before _c_int00, so the functions can be called as soon as main starts.
+ * The functions that they call stay in flash, unless the compiler inlines them.
+ *
+ * The attribute is only applied when RAM_FUNCTION_ENABLE is defined as 1 (e.g. with --define=RAM_FUNCTION_ENABLE=1),
+ * which is the case in the Release and Release_Size configurations. The Debug configuration keeps all the code in flash.
+ * To compare both placements, build the Benchmarks project in Debug and in Release: the isr_in_sram line of the results
+ * shows the placement, and the systick_handler, port4_handler, port6_handler, and uart_tx_handler lines show the cost
+ * of the handlers at each clock profile.
+ *
+ * @note Each function takes the same amount of SRAM as its code, out of the 64 KB shared with the data and the stack.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef RAM_FUNCTION_H_
+#define RAM_FUNCTION_H_
+
+#ifndef RAM_FUNCTION_ENABLE
+#define RAM_FUNCTION_ENABLE 0
+#endif
+
+#if RAM_FUNCTION_ENABLE && defined(__TI_COMPILER_VERSION__)
+#define RAM_FUNCTION __attribute__((ramfunc))
+#else
+#define RAM_FUNCTION
+#endif
+
+#endif /* RAM_FUNCTION_H_ */
@@ -0,0 +1,175 @@
+/**
+ * @file Sampler.h
+ * @brief Header file for the Sampler driver.
+ *
+ * This file contains the function definitions for the Sampler driver.
+ * It samples digital inputs (e.g. the bumper switches and the PMOD BTN push buttons) at a fixed period for each input,
+ * and keeps the last SAMPLER_WINDOW_SIZE samples of each input in a ring buffer that is allocated statically.
+ *
+ * The inputs are read by a task of the Scheduler, so the samples are taken in the main loop instead of in interrupt context,
+ * and the time base is the SysTick tick count. The task runs at the greatest common divisor of the periods of the inputs,
+ * and it only reads the inputs whose period has elapsed.
+ *
+ * The task is only registered while the inputs are sampled. Sampler_Start starts sampling (e.g. from the handler of
+ * a bumper or push button event), and the task removes itself once no pin of any input has been active for
+ * SAMPLER_WINDOW_SIZE samples. The windows keep their samples after sampling stops.
+ *
+ * Storing a sample only writes one byte in the ring buffer. The features of a window (hit counts, hold durations,
+ * and rate of change) are computed when Sampler_Get_Features is called, and the result is kept until the next sample,
+ * so the cost is paid once per sample period of the consumer, and only if it asks for the features.
+ *
+ * Usage:
+ *
+ *      Scheduler_Init();
+ *      Sampler_Init();
+ *      int8_t bumper_input = Sampler_Add_Input(&Bumper_Read, 0x3F, 10);    // Every 10 ticks
+ *      ...
+ *      Sampler_Start();                                                    // From the handler of a bumper event
+ *      ...
+ *      Sampler_Features features;
+ *      Sampler_Get_Features(bumper_input, &features);
+ *      if (features.hold_ticks[0] > 500) ...                               // BUMP_0 is pressed for more than 500 ticks
+ *
+ * @note The functions must only be called from the main loop (or from the tasks), like the Scheduler functions.
+ *       If the main loop is late by more than one period, the missed samples are skipped.
+ *
+ * @note Power: while the inputs are sampled, the main loop wakes up at the period of the task (e.g. every 10 ms),
+ *       which is shorter than TICKLESS_IDLE_LPM3_MIN_TICKS, so Tickless_Idle only uses LPM0. Once the inputs are
+ *       inactive for a window (e.g. 64 x 20 ms = 1.28 s for the slowest input), the task stops and LPM3 can be used.
+ *       The cost is that a window only holds the samples taken after Sampler_Start: the first sample of a press
+ *       is taken up to one period after its edge event, and the window of an idle robot is not updated.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef SAMPLER_H_
+#define SAMPLER_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Maximum number of inputs that can be sampled at the same time
+ */
+#define SAMPLER_MAX_INPUTS 4
+
+/**
+ * @brief Number of samples kept for each input (must be a power of two)
+ */
+#define SAMPLER_WINDOW_SIZE 64
+
+/**
+ * @brief Number of pins of an input (one bit of a sample for each pin)
+ */
+#define SAMPLER_NUM_PINS 8
+
+/**
+ * @brief Features of the samples of the window of an input.
+ *
+ * A pin is active when its bit is 1 in the value returned by the read function of the input.
+ */
+typedef struct
+{
+    uint8_t state;                              // Latest sample
+    uint8_t changed_pins;                       // Pins that changed at least once in the window
+    uint16_t sample_count;                      // Number of samples in the window (SAMPLER_WINDOW_SIZE once it is full)
+    uint32_t timestamp;                         // SysTick tick count of the latest sample
+    uint32_t window_ticks;                      // Time covered by the window (sample_count * period_ticks)
+    uint16_t hit_counts[SAMPLER_NUM_PINS];      // Number of times that each pin became active in the window
+    uint32_t hold_ticks[SAMPLER_NUM_PINS];      // Time that each pin has been active up to the latest sample (0 if it is inactive, window_ticks at most)
+    uint32_t changes_per_1000_ticks;            // Rate of change: number of pin changes per 1000 ticks over the window
+} Sampler_Features;
+
+/**
+ * @brief Initializes the Sampler and removes all inputs.
+ *
+ * @param None
+ *
+ * @note Scheduler_Init must be called before this function, since the Sampler task is registered with the Scheduler.
+ *
+ * @return None
+ */
+void Sampler_Init(void);
+
+/**
+ * @brief Adds an input to sample.
+ *
+ * The first sample is taken 'period_ticks' ticks after this function is called. The samples of the inputs
+ * that were already added are taken at the same ticks as the samples of the new input from now on.
+ *
+ * @param read         A pointer to the function that returns the current state of the input (e.g. Bumper_Read).
+ * @param pin_mask     The bits of the value returned by 'read' that are stored in the samples.
+ * @param period_ticks The number of SysTick ticks between two samples (at least 1).
+ *
+ * @note The input is not sampled until Sampler_Start is called.
+ *
+ * @return The ID of the input (0 to SAMPLER_MAX_INPUTS - 1), or -1 if no more inputs can be added.
+ */
+int8_t Sampler_Add_Input(uint8_t (*read)(void), uint8_t pin_mask, uint32_t period_ticks);
+
+/**
+ * @brief Starts sampling the inputs, or keeps sampling them if they are already sampled.
+ *
+ * Sampling stops when no pin of any input has been active for SAMPLER_WINDOW_SIZE samples since this function was called.
+ *
+ * @param None
+ *
+ * @return 0 on success, or -1 if no input was added or if the Sampler task cannot be registered.
+ */
+int8_t Sampler_Start(void);
+
+/**
+ * @brief Returns 1 if the inputs are being sampled, otherwise 0.
+ *
+ * @param None
+ *
+ * @return 1 if the Sampler task is registered, otherwise 0.
+ */
+uint8_t Sampler_Is_Running(void);
+
+/**
+ * @brief Returns the features of the samples in the window of an input.
+ *
+ * The features are only computed again if a sample was taken since the previous call.
+ *
+ * @param input    The ID returned by Sampler_Add_Input.
+ * @param features Pointer to the structure that stores the features.
+ *
+ * @return 0 on success, or -1 if the ID is not valid or the input has no sample yet.
+ */
+int8_t Sampler_Get_Features(int8_t input, Sampler_Features *features);
+
+/**
+ * @brief Copies the latest samples of an input, decimated by a given factor, from the oldest to the newest.
+ *
+ * Each copied sample is the OR of 'decimation' consecutive samples, so a pin that was active in any of them
+ * is active in the result (a press shorter than the decimated period is not lost).
+ *
+ * @param input      The ID returned by Sampler_Add_Input.
+ * @param samples    Pointer to the buffer that stores the samples. It must hold at least 'count' samples.
+ * @param count      The maximum number of samples to copy.
+ * @param decimation The number of samples combined in each copied sample (1 copies the samples as they are).
+ *
+ * @return The number of samples copied, which is lower than 'count' if the window does not hold enough samples.
+ */
+uint16_t Sampler_Get_Window(int8_t input, uint8_t *samples, uint16_t count, uint16_t decimation);
+
+/**
+ * @brief Returns the period of an input in ticks.
+ *
+ * @param input The ID returned by Sampler_Add_Input.
+ *
+ * @return The period, or 0 if the ID is not valid.
+ */
+uint32_t Sampler_Get_Period(int8_t input);
+
+/**
+ * @brief Task of the Scheduler that samples the inputs whose period has elapsed. It is registered by Sampler_Start.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Sampler_Task(void);
+
+#endif /* SAMPLER_H_ */
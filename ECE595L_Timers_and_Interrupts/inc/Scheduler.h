@@ -0,0 +1,125 @@
+/**
+ * @file Scheduler.h
+ * @brief Header file for the Scheduler driver.
+ *
+ * This file contains the function definitions for the Scheduler driver.
+ * It runs periodic and one-shot tasks from the main loop using the tick count of the SysTick timer.
+ * The tasks are kept sorted by their next deadline, so the main loop only needs to look at the first task
+ * to find out if there is anything to do, and it can sleep with WaitForInterrupt when there is not.
+ *
+ * @note The tasks are cooperative: each task runs to completion in the main loop and should return quickly.
+ *       The Scheduler functions must only be called from the main loop (or from the tasks), not from interrupt handlers.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Maximum number of tasks that can be registered at the same time
+ */
+#define SCHEDULER_MAX_TASKS 8
+
+/**
+ * @brief Initializes the Scheduler and removes all tasks.
+ *
+ * @param None
+ *
+ * @note The SysTick timer must be initialized with SysTick_Interrupt_Init, and SysTick_Handler must increment
+ *       SysTick_Interrupt_Ticks, since the tick count is used as the time base.
+ *
+ * @return None
+ */
+void Scheduler_Init();
+
+/**
+ * @brief Registers a task with the Scheduler.
+ *
+ * The task first runs 'phase_ticks' ticks after this function is called. Then, it runs every 'period_ticks' ticks.
+ * If 'period_ticks' is 0, the task runs once and is removed.
+ *
+ * @param task         A pointer to the user-defined function that will be called.
+ * @param period_ticks The number of SysTick ticks between two runs of the task, or 0 for a one-shot task.
+ * @param phase_ticks  The number of SysTick ticks before the first run of the task.
+ *
+ * @return The ID of the task (0 to SCHEDULER_MAX_TASKS - 1), or -1 if no more tasks can be registered.
+ */
+int8_t Scheduler_Add_Task(void(*task)(void), uint32_t period_ticks, uint32_t phase_ticks);
+
+/**
+ * @brief Removes a task from the Scheduler.
+ *
+ * @param task_id The ID returned by Scheduler_Add_Task.
+ *
+ * @return None
+ */
+void Scheduler_Remove_Task(int8_t task_id);
+
+/**
+ * @brief Restarts the period of a task.
+ *
+ * The next run of the task is set to 'period_ticks' ticks from now, as if the task had just run.
+ *
+ * @param task_id The ID returned by Scheduler_Add_Task.
+ *
+ * @return None
+ */
+void Scheduler_Restart_Task(int8_t task_id);
+
+/**
+ * @brief Changes the period of a task and restarts it.
+ *
+ * The next run of the task is set to 'period_ticks' ticks from now.
+ *
+ * @param task_id      The ID returned by Scheduler_Add_Task.
+ * @param period_ticks The new period of the task in ticks. A value of 0 makes the task run once.
+ *
+ * @return None
+ */
+void Scheduler_Set_Period(int8_t task_id, uint32_t period_ticks);
+
+/**
+ * @brief Returns the period of a task in ticks.
+ *
+ * @param task_id The ID returned by Scheduler_Add_Task.
+ *
+ * @return The period of the task, or 0 if the task is a one-shot task or the ID is not valid.
+ */
+uint32_t Scheduler_Get_Period(int8_t task_id);
+
+/**
+ * @brief Runs all tasks whose deadline has been reached.
+ *
+ * This function should be called from the main loop. Periodic tasks are scheduled again based on their previous
+ * deadline, so they do not drift when the main loop is late. If a task is late by more than one period,
+ * the missed runs are skipped.
+ *
+ * @param None
+ *
+ * @return The number of tasks that were run.
+ */
+uint32_t Scheduler_Run();
+
+/**
+ * @brief Returns 1 if at least one task has reached its deadline.
+ *
+ * @param None
+ *
+ * @return 1 if Scheduler_Run would run a task now, otherwise 0.
+ */
+uint8_t Scheduler_Is_Task_Due();
+
+/**
+ * @brief Returns the deadline of the next task.
+ *
+ * @param deadline Pointer to the variable where the SysTick tick count of the next deadline will be stored.
+ *
+ * @return 1 if a task is registered and 'deadline' was written, otherwise 0.
+ */
+uint8_t Scheduler_Get_Next_Deadline(uint32_t *deadline);
+
+#endif /* SCHEDULER_H_ */
@@ -0,0 +1,88 @@
+/**
+ * @file Shell.h
+ * @brief Header file for the Shell driver.
+ *
+ * This file contains the function definitions for the Shell driver.
+ * It is a small command shell that runs from the main loop without blocking.
+ * The characters are received by EUSCIA0_IRQHandler and a line is assembled by EUSCI_A0_UART_Line_Poll.
+ * When a line is complete, it is split into words separated by spaces, and the handler of the command
+ * that matches the first word is called with the words as arguments.
+ *
+ * Example: "debounce p4 0 50" calls the handler of "debounce" with argc = 4 and argv = {"debounce", "p4", "0", "50"}.
+ *
+ * The "help" command is always available and prints the registered commands.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef SHELL_H_
+#define SHELL_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+/**
+ * @brief Maximum number of commands that can be registered.
+ */
+#define SHELL_MAX_COMMANDS 12
+
+/**
+ * @brief Maximum number of characters in a command line.
+ */
+#define SHELL_LINE_SIZE 64
+
+/**
+ * @brief Maximum number of words in a command line, including the command.
+ */
+#define SHELL_MAX_ARGS 6
+
+/**
+ * @brief Handler of a command. argv[0] is the name of the command.
+ */
+typedef void (*Shell_Handler)(int argc, char *argv[]);
+
+/**
+ * @brief Initializes the Shell and prints the prompt.
+ *
+ * @param None
+ *
+ * @note EUSCI_A0_UART_Init_Printf must be called before this function.
+ *
+ * @return None
+ */
+void Shell_Init();
+
+/**
+ * @brief Registers a command.
+ *
+ * @param name    The name of the command. The string is not copied, so it must stay valid (e.g. a string literal).
+ * @param help    A short description printed by the "help" command.
+ * @param handler A pointer to the function that is called when the command is entered.
+ *
+ * @return 0 if the command was registered, or -1 if SHELL_MAX_COMMANDS commands are already registered.
+ */
+int8_t Shell_Register_Command(const char *name, const char *help, Shell_Handler handler);
+
+/**
+ * @brief Processes the received characters and runs the command when a line is complete.
+ *
+ * This function should be called from the main loop. It returns immediately when no complete line has been received.
+ *
+ * @param None
+ *
+ * @return 1 if a command line was processed, otherwise 0.
+ */
+uint8_t Shell_Run();
+
+/**
+ * @brief Converts a decimal or hexadecimal ("0x" prefix) string to an unsigned number.
+ *
+ * @param text  The string to convert.
+ * @param value Pointer to the variable that stores the result.
+ *
+ * @return 1 if the string is a valid number, otherwise 0.
+ */
+uint8_t Shell_Parse_UInt(const char *text, uint32_t *value);
+
+#endif /* SHELL_H_ */
@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 #include "msp.h"
+#include "IRQ_Priority.h"
 
 // The toggle rate for SysTick_Interrupt in ms
 #define SYSTICK_INT_TOGGLE_RATE_MS 500
@@ -24,10 +25,27 @@
 // clock cycle would last about 20.83 ns
 // Therefore, using a value of 48,000 would result in the
 // time interval for a SysTick interrupt of 1 ms
+// After a switch to another clock profile, the number of cycles is scaled
+// so that the interval stays at 1 ms (e.g. 3,000 cycles at 3 MHz)
 #define SYSTICK_INT_NUM_CLK_CYCLES 48000
 
-// The priority level of the SysTick interrupt
-#define SYSTICK_INT_PRIORITY 2
+// The priority level of the SysTick interrupt, from the priority table of IRQ_Priority.h
+#define SYSTICK_INT_PRIORITY IRQ_PRIORITY_SYSTICK
+
+/**
+ * @brief Number of SysTick interrupts that have occurred since SysTick_Interrupt_Init was called.
+ *
+ * SysTick_Handler must increment this counter on each interrupt with SysTick_Interrupt_Add_Ticks.
+ * With SYSTICK_INT_NUM_CLK_CYCLES set to 48000, each tick is 1 ms.
+ */
+extern volatile uint32_t SysTick_Interrupt_Ticks;
+
+/**
+ * @brief Number of times SysTick_Interrupt_Ticks has rolled over.
+ *
+ * Together with SysTick_Interrupt_Ticks, it forms a 64-bit tick count that is used by the Time driver.
+ */
+extern volatile uint32_t SysTick_Interrupt_Ticks_High;
 
 /**
  * @brief Initializes the SysTick timer with periodic interrupts.
@@ -50,8 +68,61 @@
  *
  * @note The SysTick timer will be enabled and configured with the provided parameters during the function execution.
  *
+ * @note A clock change handler is registered, so 'clock_cycles' is scaled by Clock_SetProfile and the period stays the same.
+ *       The tick in progress during a switch is counted as a whole tick.
+ *
  * @return None
  */
 void SysTick_Interrupt_Init(uint32_t clock_cycles, uint32_t priority);
 
+/**
+ * @brief Adds a number of ticks to the 64-bit tick count.
+ *
+ * SysTick_Handler calls this function with a value of 1. Tickless_Idle calls it with the number of ticks that passed during a sleep.
+ * When SysTick_Interrupt_Ticks rolls over, both words are updated with interrupts disabled, so that a handler
+ * with a higher priority never reads a new low word with an old high word.
+ *
+ * @param ticks The number of ticks to add.
+ *
+ * @return None
+ */
+void SysTick_Interrupt_Add_Ticks(uint32_t ticks);
+
+/**
+ * @brief Returns the number of SysTick interrupts that have occurred.
+ *
+ * The counter rolls over after 2^32 ticks. Use unsigned subtraction (now - then) to compute
+ * elapsed ticks so that the result stays correct across a rollover.
+ *
+ * @return The value of SysTick_Interrupt_Ticks.
+ */
+uint32_t SysTick_Interrupt_Get_Ticks(void);
+
+/**
+ * @brief Returns the number of clock cycles per tick.
+ *
+ * @return The 'clock_cycles' value passed to SysTick_Interrupt_Init, scaled to the current clock profile.
+ */
+uint32_t SysTick_Interrupt_Get_Cycles_Per_Tick(void);
+
+/**
+ * @brief Converts a time in ms to a number of ticks, with the current tick period.
+ *
+ * The tick period is 1 ms with SYSTICK_INT_NUM_CLK_CYCLES, but it can be changed with the Config driver.
+ *
+ * @param ms The time in ms.
+ *
+ * @return The number of ticks (at least 1 if 'ms' is not 0).
+ */
+uint32_t SysTick_Interrupt_Ms_To_Ticks(uint32_t ms);
+
+/**
+ * @brief Converts a number of ticks to a time in ms, with the current tick period.
+ *
+ * @param ticks The number of ticks.
+ *
+ * @return The time in ms.
+ */
+uint32_t SysTick_Interrupt_Ticks_To_Ms(uint32_t ticks);
+
 #endif /* SYSTICK_INTERRUPT_H_ */
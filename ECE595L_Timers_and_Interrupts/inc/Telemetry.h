@@ -0,0 +1,128 @@
+/**
+ * @file Telemetry.h
+ * @brief Header file for the Telemetry driver.
+ *
+ * This file contains the function definitions for the Telemetry driver.
+ * It sends compact binary records to the serial terminal instead of formatted text.
+ * Each record has the following format before framing (multi-byte fields are little-endian):
+ *
+ *  Offset  Size    Field
+ *  ------  ----    -----
+ *    0       1     Type (Telemetry_Type)
+ *    1       4     Timestamp (SysTick tick count in ms)
+ *    5       N     Payload (depends on the type)
+ *   5+N      2     CRC-16/CCITT-FALSE of the bytes above (polynomial 0x1021, initial value 0xFFFF)
+ *
+ * The record is encoded with COBS (Consistent Overhead Byte Stuffing), so it contains no 0x00 bytes,
+ * and it is sent between two 0x00 delimiters. Text printed with printf between records (e.g. by the Shell)
+ * does not contain 0x00 bytes, so the host decoder can separate the text from the records.
+ *
+ * The host decoder is tools/telemetry_decoder.py.
+ *
+ * Payloads:
+ *  - TELEMETRY_TYPE_BUMPER:   state (1 byte, format of Bumper_Read)
+ *  - TELEMETRY_TYPE_PMOD_BTN: state (1 byte, format of PMOD_BTN_Read), PMOD_BTN counter (1 byte)
+ *  - TELEMETRY_TYPE_COUNTER:  counter ID (1 byte), value (4 bytes)
+ *  - TELEMETRY_TYPE_PROFILER: IRQ (1 byte, ISR_Profiler_IRQ), count, min, max, mean, lat_min, lat_max, lat_mean (4 bytes each)
+ *  - TELEMETRY_TYPE_TRACE:    format ID (1 byte, Trace_Format), level (1 byte), two arguments (4 bytes each)
+ *
+ * @note The characters are queued with EUSCI_A0_UART_OutChar, so the functions must be called from the main loop
+ *       (e.g. from the handlers called by Event_Queue_Dispatch), like printf.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/ISR_Profiler.h"
+
+/**
+ * @brief Maximum payload size of a record in bytes.
+ */
+#define TELEMETRY_MAX_PAYLOAD_SIZE 32
+
+/**
+ * @brief Record types.
+ */
+typedef enum
+{
+    TELEMETRY_TYPE_BUMPER = 1,
+    TELEMETRY_TYPE_PMOD_BTN = 2,
+    TELEMETRY_TYPE_COUNTER = 3,
+    TELEMETRY_TYPE_PROFILER = 4,
+    TELEMETRY_TYPE_TRACE = 5
+} Telemetry_Type;
+
+/**
+ * @brief Sends a record with the specified type, timestamp, and payload.
+ *
+ * @param type      The record type.
+ * @param timestamp The timestamp of the record in ms (e.g. Event_Queue_Get_Timestamp or SysTick_Interrupt_Get_Ticks).
+ * @param payload   Pointer to the payload.
+ * @param length    Length of the payload in bytes (0 to TELEMETRY_MAX_PAYLOAD_SIZE).
+ *
+ * @return None
+ */
+void Telemetry_Send(Telemetry_Type type, uint32_t timestamp, const uint8_t *payload, uint8_t length);
+
+/**
+ * @brief Sends a TELEMETRY_TYPE_BUMPER record.
+ *
+ * @param timestamp The timestamp of the event in ms.
+ * @param state     The state of the Bumper Sensors.
+ *
+ * @return None
+ */
+void Telemetry_Send_Bumper(uint32_t timestamp, uint8_t state);
+
+/**
+ * @brief Sends a TELEMETRY_TYPE_PMOD_BTN record.
+ *
+ * @param timestamp The timestamp of the event in ms.
+ * @param state     The state of the PMOD BTN module.
+ * @param counter   The value shown on the PMOD 8LD module.
+ *
+ * @return None
+ */
+void Telemetry_Send_PMOD_BTN(uint32_t timestamp, uint8_t state, uint8_t counter);
+
+/**
+ * @brief Sends a TELEMETRY_TYPE_COUNTER record.
+ *
+ * @param timestamp  The timestamp in ms.
+ * @param counter_id An application-defined ID of the counter.
+ * @param value      The value of the counter.
+ *
+ * @return None
+ */
+void Telemetry_Send_Counter(uint32_t timestamp, uint8_t counter_id, uint32_t value);
+
+/**
+ * @brief Sends a TELEMETRY_TYPE_PROFILER record with the statistics of one interrupt.
+ *
+ * Unknown latencies are sent as 0xFFFFFFFF, and the histogram is not sent.
+ *
+ * @param timestamp The timestamp in ms.
+ * @param irq       The interrupt.
+ * @param stats     Pointer to the statistics returned by ISR_Profiler_Get_Stats.
+ *
+ * @return None
+ */
+void Telemetry_Send_Profiler(uint32_t timestamp, ISR_Profiler_IRQ irq, const ISR_Profiler_Stats *stats);
+
+/**
+ * @brief Computes the CRC-16/CCITT-FALSE of a buffer with the CRC32 module (see CRC.h).
+ *
+ * @param crc    The initial value (0xFFFF), or the result of the previous call to continue the computation.
+ * @param data   Pointer to the data.
+ * @param length Length of the data in bytes.
+ *
+ * @return The updated CRC.
+ */
+uint16_t Telemetry_CRC16(uint16_t crc, const uint8_t *data, uint32_t length);
+
+#endif /* TELEMETRY_H_ */
@@ -0,0 +1,98 @@
+/**
+ * @file Tickless_Idle.h
+ * @brief Header file for the Tickless_Idle driver.
+ *
+ * This file contains the function definitions for the Tickless_Idle driver.
+ * When the main loop has nothing to do until the next Scheduler deadline, the driver stops the 1 ms SysTick interrupt
+ * and sleeps until that deadline (or until another interrupt occurs). On wake-up, it adds the number of ticks that
+ * have passed to SysTick_Interrupt_Ticks and restarts SysTick so that the tick count does not drift.
+ *
+ * Two low-power modes are used:
+ *  - LPM0 (Sleep): SysTick keeps running from MCLK. It is reloaded to fire once at the deadline.
+ *                  The longest sleep is limited by the 24-bit SysTick counter (349 ticks at 48 MHz).
+ *  - LPM3 (Deep Sleep): MCLK and SMCLK are stopped, so SysTick and EUSCI_A0 stop as well.
+ *                  TIMER_A3 runs from ACLK (REFOCLK, 32.768 kHz) and wakes up the CPU at the deadline.
+ *                  The longest sleep is 2 seconds (65535 ACLK cycles), and the resolution is about 30.5 us.
+ *
+ * @note SysTick is stopped for a few cycles on each sleep and wake-up, so the tick count can lag by up to a few cycles per sleep.
+ *
+ * @note TIMER_A3 and TA3_0_IRQHandler are reserved by this driver.
+ *
+ * @note The PORT4 and PORT6 interrupts used by the Bumper Sensors and the PMOD BTN module can wake up the CPU from both modes.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef TICKLESS_IDLE_H_
+#define TICKLESS_IDLE_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+/**
+ * @brief Shortest sleep (in ticks) for which SysTick is reprogrammed. Shorter sleeps use a plain WFI.
+ */
+#define TICKLESS_IDLE_MIN_TICKS 2
+
+/**
+ * @brief Shortest sleep (in ticks) for which LPM3 is used. The wake-up from LPM3 includes the restart of HFXT.
+ */
+#define TICKLESS_IDLE_LPM3_MIN_TICKS 20
+
+/**
+ * @brief Low-power modes that can be selected with Tickless_Idle_Set_Mode.
+ *
+ *  - TICKLESS_IDLE_MODE_LPM0: Only LPM0 is used
+ *  - TICKLESS_IDLE_MODE_LPM3: LPM3 is used for long sleeps when EUSCI_A0 is not transmitting, its receive interrupt is disabled
+ *                             (EUSCI_A0_UART_Set_RX_Enable), no Timer_A_Interrupt or Timer32_Interrupt timer is running,
+ *                             and no Timer_A_PWM timer uses SMCLK, otherwise LPM0
+ */
+typedef enum
+{
+    TICKLESS_IDLE_MODE_LPM0 = 0,
+    TICKLESS_IDLE_MODE_LPM3
+} Tickless_Idle_Mode;
+
+/**
+ * @brief Initializes TIMER_A3 and its interrupt (IRQ 14), which are used to wake up from LPM3.
+ *
+ * @param mode The low-power mode to use.
+ *
+ * @note SysTick_Interrupt_Init must be called before this function.
+ *
+ * @return None
+ */
+void Tickless_Idle_Init(Tickless_Idle_Mode mode);
+
+/**
+ * @brief Selects the low-power mode to use.
+ *
+ * @param mode The low-power mode to use.
+ *
+ * @return None
+ */
+void Tickless_Idle_Set_Mode(Tickless_Idle_Mode mode);
+
+/**
+ * @brief Sleeps for up to 'idle_ticks' ticks or until an interrupt occurs.
+ *
+ * This function must be called with interrupts disabled (CortexM_Disable_Interrupts), after checking that there is nothing to do.
+ * The interrupt that wakes up the CPU is handled once interrupts are enabled again, after the tick count has been corrected.
+ *
+ * @param idle_ticks The number of ticks until the next deadline. Values that are too large for the selected mode are reduced.
+ *
+ * @return The number of ticks that were added to SysTick_Interrupt_Ticks (not including a pending SysTick interrupt).
+ */
+uint32_t Tickless_Idle_Sleep(uint32_t idle_ticks);
+
+/**
+ * @brief Interrupt handler for TIMER_A3 CCR0.
+ *
+ * This function clears the CCR0 interrupt flag and stops TIMER_A3 after a wake-up from LPM3.
+ *
+ * @return None
+ */
+void TA3_0_IRQHandler(void);
+
+#endif /* TICKLESS_IDLE_H_ */
@@ -0,0 +1,72 @@
+/**
+ * @file Time.h
+ * @brief Header file for the Time driver.
+ *
+ * This file contains the function definitions for the Time driver.
+ * It provides a 64-bit monotonic time base in clock cycles and in microseconds.
+ * The time is computed from the 64-bit SysTick tick count and the current value of the SysTick down-counter,
+ * so its resolution is one clock cycle (20.83 ns at 48 MHz) instead of one tick.
+ *
+ * The functions do not disable interrupts and can be called from the main loop and from any interrupt handler.
+ * If a SysTick reload has occurred but SysTick_Handler has not run yet (e.g. when called from a handler with a
+ * higher priority), the pending tick is counted, so the time never goes backwards.
+ *
+ * @note The time is not valid while the SysTick interrupt is disabled for more than one tick,
+ *       or during Tickless_Idle_Sleep (which is called with interrupts disabled).
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef TIME_H_
+#define TIME_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+/**
+ * @brief Initializes the Time driver with the SysTick period and the clock frequency.
+ *
+ * @param None
+ *
+ * @note Clock_Init48MHz and SysTick_Interrupt_Init must be called before this function.
+ *       It must be called again if the SysTick period is changed with SysTick_Interrupt_Init.
+ *       A clock profile switch (Clock_SetProfile) is handled by a clock change handler registered by this function.
+ *
+ * @return None
+ */
+void Time_Init(void);
+
+/**
+ * @brief Returns the number of clock cycles since SysTick_Interrupt_Init was called.
+ *
+ * After a clock profile switch, the count continues from its value at the switch in cycles of the new clock,
+ * so an interval that spans a switch is not measured in a single unit. Use Time_NowUs for such intervals.
+ *
+ * @param None
+ *
+ * @return The 64-bit time in clock cycles.
+ */
+uint64_t Time_NowCycles(void);
+
+/**
+ * @brief Returns the number of microseconds since SysTick_Interrupt_Init was called.
+ *
+ * When the SysTick period is a whole number of microseconds (e.g. 1 ms), no 64-bit division is used.
+ *
+ * @param None
+ *
+ * @return The 64-bit time in microseconds.
+ */
+uint64_t Time_NowUs(void);
+
+/**
+ * @brief Returns the number of clock cycles per microsecond.
+ *
+ * @param None
+ *
+ * @return The number of clock cycles per microsecond (48 at 48 MHz, 3 at 3 MHz).
+ */
+uint32_t Time_Get_Cycles_Per_Us(void);
+
+#endif /* TIME_H_ */
@@ -0,0 +1,90 @@
+/**
+ * @file Timer32_Interrupt.h
+ * @brief Header file for the Timer32_Interrupt driver.
+ *
+ * This file contains the function definitions for the Timer32_Interrupt driver.
+ * It uses TIMER32_1 or TIMER32_2 to perform interrupt requests at the specified period, similar to SysTick_Interrupt.
+ * Each timer is a 32-bit down counter in periodic mode clocked by MCLK (48 MHz with Clock_Init48MHz).
+ *
+ * For more information regarding Timer32, refer to the Timer32 section (18)
+ * of the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @note MCLK is stopped in LPM3, so Tickless_Idle only uses LPM0 while a timer is running.
+ *
+ * @note The periods are given in cycles of the current MCLK. When Clock_SetProfile changes MCLK, the period of each
+ *       running timer is scaled so that it stays the same in time (from the end of the current period).
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef TIMER32_INTERRUPT_H_
+#define TIMER32_INTERRUPT_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+/**
+ * @brief Timers that can be used by the Timer32_Interrupt driver.
+ */
+typedef enum
+{
+    TIMER32_INT_1 = 0,
+    TIMER32_INT_2,
+    TIMER32_INT_NUM_TIMERS
+} Timer32_Interrupt_Timer;
+
+/**
+ * @brief Initializes a Timer32 timer with periodic interrupts.
+ *
+ * This function configures the timer to generate an interrupt every 'clock_cycles' MCLK cycles and registers
+ * the task that is called from its interrupt handler (T32_INT1_IRQHandler or T32_INT2_IRQHandler).
+ *
+ * @param timer        The timer to use.
+ * @param clock_cycles The number of MCLK cycles between interrupts. The valid range is from 1 to 2^32 - 1.
+ *                     For example, a value of 4800 results in a 10 kHz interrupt rate.
+ * @param priority     The priority level of the interrupt. Valid values range from 0 (highest priority) to 7 (lowest priority).
+ *                     Use IRQ_PRIORITY_TIMER_TASK for a task of the control tier (see IRQ_Priority.h).
+ * @param task         A pointer to the user-defined function that is called on each period. It can be 0.
+ *
+ * @return None
+ */
+void Timer32_Interrupt_Init(Timer32_Interrupt_Timer timer, uint32_t clock_cycles, uint32_t priority, void(*task)(void));
+
+/**
+ * @brief Changes the period of a running timer. The new period starts after the current period ends.
+ *
+ * @param timer        The timer initialized by Timer32_Interrupt_Init.
+ * @param clock_cycles The number of MCLK cycles between interrupts.
+ *
+ * @return None
+ */
+void Timer32_Interrupt_Set_Period(Timer32_Interrupt_Timer timer, uint32_t clock_cycles);
+
+/**
+ * @brief Stops a timer and disables its interrupt.
+ *
+ * @param timer The timer.
+ *
+ * @return None
+ */
+void Timer32_Interrupt_Stop(Timer32_Interrupt_Timer timer);
+
+/**
+ * @brief Returns 1 if any timer of the Timer32_Interrupt driver is running, otherwise 0.
+ *
+ * @param None
+ *
+ * @return 1 if a timer is running, otherwise 0.
+ */
+uint8_t Timer32_Interrupt_Is_Running();
+
+/**
+ * @brief Interrupt handlers for TIMER32_1 (IRQ 25) and TIMER32_2 (IRQ 26).
+ *
+ * @return None
+ */
+void T32_INT1_IRQHandler(void);
+void T32_INT2_IRQHandler(void);
+
+#endif /* TIMER32_INTERRUPT_H_ */
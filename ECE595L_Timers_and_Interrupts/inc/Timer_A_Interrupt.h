@@ -0,0 +1,134 @@
+/**
+ * @file Timer_A_Interrupt.h
+ * @brief Header file for the Timer_A_Interrupt driver.
+ *
+ * This file contains the function definitions for the Timer_A_Interrupt driver.
+ * It uses TIMER_A0 or TIMER_A1 to perform interrupt requests at the specified period, similar to SysTick_Interrupt.
+ * Each timer runs in up mode from SMCLK (12 MHz). CCR0 sets the period and calls the periodic task.
+ * CCR1 to CCR4 can each call another task once per period, at a specified offset from the start of the period.
+ *
+ * For more information regarding Timer_A, refer to the Timer_A section (19)
+ * of the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @note TIMER_A2 and TIMER_A3 are reserved by the Debounce and Tickless_Idle drivers.
+ * A timer that is running with the Timer_A_PWM driver cannot be used by this driver: Timer_A_Interrupt_Init returns -1
+ * until it is stopped with Timer_A_PWM_Stop.
+ *
+ * @note SMCLK is stopped in LPM3, so Tickless_Idle only uses LPM0 while a timer is running.
+ *
+ * @note The periods and offsets are given in cycles of the current SMCLK. When Clock_SetProfile changes SMCLK,
+ *       the running timers are restarted with their period and compare offsets scaled, so they stay the same in time.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef TIMER_A_INTERRUPT_H_
+#define TIMER_A_INTERRUPT_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+// Frequency of SMCLK (configured by Clock_Init48MHz)
+// It is 3 MHz in CLOCK_PROFILE_3MHZ, use Clock_GetSMCLKFreq to get the current frequency
+#define TIMER_A_INT_SMCLK_FREQUENCY 12000000
+
+// Number of compare channels (CCR1 to CCR4) that can call a task
+#define TIMER_A_INT_NUM_COMPARE_CHANNELS 4
+
+// Longest period in SMCLK cycles (65536 timer cycles with a divider of 64)
+#define TIMER_A_INT_MAX_CLK_CYCLES 4194304
+
+/**
+ * @brief Timers that can be used by the Timer_A_Interrupt driver.
+ */
+typedef enum
+{
+    TIMER_A_INT_TA0 = 0,
+    TIMER_A_INT_TA1,
+    TIMER_A_INT_NUM_TIMERS
+} Timer_A_Interrupt_Timer;
+
+/**
+ * @brief Initializes a Timer_A timer with periodic interrupts.
+ *
+ * This function configures the timer to generate an interrupt every 'clock_cycles' SMCLK cycles and registers
+ * the task that is called from the CCR0 interrupt handler (TA0_0_IRQHandler or TA1_0_IRQHandler).
+ * The smallest clock divider that fits the period in the 16-bit counter is selected. The period is exact when
+ * 'clock_cycles' is a multiple of the divider, otherwise it is rounded down.
+ *
+ * @param timer        The timer to use.
+ * @param clock_cycles The number of SMCLK cycles between interrupts.
+ *                     The valid range for 'clock_cycles' is from 2 to TIMER_A_INT_MAX_CLK_CYCLES.
+ *                     For example, a value of 1200 results in a 10 kHz interrupt rate.
+ * @param priority     The priority level of the interrupts (CCR0 and CCR1 to CCR4). Valid values range from 0 (highest priority) to 7 (lowest priority).
+ *                     Use IRQ_PRIORITY_TIMER_TASK for a task of the control tier (see IRQ_Priority.h).
+ * @param task         A pointer to the user-defined function that is called on each period. It can be 0.
+ *
+ * @note The compare channels are disabled by this function.
+ *
+ * @return 0 on success, or -1 if the timer is not valid or is running with the Timer_A_PWM driver.
+ */
+int8_t Timer_A_Interrupt_Init(Timer_A_Interrupt_Timer timer, uint32_t clock_cycles, uint32_t priority, void(*task)(void));
+
+/**
+ * @brief Sets a compare channel to call a task once per period.
+ *
+ * @param timer         The timer initialized by Timer_A_Interrupt_Init.
+ * @param channel       The compare channel, from 1 to TIMER_A_INT_NUM_COMPARE_CHANNELS.
+ * @param offset_cycles The number of SMCLK cycles from the start of the period to the call of the task.
+ *                      It must be less than the 'clock_cycles' value passed to Timer_A_Interrupt_Init.
+ * @param task          A pointer to the user-defined function that is called from TA0_N_IRQHandler or TA1_N_IRQHandler.
+ *
+ * @return None
+ */
+void Timer_A_Interrupt_Set_Compare(Timer_A_Interrupt_Timer timer, uint8_t channel, uint32_t offset_cycles, void(*task)(void));
+
+/**
+ * @brief Disables a compare channel.
+ *
+ * @param timer   The timer.
+ * @param channel The compare channel, from 1 to TIMER_A_INT_NUM_COMPARE_CHANNELS.
+ *
+ * @return None
+ */
+void Timer_A_Interrupt_Clear_Compare(Timer_A_Interrupt_Timer timer, uint8_t channel);
+
+/**
+ * @brief Stops a timer and disables its interrupts.
+ *
+ * @param timer The timer.
+ *
+ * @return None
+ */
+void Timer_A_Interrupt_Stop(Timer_A_Interrupt_Timer timer);
+
+/**
+ * @brief Returns 1 if a timer is running with the Timer_A_Interrupt driver, otherwise 0.
+ *
+ * @param timer The timer.
+ *
+ * @return 1 if the timer is running, otherwise 0.
+ */
+uint8_t Timer_A_Interrupt_Is_Timer_Running(Timer_A_Interrupt_Timer timer);
+
+/**
+ * @brief Returns 1 if any timer of the Timer_A_Interrupt driver is running, otherwise 0.
+ *
+ * @param None
+ *
+ * @return 1 if a timer is running, otherwise 0.
+ */
+uint8_t Timer_A_Interrupt_Is_Running();
+
+/**
+ * @brief Interrupt handlers for the CCR0 (TAx_0) and CCR1 to CCR4 (TAx_N) interrupts of TIMER_A0 and TIMER_A1.
+ *
+ * @return None
+ */
+void TA0_0_IRQHandler(void);
+void TA0_N_IRQHandler(void);
+void TA1_0_IRQHandler(void);
+void TA1_N_IRQHandler(void);
+
+#endif /* TIMER_A_INTERRUPT_H_ */
@@ -0,0 +1,177 @@
+/**
+ * @file Timer_A_PWM.h
+ * @brief Header file for the Timer_A_PWM driver.
+ *
+ * This file contains the function definitions for the Timer_A_PWM driver.
+ * It generates PWM signals with the compare outputs of TIMER_A0 or TIMER_A1, so LEDs can be dimmed or blinked
+ * (and motors can be driven) by the hardware, without any interrupt or polling by the CPU.
+ *
+ * Each timer runs in up mode: CCR0 sets the period, which is shared by the outputs of the timer,
+ * and CCR1 to CCR4 set the duty cycle of each output in reset/set mode (OUTMOD 7).
+ * Periods up to TIMER_A_PWM_MAX_SMCLK_PERIOD_US use SMCLK (12 MHz) for the best duty cycle resolution.
+ * Longer periods (e.g. blinking an LED once per second) use ACLK (32.768 kHz), which keeps running in LPM3.
+ *
+ * The following pins can be used:
+ *  - TIMER_A_PWM_LED2_RED      <-->  P2.0 (TA1.1, through the port mapping controller)
+ *  - TIMER_A_PWM_LED2_GREEN    <-->  P2.1 (TA1.2, through the port mapping controller)
+ *  - TIMER_A_PWM_LED2_BLUE     <-->  P2.2 (TA1.3, through the port mapping controller)
+ *  - TIMER_A_PWM_MOTOR_RIGHT   <-->  P2.6 (TA0.3, default port mapping)
+ *  - TIMER_A_PWM_MOTOR_LEFT    <-->  P2.7 (TA0.4, default port mapping)
+ *
+ * @note The RSLK LEDs on P8.5 - P8.7, LED1 (P1.0), and the PMOD 8LD (P9) do not have a Timer_A output that is
+ * free (P9.2 and P9.3 are connected to TIMER_A3, which is reserved by Tickless_Idle), and P8.0 only has TA1.0,
+ * which is used for the period. These LEDs are still driven with GPIO.
+ *
+ * @note A timer that is running with the Timer_A_Interrupt driver cannot be used by this driver: Timer_A_PWM_Init returns -1
+ * until it is stopped with Timer_A_Interrupt_Stop.
+ *
+ * @note When Clock_SetProfile changes SMCLK, the running timers are started again with their requested period,
+ * so the period and the duty cycles stay the same.
+ *
+ * For more information regarding Timer_A and the port mapping controller, refer to the Timer_A section (19)
+ * and the Port Mapping Controller section (11) of the MSP432Pxx Microcontrollers Technical Reference Manual
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef TIMER_A_PWM_H_
+#define TIMER_A_PWM_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+// Frequency of SMCLK (configured by Clock_Init48MHz)
+// It is 3 MHz in CLOCK_PROFILE_3MHZ, so the driver uses Clock_GetSMCLKFreq
+#define TIMER_A_PWM_SMCLK_FREQUENCY 12000000
+
+// Frequency of ACLK (sourced from REFOCLK by Clock_Init48MHz)
+#define TIMER_A_PWM_ACLK_FREQUENCY 32768
+
+// Longest period that uses SMCLK at 12 MHz (65536 timer cycles with a divider of 64)
+// At 3 MHz (CLOCK_PROFILE_3MHZ), periods up to 4 times longer use SMCLK
+#define TIMER_A_PWM_MAX_SMCLK_PERIOD_US 349525
+
+// Longest period that uses ACLK (65536 timer cycles with a divider of 64)
+#define TIMER_A_PWM_MAX_PERIOD_US 128000000
+
+// Duty cycle of an output that is always on
+#define TIMER_A_PWM_DUTY_MAX 1000
+
+/**
+ * @brief Timers that can be used by the Timer_A_PWM driver.
+ */
+typedef enum
+{
+    TIMER_A_PWM_TA0 = 0,
+    TIMER_A_PWM_TA1,
+    TIMER_A_PWM_NUM_TIMERS
+} Timer_A_PWM_Timer;
+
+/**
+ * @brief Pins that can be driven by the Timer_A_PWM driver.
+ */
+typedef enum
+{
+    TIMER_A_PWM_LED2_RED = 0,
+    TIMER_A_PWM_LED2_GREEN,
+    TIMER_A_PWM_LED2_BLUE,
+    TIMER_A_PWM_MOTOR_RIGHT,
+    TIMER_A_PWM_MOTOR_LEFT,
+    TIMER_A_PWM_NUM_OUTPUTS
+} Timer_A_PWM_Output;
+
+/**
+ * @brief Starts a timer with the specified PWM period.
+ *
+ * The outputs of the timer are not changed, and their duty cycle is kept.
+ * Calling this function again changes the period (e.g. from dimming at 1 kHz to blinking at 1 Hz).
+ *
+ * @param timer     The timer to use.
+ * @param period_us The period in us, from 1 to TIMER_A_PWM_MAX_PERIOD_US. For example, 1000 results in 1 kHz.
+ *
+ * @return 0 on success, or -1 if the timer is not valid or is running with the Timer_A_Interrupt driver.
+ */
+int8_t Timer_A_PWM_Init(Timer_A_PWM_Timer timer, uint32_t period_us);
+
+/**
+ * @brief Returns the PWM period of a timer in us.
+ *
+ * @param timer The timer.
+ *
+ * @return The period in us, rounded to the resolution of the selected clock, or 0 if the timer is stopped.
+ */
+uint32_t Timer_A_PWM_Get_Period(Timer_A_PWM_Timer timer);
+
+/**
+ * @brief Connects a pin to the compare output of its timer and sets its duty cycle.
+ *
+ * @param output        The pin.
+ * @param duty_permille The duty cycle in tenths of a percent, from 0 (always off) to TIMER_A_PWM_DUTY_MAX (always on).
+ *
+ * @note The timer of the output should be started with Timer_A_PWM_Init.
+ *
+ * @return None
+ */
+void Timer_A_PWM_Enable_Output(Timer_A_PWM_Output output, uint16_t duty_permille);
+
+/**
+ * @brief Disconnects a pin from its timer. The pin is configured as a GPIO output set to 0.
+ *
+ * @param output The pin.
+ *
+ * @return None
+ */
+void Timer_A_PWM_Disable_Output(Timer_A_PWM_Output output);
+
+/**
+ * @brief Changes the duty cycle of an output.
+ *
+ * The new duty cycle is used from the current period, so this function can be called at any time.
+ *
+ * @param output        The pin.
+ * @param duty_permille The duty cycle in tenths of a percent, from 0 (always off) to TIMER_A_PWM_DUTY_MAX (always on).
+ *
+ * @return None
+ */
+void Timer_A_PWM_Set_Duty(Timer_A_PWM_Output output, uint16_t duty_permille);
+
+/**
+ * @brief Returns the duty cycle of an output in tenths of a percent.
+ *
+ * @param output The pin.
+ *
+ * @return The duty cycle.
+ */
+uint16_t Timer_A_PWM_Get_Duty(Timer_A_PWM_Output output);
+
+/**
+ * @brief Stops a timer. Its outputs are set to 0.
+ *
+ * @param timer The timer.
+ *
+ * @return None
+ */
+void Timer_A_PWM_Stop(Timer_A_PWM_Timer timer);
+
+/**
+ * @brief Returns 1 if a timer is running with the Timer_A_PWM driver, otherwise 0.
+ *
+ * @param timer The timer.
+ *
+ * @return 1 if the timer is running, otherwise 0.
+ */
+uint8_t Timer_A_PWM_Is_Running(Timer_A_PWM_Timer timer);
+
+/**
+ * @brief Returns 1 if a timer of the Timer_A_PWM driver is running from SMCLK, otherwise 0.
+ *
+ * SMCLK is stopped in LPM3, so Tickless_Idle only uses LPM0 while this function returns 1.
+ *
+ * @param None
+ *
+ * @return 1 if a timer uses SMCLK, otherwise 0.
+ */
+uint8_t Timer_A_PWM_Is_Using_SMCLK();
+
+#endif /* TIMER_A_PWM_H_ */
@@ -0,0 +1,185 @@
+/**
+ * @file Trace.h
+ * @brief Header file for the Trace driver.
+ *
+ * This file contains the function definitions for the Trace driver.
+ * A Trace call stores a format ID, its level, a timestamp, and two 32-bit arguments in a RAM ring buffer,
+ * which takes a few cycles and can be done from any interrupt handler. The format string (see Trace_Formats.h)
+ * is expanded later by Trace_Process, which is called from the main loop.
+ *
+ * Levels:
+ *  - TRACE_LEVEL_NONE  (0)
+ *  - TRACE_LEVEL_ERROR (1)
+ *  - TRACE_LEVEL_WARN  (2)
+ *  - TRACE_LEVEL_INFO  (3)
+ *  - TRACE_LEVEL_DEBUG (4)
+ *
+ * Calls above TRACE_MODULE_LEVEL are removed at compile time. TRACE_MODULE_LEVEL can be defined by a source file
+ * before including Trace.h, otherwise it is set to TRACE_COMPILE_LEVEL, which can be defined for the whole project
+ * (e.g. --define=TRACE_COMPILE_LEVEL=2). The remaining calls are also filtered at run time by Trace_Set_Level.
+ *
+ * Example:
+ *
+ *      #define TRACE_MODULE_LEVEL TRACE_LEVEL_WARN
+ *      #include "../inc/Trace.h"
+ *
+ *      TRACE_WARN(TRACE_FMT_EVENT_QUEUE_OVERFLOW, source, count);     // kept
+ *      TRACE_INFO(TRACE_FMT_BUMPER_STATE, state, 0);                  // removed
+ *
+ * @note The Trace calls do not depend on printf and can be made from interrupt handlers.
+ *       Trace_Process must only be called from the main loop.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Trace_Formats.h"
+
+#define TRACE_LEVEL_NONE    0
+#define TRACE_LEVEL_ERROR   1
+#define TRACE_LEVEL_WARN    2
+#define TRACE_LEVEL_INFO    3
+#define TRACE_LEVEL_DEBUG   4
+
+/**
+ * @brief Highest level that is compiled in the project (can be defined in the project settings).
+ */
+#ifndef TRACE_COMPILE_LEVEL
+#define TRACE_COMPILE_LEVEL TRACE_LEVEL_DEBUG
+#endif
+
+/**
+ * @brief Highest level that is compiled in a source file (can be defined before including Trace.h).
+ */
+#ifndef TRACE_MODULE_LEVEL
+#define TRACE_MODULE_LEVEL TRACE_COMPILE_LEVEL
+#endif
+
+/**
+ * @brief Number of entries in the trace ring buffer (must be a power of two).
+ */
+#define TRACE_BUFFER_SIZE 32
+
+/**
+ * @brief Format IDs generated from TRACE_FORMATS.
+ */
+#define TRACE_FORMAT_ID(id, format) id,
+typedef enum
+{
+    TRACE_FORMATS(TRACE_FORMAT_ID)
+    TRACE_NUM_FORMATS
+} Trace_Format;
+#undef TRACE_FORMAT_ID
+
+/**
+ * @brief Destinations of the entries processed by Trace_Process.
+ *
+ *  - TRACE_OUTPUT_TEXT:      The format string is expanded with printf
+ *  - TRACE_OUTPUT_TELEMETRY: The entry is sent as a TELEMETRY_TYPE_TRACE record and expanded by the host decoder
+ */
+typedef enum
+{
+    TRACE_OUTPUT_TEXT = 0,
+    TRACE_OUTPUT_TELEMETRY
+} Trace_Output;
+
+#if TRACE_MODULE_LEVEL >= TRACE_LEVEL_ERROR
+#define TRACE_ERROR(id, arg0, arg1) Trace_Post(TRACE_LEVEL_ERROR, (id), (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define TRACE_ERROR(id, arg0, arg1) ((void)0)
+#endif
+
+#if TRACE_MODULE_LEVEL >= TRACE_LEVEL_WARN
+#define TRACE_WARN(id, arg0, arg1) Trace_Post(TRACE_LEVEL_WARN, (id), (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define TRACE_WARN(id, arg0, arg1) ((void)0)
+#endif
+
+#if TRACE_MODULE_LEVEL >= TRACE_LEVEL_INFO
+#define TRACE_INFO(id, arg0, arg1) Trace_Post(TRACE_LEVEL_INFO, (id), (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define TRACE_INFO(id, arg0, arg1) ((void)0)
+#endif
+
+#if TRACE_MODULE_LEVEL >= TRACE_LEVEL_DEBUG
+#define TRACE_DEBUG(id, arg0, arg1) Trace_Post(TRACE_LEVEL_DEBUG, (id), (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define TRACE_DEBUG(id, arg0, arg1) ((void)0)
+#endif
+
+/**
+ * @brief Stores an entry in the trace ring buffer. Use the TRACE_* macros instead of calling this function directly.
+ *
+ * The entry is dropped (and counted) if its level is above the run-time level or if the ring buffer is full.
+ *
+ * @param level The level of the entry.
+ * @param id    The format ID.
+ * @param arg0  The first argument of the format string.
+ * @param arg1  The second argument of the format string.
+ *
+ * @return None
+ */
+void Trace_Post(uint8_t level, Trace_Format id, uint32_t arg0, uint32_t arg1);
+
+/**
+ * @brief Sets the highest level that is stored at run time.
+ *
+ * @param level The level (TRACE_LEVEL_NONE to TRACE_LEVEL_DEBUG). The default is TRACE_LEVEL_INFO.
+ *
+ * @return None
+ */
+void Trace_Set_Level(uint8_t level);
+
+/**
+ * @brief Returns the highest level that is stored at run time.
+ *
+ * @param None
+ *
+ * @return The level set by Trace_Set_Level.
+ */
+uint8_t Trace_Get_Level();
+
+/**
+ * @brief Selects the destination of the entries processed by Trace_Process.
+ *
+ * @param output The destination. The default is TRACE_OUTPUT_TEXT.
+ *
+ * @return None
+ */
+void Trace_Set_Output(Trace_Output output);
+
+/**
+ * @brief Expands or sends the oldest entries of the trace ring buffer.
+ *
+ * This function should be called from the main loop.
+ *
+ * @param max_entries The maximum number of entries to process.
+ *
+ * @return The number of entries that were processed.
+ */
+uint32_t Trace_Process(uint32_t max_entries);
+
+/**
+ * @brief Returns 1 if the trace ring buffer is empty, otherwise 0.
+ *
+ * @param None
+ *
+ * @return 1 if there are no entries to process, otherwise 0.
+ */
+uint8_t Trace_Is_Empty();
+
+/**
+ * @brief Returns the number of entries dropped because the trace ring buffer was full.
+ *
+ * @param None
+ *
+ * @return The number of dropped entries.
+ */
+uint32_t Trace_Overflow_Count();
+
+#endif /* TRACE_H_ */
@@ -0,0 +1,27 @@
+/**
+ * @file Trace_Formats.h
+ * @brief Format strings used by the Trace driver.
+ *
+ * Each entry of TRACE_FORMATS defines a format ID and its format string. A Trace call only stores the ID and up to
+ * two 32-bit arguments, and the string is expanded later by Trace_Process or by tools/telemetry_decoder.py,
+ * which reads the strings from this file. New entries must be added at the end so that the IDs of the
+ * existing entries do not change.
+ *
+ * @note Each format string can use at most two conversions, and each entry must stay on a single line.
+ *
+ * @author Aaron Nanas
+ *
+ */
+
+#ifndef TRACE_FORMATS_H_
+#define TRACE_FORMATS_H_
+
+#define TRACE_FORMATS(X) \
+    X(TRACE_FMT_BUMPER_STATE,           "Bumper Sensor State: 0x%02X") \
+    X(TRACE_FMT_BUMPER_TIME,            "Bumper Sensor Event Time: %u ms") \
+    X(TRACE_FMT_PMOD_BTN_STATE,         "PMOD BTN State: 0x%02X") \
+    X(TRACE_FMT_PMOD_BTN_COUNTER,       "PMOD BTN Counter: %d") \
+    X(TRACE_FMT_PMOD_BTN_TIME,          "PMOD BTN Event Time: %u ms") \
+    X(TRACE_FMT_EVENT_QUEUE_OVERFLOW,   "Event Queue Overflow: source %u, dropped %u")
+
+#endif /* TRACE_FORMATS_H_ */
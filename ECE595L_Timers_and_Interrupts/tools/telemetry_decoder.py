@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""
+Host-side decoder for the binary records sent by the Telemetry driver.
+
+Each record is COBS-encoded and sent between two 0x00 delimiters:
+
+    type (1) | timestamp in ms (4, little-endian) | payload (N) | CRC-16/CCITT-FALSE (2, little-endian)
+
+Bytes that do not decode as a valid record (e.g. text printed by the Shell) are printed as text.
+Trace records are expanded with the format strings read from inc/Trace_Formats.h.
+
+Usage:
+    python3 telemetry_decoder.py /dev/ttyACM0          # read from a serial port (requires pyserial)
+    python3 telemetry_decoder.py --file capture.bin    # read from a file
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+TYPE_BUMPER = 1
+TYPE_PMOD_BTN = 2
+TYPE_COUNTER = 3
+TYPE_PROFILER = 4
+TYPE_TRACE = 5
+
+PROFILER_IRQ_NAMES = ["SysTick", "PORT4", "PORT6", "EUSCIA0"]
+LATENCY_UNKNOWN = 0xFFFFFFFF
+
+TRACE_LEVEL_NAMES = ["NONE", "ERROR", "WARN", "INFO", "DEBUG"]
+DEFAULT_TRACE_FORMATS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "inc", "Trace_Formats.h")
+
+# Format strings indexed by format ID, loaded by load_trace_formats
+trace_formats = []
+
+
+def load_trace_formats(path):
+    """Reads the X(ID, "format") entries of TRACE_FORMATS in order."""
+    formats = []
+    entry = re.compile(r'X\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+    with open(path) as f:
+        for line in f:
+            match = entry.search(line)
+            if match:
+                formats.append(match.group(2).encode().decode("unicode_escape"))
+    return formats
+
+
+def expand_trace(format_id, arg0, arg1):
+    if format_id >= len(trace_formats):
+        return "format=%d args=0x%08X,0x%08X" % (format_id, arg0, arg1)
+
+    text = trace_formats[format_id]
+    conversions = len(re.findall(r"%[-+ #0]*\d*[diuxXc]", text))
+    args = (arg0, arg1)[:conversions]
+    # %d arguments are sent as 32-bit values, so convert them to signed numbers
+    args = tuple(a - (1 << 32) if a & 0x80000000 else a for a in args) if "%d" in text else args
+    try:
+        return text % args
+    except (TypeError, ValueError):
+        return "%s (args=0x%08X,0x%08X)" % (text, arg0, arg1)
+
+
+def crc16_ccitt_false(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(frame):
+    """Returns the decoded bytes, or None if the frame is not valid COBS."""
+    output = bytearray()
+    index = 0
+    while index < len(frame):
+        code = frame[index]
+        if code == 0 or index + code > len(frame):
+            return None
+        output.extend(frame[index + 1:index + code])
+        index += code
+        if code < 0xFF and index < len(frame):
+            output.append(0)
+    return bytes(output)
+
+
+def format_payload(record_type, payload):
+    if record_type == TYPE_BUMPER and len(payload) == 1:
+        return "bumper state=0x%02X" % payload[0]
+
+    if record_type == TYPE_PMOD_BTN and len(payload) == 2:
+        return "pmod_btn state=0x%02X counter=%d" % (payload[0], payload[1])
+
+    if record_type == TYPE_COUNTER and len(payload) == 5:
+        counter_id, value = struct.unpack("<BI", payload)
+        return "counter id=%d value=%d" % (counter_id, value)
+
+    if record_type == TYPE_PROFILER and len(payload) == 29:
+        fields = struct.unpack("<B7I", payload)
+        irq = fields[0]
+        name = PROFILER_IRQ_NAMES[irq] if irq < len(PROFILER_IRQ_NAMES) else str(irq)
+        count, minimum, maximum, mean, lat_min, lat_max, lat_mean = fields[1:]
+        if lat_min == LATENCY_UNKNOWN:
+            latency = "lat_min=- lat_max=- lat_mean=-"
+        else:
+            latency = "lat_min=%d lat_max=%d lat_mean=%d" % (lat_min, lat_max, lat_mean)
+        return "ISR %s count=%d min=%d max=%d mean=%d %s" % (name, count, minimum, maximum, mean, latency)
+
+    if record_type == TYPE_TRACE and len(payload) == 10:
+        format_id, level, arg0, arg1 = struct.unpack("<BBII", payload)
+        name = TRACE_LEVEL_NAMES[level] if level < len(TRACE_LEVEL_NAMES) else str(level)
+        return "%-5s %s" % (name, expand_trace(format_id, arg0, arg1))
+
+    return "type=%d payload=%s" % (record_type, payload.hex())
+
+
+def decode_record(frame):
+    """Returns a formatted record, or None if the frame is not a valid record."""
+    record = cobs_decode(frame)
+    if record is None or len(record) < 7:
+        return None
+
+    body, crc = record[:-2], struct.unpack("<H", record[-2:])[0]
+    if crc16_ccitt_false(body) != crc:
+        return None
+
+    record_type = body[0]
+    timestamp = struct.unpack("<I", body[1:5])[0]
+    return "[%10d ms] %s" % (timestamp, format_payload(record_type, body[5:]))
+
+
+def decode_stream(chunks, output=sys.stdout):
+    frame = bytearray()
+    for chunk in chunks:
+        for byte in chunk:
+            if byte != 0:
+                frame.append(byte)
+                continue
+
+            if frame:
+                line = decode_record(bytes(frame))
+                if line is None:
+                    line = bytes(frame).decode("ascii", errors="replace").rstrip("\r\n")
+                if line:
+                    output.write(line + "\n")
+                    output.flush()
+            frame = bytearray()
+
+
+def read_file(path):
+    with open(path, "rb") as f:
+        while True:
+            chunk = f.read(4096)
+            if not chunk:
+                return
+            yield chunk
+
+
+def read_serial(port, baud_rate):
+    import serial
+
+    with serial.Serial(port, baud_rate, timeout=0.1) as connection:
+        while True:
+            yield connection.read(256)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode Telemetry records sent by the Timers_and_Interrupts program")
+    parser.add_argument("port", nargs="?", help="serial port (e.g. /dev/ttyACM0 or COM3)")
+    parser.add_argument("--baud", type=int, default=115200, help="baud rate (default: 115200)")
+    parser.add_argument("--file", help="decode a captured byte stream instead of a serial port")
+    parser.add_argument("--formats", default=DEFAULT_TRACE_FORMATS, help="path of Trace_Formats.h")
+    args = parser.parse_args()
+
+    global trace_formats
+    if os.path.exists(args.formats):
+        trace_formats = load_trace_formats(args.formats)
+
+    if args.file:
+        decode_stream(read_file(args.file))
+    elif args.port:
+        try:
+            decode_stream(read_serial(args.port, args.baud))
+        except KeyboardInterrupt:
+            pass
+    else:
+        parser.error("a serial port or --file is required")
+
+
+if __name__ == "__main__":
+    main()